@@ -7,6 +7,11 @@ namespace WiFiSet {
 //
 
 void ServerCallbacks::onConnect(BLEServer* pServer) {
+    bleService->peerMTU = BLE_DEFAULT_MTU;
+    bleService->clientMaxMTU = 0;
+    bleService->sessionFeatures = 0; // Until the client sends HELLO
+    bleService->flowControl.reset();
+    bleService->protocolHandler.resetParser();
     bleService->clientConnected = true;
     if (bleService->callbacks) {
         bleService->callbacks->onClientConnected();
@@ -15,6 +20,11 @@ void ServerCallbacks::onConnect(BLEServer* pServer) {
 
 void ServerCallbacks::onDisconnect(BLEServer* pServer) {
     bleService->clientConnected = false;
+    bleService->peerMTU = BLE_DEFAULT_MTU;
+    if (bleService->pWiFiListDescriptor) {
+        // The stack keeps descriptor values across connections
+        bleService->pWiFiListDescriptor->setNotifications(false);
+    }
     if (bleService->callbacks) {
         bleService->callbacks->onClientDisconnected();
     }
@@ -24,6 +34,18 @@ void ServerCallbacks::onDisconnect(BLEServer* pServer) {
     bleService->startAdvertising();
 }
 
+void ServerCallbacks::onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+    bleService->peerMTU = param->mtu.mtu;
+}
+
+//
+// NotifyCharacteristicCallbacks Implementation
+//
+
+void NotifyCharacteristicCallbacks::onStatus(BLECharacteristic* pCharacteristic, Status s, uint32_t code) {
+    bleService->onNotifyStatus(s);
+}
+
 //
 // CredentialCharacteristicCallbacks Implementation
 //
@@ -32,32 +54,9 @@ void CredentialCharacteristicCallbacks::onWrite(BLECharacteristic* pCharacterist
     std::string value = pCharacteristic->getValue();
 
     if (value.length() > 0) {
-        // Parse credential write message
+        // Writes may carry a whole message or a fragment of one
         const uint8_t* data = reinterpret_cast<const uint8_t*>(value.data());
-        CredentialData credentials = bleService->protocolHandler.parseCredentialWrite(data, value.length());
-
-        if (credentials.isValid) {
-            // Notify callback
-            if (bleService->callbacks) {
-                bleService->callbacks->onCredentialsReceived(credentials.ssid, credentials.password);
-            }
-
-            // Send acknowledgment (success)
-            bleService->sendCredentialAck(0x00);
-        } else {
-            // Send acknowledgment (failure)
-            // Determine failure reason
-            uint8_t statusCode = 0x01; // Default to invalid SSID
-            String error = bleService->protocolHandler.getLastError();
-            if (error.indexOf("password") >= 0) {
-                statusCode = 0x02; // Invalid password
-            } else if (error.indexOf("storage") >= 0 || error.indexOf("Storage") >= 0) {
-                statusCode = 0x03; // Storage failure
-            }
-
-            bleService->sendCredentialAck(statusCode);
-            bleService->sendError(ErrorCode::CREDENTIAL_WRITE_FAILED, error);
-        }
+        bleService->receiveCredentialFragment(data, value.length());
     }
 }
 
@@ -65,20 +64,55 @@ void CredentialCharacteristicCallbacks::onWrite(BLECharacteristic* pCharacterist
 // WiFiSetBLEService Implementation
 //
 
+WiFiSetBLEService* WiFiSetBLEService::activeInstance = nullptr;
+
+void WiFiSetBLEService::handleGattsEvent(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf,
+                                         esp_ble_gatts_cb_param_t* param) {
+    WiFiSetBLEService* service = activeInstance;
+    if (!service) {
+        return;
+    }
+
+    switch (event) {
+        case ESP_GATTS_CONF_EVT:
+            // Notification handed off to the controller - return its credit
+            service->flowControl.onComplete();
+            break;
+        case ESP_GATTS_CONGEST_EVT:
+            service->flowControl.setCongested(param->congest.congested);
+            break;
+        case ESP_GATTS_DISCONNECT_EVT:
+            service->flowControl.reset();
+            break;
+        default:
+            break;
+    }
+}
+
 WiFiSetBLEService::WiFiSetBLEService()
     : pServer(nullptr),
       pService(nullptr),
       pWiFiListCharacteristic(nullptr),
       pCredentialCharacteristic(nullptr),
       pStatusCharacteristic(nullptr),
+      pWiFiListDescriptor(nullptr),
+      loopTask(nullptr),
+      lastFragmentTime(0),
       callbacks(nullptr),
       bleInitialized(false),
-      clientConnected(false) {}
+      clientConnected(false),
+      batchedNetworkList(false),
+      peerMTU(BLE_DEFAULT_MTU),
+      clientMaxMTU(0),
+      sessionFeatures(0) {}
 
 WiFiSetBLEService::~WiFiSetBLEService() {
     if (bleInitialized) {
         stopAdvertising();
     }
+    if (activeInstance == this) {
+        activeInstance = nullptr;
+    }
 }
 
 bool WiFiSetBLEService::begin(const char* deviceName) {
@@ -91,6 +125,16 @@ bool WiFiSetBLEService::begin(const char* deviceName) {
     // Initialize BLE Device
     BLEDevice::init(deviceName);
 
+    // Allow the client to negotiate up to the maximum ATT MTU
+    BLEDevice::setMTU(BLE_MAX_MTU);
+
+    // Notifications are sent from this task; callbacks queue their replies for it
+    loopTask = xTaskGetCurrentTaskHandle();
+
+    // Observe notification completion/congestion for flow control
+    activeInstance = this;
+    BLEDevice::setCustomGattsHandler(handleGattsEvent);
+
     // Create BLE Server
     pServer = BLEDevice::createServer();
     pServer->setCallbacks(new ServerCallbacks(this));
@@ -103,7 +147,9 @@ bool WiFiSetBLEService::begin(const char* deviceName) {
         WIFI_LIST_CHARACTERISTIC_UUID,
         BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY
     );
-    pWiFiListCharacteristic->addDescriptor(new BLE2902());
+    pWiFiListDescriptor = new BLE2902();
+    pWiFiListCharacteristic->addDescriptor(pWiFiListDescriptor);
+    pWiFiListCharacteristic->setCallbacks(new NotifyCharacteristicCallbacks(this));
 
     // Create Credential Write Characteristic (WRITE)
     pCredentialCharacteristic = pService->createCharacteristic(
@@ -118,6 +164,7 @@ bool WiFiSetBLEService::begin(const char* deviceName) {
         BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY
     );
     pStatusCharacteristic->addDescriptor(new BLE2902());
+    pStatusCharacteristic->setCallbacks(new NotifyCharacteristicCallbacks(this));
 
     // Start the service
     pService->start();
@@ -165,50 +212,327 @@ void WiFiSetBLEService::stopAdvertising() {
     BLEDevice::getAdvertising()->stop();
 }
 
-void WiFiSetBLEService::sendData(BLECharacteristic* characteristic, const std::vector<uint8_t>& data) {
-    if (!bleInitialized || !clientConnected || !characteristic) {
+void WiFiSetBLEService::sendData(BLECharacteristic* characteristic, const uint8_t* data, size_t length) {
+    if (!bleInitialized || !clientConnected || !characteristic || length == 0) {
+        return;
+    }
+
+    // The BT task delivers the completions waitForNotificationCredit() waits for,
+    // so replies from BLE callbacks are sent by loop() instead
+    if (xTaskGetCurrentTaskHandle() != loopTask) {
+        if (!replyQueue.push(static_cast<uint8_t>(replyChannel(characteristic)), data, length)) {
+            Serial.println("[BLE] Reply queue full, reply dropped");
+        }
         return;
     }
 
-    characteristic->setValue(const_cast<uint8_t*>(data.data()), data.size());
-    characteristic->notify();
+    // Fragment to the peer's MTU; the client reassembles using the header length
+    MessageFragmenter fragmenter(data, length, getMaxNotificationSize());
+    const uint8_t* chunk;
+    size_t chunkLength;
+    while (fragmenter.next(chunk, chunkLength)) {
+        if (!waitForNotificationCredit()) {
+            return; // Client disconnected
+        }
+        characteristic->setValue(const_cast<uint8_t*>(chunk), chunkLength);
+        // Charged up front so an early completion can't be lost; refunded in onNotifyStatus()
+        flowControl.onSent();
+        characteristic->notify();
+    }
+
+    // Leave the full message as the value so READs (long reads) see all of it
+    if (fragmenter.fragmentCount() > 1) {
+        characteristic->setValue(const_cast<uint8_t*>(data), length);
+    }
 }
 
-void WiFiSetBLEService::sendNotification(BLECharacteristic* characteristic, const std::vector<uint8_t>& data) {
-    sendData(characteristic, data);
+bool WiFiSetBLEService::waitForNotificationCredit() {
+    unsigned long start = millis();
+    while (!flowControl.canSend()) {
+        if (!clientConnected) {
+            return false;
+        }
+        if (millis() - start > NOTIFY_CREDIT_TIMEOUT_MS) {
+            // Completions were lost (or never reported) - don't stall forever
+            flowControl.reset();
+            break;
+        }
+        delay(1); // Let the BT task drain the controller queue
+    }
+    return clientConnected;
 }
 
-void WiFiSetBLEService::sendWiFiNetworkList(const std::vector<WiFiNetworkInfo>& networks) {
-    if (!clientConnected || !pWiFiListCharacteristic) {
+void WiFiSetBLEService::onNotifyStatus(BLECharacteristicCallbacks::Status status) {
+    if (status != BLECharacteristicCallbacks::SUCCESS_NOTIFY) {
+        flowControl.onDropped();
+    }
+}
+
+WiFiSetBLEService::ReplyChannel WiFiSetBLEService::replyChannel(BLECharacteristic* characteristic) const {
+    if (characteristic == pWiFiListCharacteristic) {
+        return ReplyChannel::WIFI_LIST;
+    }
+    if (characteristic == pCredentialCharacteristic) {
+        return ReplyChannel::CREDENTIAL;
+    }
+    return ReplyChannel::STATUS;
+}
+
+BLECharacteristic* WiFiSetBLEService::replyCharacteristic(ReplyChannel channel) const {
+    switch (channel) {
+        case ReplyChannel::WIFI_LIST:
+            return pWiFiListCharacteristic;
+        case ReplyChannel::CREDENTIAL:
+            return pCredentialCharacteristic;
+        default:
+            return pStatusCharacteristic;
+    }
+}
+
+void WiFiSetBLEService::sendQueuedReplies() {
+    uint8_t buffer[REPLY_QUEUE_SIZE];
+    uint8_t channel;
+    size_t length;
+    while (replyQueue.pop(channel, buffer, sizeof(buffer), length)) {
+        // Dropped by sendData() if the client has gone
+        sendData(replyCharacteristic(static_cast<ReplyChannel>(channel)), buffer, length);
+    }
+}
+
+bool WiFiSetBLEService::flushNotifications(unsigned long timeoutMs) {
+    sendQueuedReplies();
+
+    unsigned long start = millis();
+    while (flowControl.getInFlight() > 0) {
+        if (!clientConnected || millis() - start > timeoutMs) {
+            return false;
+        }
+        delay(1);
+    }
+    return true;
+}
+
+void WiFiSetBLEService::receiveCredentialFragment(const uint8_t* data, size_t length) {
+    // Drop a stale partial message (client gave up or disconnected mid-write)
+    if (protocolHandler.isParsing() && millis() - lastFragmentTime > FRAGMENT_TIMEOUT_MS) {
+        protocolHandler.resetParser();
+    }
+    lastFragmentTime = millis();
+
+    // Single pass over the bytes; a write may end mid-message or hold several
+    while (length > 0) {
+        size_t consumed = 0;
+        ParseResult result = protocolHandler.feed(data, length, consumed);
+        data += consumed;
+        length -= consumed;
+
+        if (result != ParseResult::NEED_MORE) {
+            handleParsedMessage(result);
+        }
+    }
+}
+
+void WiFiSetBLEService::handleParsedMessage(ParseResult result) {
+    const ParsedMessage& message = protocolHandler.getMessage();
+
+    switch (message.header.type) {
+        case MessageType::CREDENTIAL_WRITE:
+            if (result == ParseResult::MESSAGE_READY) {
+                // Notify callback
+                if (callbacks) {
+                    callbacks->onCredentialsReceived(message.credentials.ssid, message.credentials.password);
+                }
+
+                // Send acknowledgment (success)
+                sendCredentialAck(CredentialAckStatus::SUCCESS);
+            } else {
+                // Send acknowledgment (failure)
+                sendCredentialAck(toCredentialAckStatus(message.status));
+                sendError(ErrorCode::CREDENTIAL_WRITE_FAILED, statusMessage(message.status));
+            }
+            break;
+
+        case MessageType::STATUS_REQUEST:
+            if (result == ParseResult::MESSAGE_READY) {
+                if (callbacks) {
+                    callbacks->onStatusRequest();
+                }
+            } else {
+                sendError(message.status);
+            }
+            break;
+
+        case MessageType::HELLO:
+            if (result == ParseResult::MESSAGE_READY) {
+                handleHello(message.hello);
+            } else {
+                sendError(message.status);
+            }
+            break;
+
+        case MessageType::SCAN_SUBSCRIBE:
+            if (result == ParseResult::MESSAGE_READY) {
+                if (callbacks) {
+                    callbacks->onScanSubscription(message.subscribe.enabled, message.subscribe.rssiThreshold);
+                }
+            } else {
+                sendError(message.status);
+            }
+            break;
+
+        case MessageType::IP_CONFIG_WRITE:
+            // Stored from loop(), so the callee sends the acknowledgment
+            if (result == ParseResult::MESSAGE_READY) {
+                if (callbacks) {
+                    callbacks->onIPConfigReceived(message.ipConfig);
+                }
+            } else {
+                sendIPConfigAck(toIPConfigAckStatus(message.status));
+                sendError(message.status);
+            }
+            break;
+
+        case MessageType::SAVED_NETWORK_ADD:
+        case MessageType::SAVED_NETWORK_REMOVE:
+        case MessageType::SAVED_NETWORK_PRIORITY:
+        case MessageType::SAVED_NETWORK_LIST_REQUEST:
+            // Stored from loop(), so the callee sends the acknowledgment
+            if (result == ParseResult::MESSAGE_READY) {
+                if (callbacks) {
+                    callbacks->onSavedNetworkRequest(message.savedNetwork);
+                }
+            } else {
+                sendSavedNetworkAck(message.header.type, toSavedNetworkAckStatus(message.status));
+                sendError(message.status);
+            }
+            break;
+
+        default:
+            sendError(message.status);
+            break;
+    }
+}
+
+void WiFiSetBLEService::handleHello(const HelloData& hello) {
+    // A different major version means the client cannot parse our replies
+    if (hello.versionMajor != PROTOCOL_VERSION_MAJOR) {
+        sessionFeatures = 0;
+        sendError(Status::UNSUPPORTED_VERSION);
         return;
     }
 
-    // Send List Start
-    std::vector<uint8_t> startMsg = messageBuilder.buildWiFiListStart();
-    sendNotification(pWiFiListCharacteristic, startMsg);
+    // Only features both sides support are enabled for this connection
+    sessionFeatures = hello.features & SUPPORTED_FEATURES;
+    clientMaxMTU = hello.maxMTU;
 
-    delay(100); // Longer delay to prevent BLE stack overflow
-    yield();    // Let watchdog timer reset
+    sendCapabilities();
+}
 
-    // Send each network entry
-    for (size_t i = 0; i < networks.size(); i++) {
-        if (!clientConnected) {
+bool WiFiSetBLEService::isBatchedNetworkList() const {
+    return batchedNetworkList || (sessionFeatures & ProtocolFeature::BATCHED_NETWORK_LIST);
+}
+
+bool WiFiSetBLEService::isWiFiListSubscribed() const {
+    return clientConnected && pWiFiListDescriptor && pWiFiListDescriptor->getNotifications();
+}
+
+size_t WiFiSetBLEService::getMaxNotificationSize() const {
+    uint16_t mtu = peerMTU;
+    if (clientMaxMTU != 0 && clientMaxMTU < mtu) {
+        mtu = clientMaxMTU; // Client asked for smaller notifications
+    }
+    if (mtu < BLE_DEFAULT_MTU) {
+        mtu = BLE_DEFAULT_MTU;
+    } else if (mtu > BLE_MAX_MTU) {
+        mtu = BLE_MAX_MTU;
+    }
+    return mtu - BLE_NOTIFY_OVERHEAD;
+}
+
+void WiFiSetBLEService::sendNotification(BLECharacteristic* characteristic, const uint8_t* data, size_t length) {
+    sendData(characteristic, data, length);
+}
+
+void WiFiSetBLEService::sendWiFiNetworkList(const NetworkList& networks) {
+    if (!clientConnected || !pWiFiListCharacteristic) {
+        return;
+    }
+
+    beginWiFiNetworkList();
+
+    // Pacing is handled by notification flow control in sendData()
+    size_t i = 0;
+    while (i < networks.size()) {
+        size_t sent = sendWiFiNetworks(networks, i);
+        if (sent == 0) {
             return; // Client disconnected during transmission
         }
+        i += sent;
+        yield(); // Let watchdog timer reset
+    }
+
+    endWiFiNetworkList(networks.size());
+}
+
+void WiFiSetBLEService::beginWiFiNetworkList() {
+    if (!clientConnected || !pWiFiListCharacteristic) {
+        return;
+    }
+
+    uint8_t buffer[MAX_LIST_START_SIZE];
+    size_t length = messageBuilder.encodeWiFiListStart(buffer, sizeof(buffer));
+    sendNotification(pWiFiListCharacteristic, buffer, length);
+}
 
-        std::vector<uint8_t> entryMsg = messageBuilder.buildWiFiNetworkEntry(networks[i]);
-        sendNotification(pWiFiListCharacteristic, entryMsg);
-        delay(100); // Longer delay between notifications
-        yield();    // Let watchdog timer reset
+size_t WiFiSetBLEService::sendWiFiNetworks(const NetworkList& networks, size_t startIndex) {
+    if (!clientConnected || !pWiFiListCharacteristic || startIndex >= networks.size()) {
+        return 0;
     }
 
-    // Send List End
-    uint8_t networkCount = networks.size() > 255 ? 255 : static_cast<uint8_t>(networks.size());
-    std::vector<uint8_t> endMsg = messageBuilder.buildWiFiListEnd(networkCount);
-    sendNotification(pWiFiListCharacteristic, endMsg);
+    // Encode into a stack buffer - no heap traffic per message
+    uint8_t buffer[MAX_NOTIFICATION_SIZE];
+    size_t length;
+    size_t sent = 1;
+
+    // Batches need room for at least one full-length entry
+    size_t batchCapacity = getMaxNotificationSize();
+    if (isBatchedNetworkList() && batchCapacity >= MIN_NETWORK_BATCH_SIZE) {
+        length = messageBuilder.encodeWiFiNetworkBatch(networks, startIndex, buffer, batchCapacity, sent);
+    } else {
+        length = messageBuilder.encodeWiFiNetworkEntry(networks[startIndex], buffer, sizeof(buffer));
+    }
 
-    delay(100); // Final delay after list end
-    yield();
+    sendNotification(pWiFiListCharacteristic, buffer, length);
+    return clientConnected ? sent : 0;
+}
+
+size_t WiFiSetBLEService::sendWiFiNetworkChanges(const NetworkChangeList& changes, size_t startIndex) {
+    if (!clientConnected || !pWiFiListCharacteristic || startIndex >= changes.size()) {
+        return 0;
+    }
+
+    // Always room for one full change; below that MTU the message is fragmented
+    uint8_t buffer[MAX_NOTIFICATION_SIZE];
+    size_t capacity = getMaxNotificationSize();
+    if (capacity < MIN_NETWORK_DELTA_SIZE) {
+        capacity = MIN_NETWORK_DELTA_SIZE;
+    }
+
+    size_t sent = 0;
+    size_t length = messageBuilder.encodeWiFiNetworkDelta(changes, startIndex, buffer, capacity, sent);
+    sendNotification(pWiFiListCharacteristic, buffer, length);
+    return clientConnected ? sent : 0;
+}
+
+void WiFiSetBLEService::endWiFiNetworkList(size_t networkCount) {
+    if (!clientConnected || !pWiFiListCharacteristic) {
+        return;
+    }
+
+    uint8_t buffer[MAX_LIST_END_SIZE];
+    uint8_t count = networkCount > 255 ? 255 : static_cast<uint8_t>(networkCount);
+    size_t length = messageBuilder.encodeWiFiListEnd(count, buffer, sizeof(buffer));
+    sendNotification(pWiFiListCharacteristic, buffer, length);
 }
 
 void WiFiSetBLEService::sendCredentialAck(uint8_t statusCode) {
@@ -216,26 +540,80 @@ void WiFiSetBLEService::sendCredentialAck(uint8_t statusCode) {
         return;
     }
 
-    std::vector<uint8_t> ackMsg = messageBuilder.buildCredentialWriteAck(statusCode);
-    sendNotification(pCredentialCharacteristic, ackMsg);
+    uint8_t buffer[MAX_CREDENTIAL_ACK_SIZE];
+    size_t length = messageBuilder.encodeCredentialWriteAck(statusCode, buffer, sizeof(buffer));
+    sendNotification(pCredentialCharacteristic, buffer, length);
+}
+
+void WiFiSetBLEService::sendIPConfigAck(uint8_t statusCode) {
+    if (!clientConnected) {
+        return;
+    }
+
+    uint8_t buffer[MAX_IP_CONFIG_ACK_SIZE];
+    size_t length = messageBuilder.encodeIPConfigAck(statusCode, buffer, sizeof(buffer));
+    sendNotification(pStatusCharacteristic, buffer, length);
 }
 
-void WiFiSetBLEService::sendStatusResponse(ConnectionState state, int8_t rssi, IPAddress ipAddress, const String& ssid) {
+void WiFiSetBLEService::sendSavedNetworkAck(MessageType request, uint8_t statusCode) {
     if (!clientConnected) {
         return;
     }
 
-    std::vector<uint8_t> statusMsg = messageBuilder.buildStatusResponse(state, rssi, ipAddress, ssid);
-    sendNotification(pStatusCharacteristic, statusMsg);
+    uint8_t buffer[MAX_SAVED_NETWORK_ACK_SIZE];
+    size_t length = messageBuilder.encodeSavedNetworkAck(request, statusCode, buffer, sizeof(buffer));
+    sendNotification(pStatusCharacteristic, buffer, length);
+}
+
+void WiFiSetBLEService::sendSavedNetworkList(const SavedNetworkList& networks) {
+    if (!clientConnected) {
+        return;
+    }
+
+    uint8_t buffer[MAX_SAVED_NETWORK_LIST_SIZE];
+    size_t length = messageBuilder.encodeSavedNetworkList(networks, buffer, sizeof(buffer));
+    sendNotification(pStatusCharacteristic, buffer, length);
+}
+
+void WiFiSetBLEService::sendStatusResponse(ConnectionState state, int8_t rssi, IPAddress ipAddress, const String& ssid,
+                                           uint8_t disconnectReason) {
+    if (!clientConnected) {
+        return;
+    }
+
+    uint8_t buffer[MAX_STATUS_RESPONSE_SIZE];
+    size_t length = messageBuilder.encodeStatusResponse(state, rssi, ipAddress, ssid, disconnectReason,
+                                                       buffer, sizeof(buffer));
+    sendNotification(pStatusCharacteristic, buffer, length);
 }
 
 void WiFiSetBLEService::sendError(ErrorCode errorCode, const String& errorMessage) {
+    sendError(errorCode, errorMessage.c_str());
+}
+
+void WiFiSetBLEService::sendError(ErrorCode errorCode, const char* errorMessage) {
+    if (!clientConnected) {
+        return;
+    }
+
+    uint8_t buffer[MAX_ERROR_SIZE];
+    size_t length = messageBuilder.encodeError(errorCode, errorMessage, buffer, sizeof(buffer));
+    sendNotification(pStatusCharacteristic, buffer, length); // Send errors via status characteristic
+}
+
+void WiFiSetBLEService::sendError(Status status) {
+    sendError(toErrorCode(status), statusMessage(status));
+}
+
+void WiFiSetBLEService::sendCapabilities() {
     if (!clientConnected) {
         return;
     }
 
-    std::vector<uint8_t> errorMsg = messageBuilder.buildError(errorCode, errorMessage);
-    sendNotification(pStatusCharacteristic, errorMsg); // Send errors via status characteristic
+    uint8_t buffer[MAX_CAPABILITIES_SIZE];
+    size_t length = messageBuilder.encodeCapabilities(SUPPORTED_FEATURES, BLE_MAX_MTU, sessionFeatures,
+                                                      buffer, sizeof(buffer));
+    sendNotification(pStatusCharacteristic, buffer, length);
 }
 
 void WiFiSetBLEService::setCallbacks(BLEServiceCallbacks* callbacks) {
@@ -243,8 +621,8 @@ void WiFiSetBLEService::setCallbacks(BLEServiceCallbacks* callbacks) {
 }
 
 void WiFiSetBLEService::loop() {
-    // Nothing to do in loop for now
-    // BLE events are handled via callbacks
+    // BLE events are handled via callbacks; their replies are sent here
+    sendQueuedReplies();
 }
 
 } // namespace WiFiSet
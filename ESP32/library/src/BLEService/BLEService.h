@@ -9,6 +9,9 @@
 #include <functional>
 #include "../Protocol/MessageBuilder.h"
 #include "../Protocol/ProtocolHandler.h"
+#include "../Protocol/MessageTransport.h"
+#include "NotificationFlowControl.h"
+#include "ReplyQueue.h"
 #include "../WiFiManager/WiFiManager.h"
 
 namespace WiFiSet {
@@ -19,6 +22,34 @@ namespace WiFiSet {
 #define CREDENTIAL_WRITE_CHAR_UUID     "4FAFC203-1FB5-459E-8FCC-C5C9C331914B"
 #define STATUS_CHARACTERISTIC_UUID     "4FAFC204-1FB5-459E-8FCC-C5C9C331914B"
 
+// ATT MTU limits (Bluetooth Core Spec)
+static const uint16_t BLE_DEFAULT_MTU = 23;
+static const uint16_t BLE_MAX_MTU = 517;
+static const uint16_t BLE_NOTIFY_OVERHEAD = 3; // ATT opcode + handle
+static const size_t MAX_NOTIFICATION_SIZE = BLE_MAX_MTU - BLE_NOTIFY_OVERHEAD;
+
+// Every outgoing message must fit one notification at the maximum MTU
+// (smaller MTUs are handled by fragmentation in sendData)
+static_assert(MAX_NETWORK_ENTRY_SIZE <= MAX_NOTIFICATION_SIZE, "Network Entry exceeds max notification");
+static_assert(MIN_NETWORK_BATCH_SIZE <= MAX_NOTIFICATION_SIZE, "Network Batch exceeds max notification");
+static_assert(MIN_NETWORK_DELTA_SIZE <= MAX_NOTIFICATION_SIZE, "Network Delta exceeds max notification");
+static_assert(MAX_STATUS_RESPONSE_SIZE <= MAX_NOTIFICATION_SIZE, "Status Response exceeds max notification");
+static_assert(MAX_ERROR_SIZE <= MAX_NOTIFICATION_SIZE, "Error exceeds max notification");
+static_assert(MAX_CAPABILITIES_SIZE <= BLE_DEFAULT_MTU - BLE_NOTIFY_OVERHEAD, "Capabilities must fit the default MTU");
+static_assert(MAX_SAVED_NETWORK_LIST_SIZE <= MAX_NOTIFICATION_SIZE, "Saved Network List exceeds max notification");
+
+// Every incoming request must be accepted by the streaming parser
+static_assert(CredentialWriteSchema::maxPayloadSize <= ProtocolHandler::MAX_PAYLOAD_SIZE,
+              "Credential Write exceeds parser payload limit");
+static_assert(SavedNetworkAddSchema::maxPayloadSize <= ProtocolHandler::MAX_PAYLOAD_SIZE,
+              "Saved Network Add exceeds parser payload limit");
+
+// Discard a partially reassembled write if the next fragment takes longer than this
+static const unsigned long FRAGMENT_TIMEOUT_MS = 2000;
+
+// Assume completions were lost if no credit frees up within this time
+static const unsigned long NOTIFY_CREDIT_TIMEOUT_MS = 100;
+
 /**
  * Callbacks for BLE events
  */
@@ -47,6 +78,27 @@ public:
      * Called when a status request is received
      */
     virtual void onStatusRequest() {}
+
+    /**
+     * Called when the client turns live network list updates on or off
+     * @param enabled true to receive WiFi Network Delta messages
+     * @param rssiThreshold Minimum RSSI change in dB to report (0 = device default)
+     */
+    virtual void onScanSubscription(bool enabled, uint8_t rssiThreshold) {}
+
+    /**
+     * Called when the client sets how the device gets its IP address
+     * Answer with sendIPConfigAck().
+     * @param config Validated DHCP or static configuration
+     */
+    virtual void onIPConfigReceived(const IPConfigData& config) {}
+
+    /**
+     * Called when the client adds, removes, reprioritizes or lists saved networks
+     * Answer with sendSavedNetworkAck(), or sendSavedNetworkList() for a list request.
+     * @param request Validated request
+     */
+    virtual void onSavedNetworkRequest(const SavedNetworkRequest& request) {}
 };
 
 /**
@@ -90,27 +142,123 @@ public:
      */
     bool isClientConnected() const { return clientConnected; }
 
+    /**
+     * Check if the client has enabled WiFi List notifications
+     * Notifications sent before this are dropped by the stack.
+     */
+    bool isWiFiListSubscribed() const;
+
+    /**
+     * Get the ATT MTU negotiated with the connected client
+     * @return MTU in bytes (23 if not negotiated)
+     */
+    uint16_t getMTU() const { return peerMTU; }
+
+    /**
+     * Get the largest notification value that fits in the current MTU
+     */
+    size_t getMaxNotificationSize() const;
+
+    /**
+     * Enable batched network list mode
+     * When enabled, sendWiFiNetworkList() packs as many entries into each
+     * notification as the MTU allows (WIFI_NETWORK_BATCH messages) instead of
+     * sending one WIFI_NETWORK_ENTRY per notification.
+     * Only enable this for clients that understand message type 0x04.
+     * @param enabled true to send batches (default: false)
+     */
+    void setBatchedNetworkList(bool enabled) { batchedNetworkList = enabled; }
+
+    /**
+     * Check if batched network list mode is enabled
+     * (either forced on, or negotiated with the current client via HELLO)
+     */
+    bool isBatchedNetworkList() const;
+
+    /**
+     * Get the protocol features negotiated with the connected client
+     * @return ProtocolFeature bits (0 if the client did not send HELLO)
+     */
+    uint16_t getSessionFeatures() const { return sessionFeatures; }
+
     /**
      * Send WiFi network list to connected client
-     * Automatically sends List Start, Network Entries, and List End
+     * Automatically sends List Start, Network Entries (or Batches), and List End
      * @param networks Vector of WiFi networks to send
      */
-    void sendWiFiNetworkList(const std::vector<WiFiNetworkInfo>& networks);
+    void sendWiFiNetworkList(const NetworkList& networks);
+
+    /**
+     * Incremental network list transfer
+     * Lets the caller stream a list one notification at a time from loop():
+     *   beginWiFiNetworkList();
+     *   while (i < networks.size()) i += sendWiFiNetworks(networks, i);  // one call per loop()
+     *   endWiFiNetworkList(networks.size());
+     */
+    void beginWiFiNetworkList();
+
+    /**
+     * Send the next notification's worth of networks
+     * (one Network Entry, or one Batch packed to the MTU)
+     * @param networks Networks being sent
+     * @param startIndex First network not yet sent
+     * @return Number of networks sent (0 if none left or client disconnected)
+     */
+    size_t sendWiFiNetworks(const NetworkList& networks, size_t startIndex);
+
+    /**
+     * Finish the network list
+     * @param networkCount Total networks sent (clamped to 255)
+     */
+    void endWiFiNetworkList(size_t networkCount);
+
+    /**
+     * Send the next notification's worth of network list changes
+     * (one WiFi Network Delta packed to the MTU)
+     * @param changes Changes being sent
+     * @param startIndex First change not yet sent
+     * @return Number of changes sent (0 if none left or client disconnected)
+     */
+    size_t sendWiFiNetworkChanges(const NetworkChangeList& changes, size_t startIndex);
 
     /**
      * Send credential write acknowledgment
-     * @param statusCode 0x00=Success, 0x01=Invalid SSID, 0x02=Invalid Password, 0x03=Storage failure
+     * @param statusCode CredentialAckStatus value (0x00=Success, 0x01=Invalid SSID,
+     *                   0x02=Invalid Password, 0x03=Storage failure)
      */
     void sendCredentialAck(uint8_t statusCode);
 
+    /**
+     * Send IP config acknowledgment (on the Status characteristic)
+     * @param statusCode IPConfigAckStatus value (0x00=Success, 0x01=Invalid configuration,
+     *                   0x02=Storage failure, 0x03=Busy)
+     */
+    void sendIPConfigAck(uint8_t statusCode);
+
+    /**
+     * Send saved network acknowledgment (on the Status characteristic)
+     * @param request Message type of the request being answered
+     * @param statusCode SavedNetworkAckStatus value
+     */
+    void sendSavedNetworkAck(MessageType request, uint8_t statusCode);
+
+    /**
+     * Send the saved network list (in reply to a Saved Network List Request,
+     * on the Status characteristic)
+     * @param networks Saved networks, without passwords
+     */
+    void sendSavedNetworkList(const SavedNetworkList& networks);
+
     /**
      * Send status response
      * @param state Current connection state
      * @param rssi WiFi RSSI (0 if not connected)
      * @param ipAddress IP address (0.0.0.0 if not connected)
      * @param ssid Currently configured SSID
+     * @param disconnectReason WiFi reason code of the last disconnect (0 = none)
      */
-    void sendStatusResponse(ConnectionState state, int8_t rssi, IPAddress ipAddress, const String& ssid);
+    void sendStatusResponse(ConnectionState state, int8_t rssi, IPAddress ipAddress, const String& ssid,
+                            uint8_t disconnectReason = 0);
 
     /**
      * Send error message
@@ -119,6 +267,30 @@ public:
      */
     void sendError(ErrorCode errorCode, const String& errorMessage);
 
+    /**
+     * Send error message with a static description
+     */
+    void sendError(ErrorCode errorCode, const char* errorMessage);
+
+    /**
+     * Send error message for a failed operation
+     * Uses toErrorCode() and statusMessage() - no allocation
+     */
+    void sendError(Status status);
+
+    /**
+     * Send capabilities in reply to a client HELLO
+     */
+    void sendCapabilities();
+
+    /**
+     * Wait until all queued notifications have been sent by the stack
+     * Use before work that will starve the radio (e.g. WiFi connect)
+     * @param timeoutMs Maximum time to wait
+     * @return true if the queue drained, false on timeout or disconnect
+     */
+    bool flushNotifications(unsigned long timeoutMs = 1000);
+
     /**
      * Set callbacks for BLE events
      */
@@ -126,6 +298,7 @@ public:
 
     /**
      * Main loop processing
+     * Sends the replies queued by BLE callbacks (see sendData).
      * Must be called regularly from main loop
      */
     void loop();
@@ -136,27 +309,96 @@ private:
     BLECharacteristic* pWiFiListCharacteristic;
     BLECharacteristic* pCredentialCharacteristic;
     BLECharacteristic* pStatusCharacteristic;
+    BLE2902* pWiFiListDescriptor;
+
+    /**
+     * Characteristic a queued reply is sent on
+     */
+    enum class ReplyChannel : uint8_t {
+        WIFI_LIST,
+        CREDENTIAL,
+        STATUS
+    };
 
     MessageBuilder messageBuilder;
     ProtocolHandler protocolHandler;
+    NotificationFlowControl flowControl;
+    ReplyQueue replyQueue;
+    TaskHandle_t loopTask;      // Task that called begin(); the only one that notifies
+    unsigned long lastFragmentTime;
     BLEServiceCallbacks* callbacks;
 
     bool bleInitialized;
     bool clientConnected;
+    bool batchedNetworkList;
+    volatile uint16_t peerMTU;
+    uint16_t clientMaxMTU;      // From HELLO, 0 if not specified
+    uint16_t sessionFeatures;   // Negotiated ProtocolFeature bits
     String deviceName;
 
     /**
      * Send data via a characteristic using NOTIFY
      */
-    void sendNotification(BLECharacteristic* characteristic, const std::vector<uint8_t>& data);
+    void sendNotification(BLECharacteristic* characteristic, const uint8_t* data, size_t length);
 
     /**
      * Send data via a characteristic (split into MTU-sized chunks if needed)
+     * The characteristic value is left holding the full message for READs.
+     * Called from another task (BLE callbacks run on the BT task), the message
+     * is queued and sent by the next loop().
+     */
+    void sendData(BLECharacteristic* characteristic, const uint8_t* data, size_t length);
+
+    /**
+     * Send the replies queued by BLE callbacks (loop task only)
+     */
+    void sendQueuedReplies();
+
+    /**
+     * Map between characteristics and queued reply channels
+     */
+    ReplyChannel replyChannel(BLECharacteristic* characteristic) const;
+    BLECharacteristic* replyCharacteristic(ReplyChannel channel) const;
+
+    /**
+     * Return the credit of a notification the stack refused
+     * (CCCD off, no client, GATT error) - no completion event will follow
+     */
+    void onNotifyStatus(BLECharacteristicCallbacks::Status status);
+
+    /**
+     * Block until a notification credit is available
+     * Returns false if the client disconnected while waiting
+     */
+    bool waitForNotificationCredit();
+
+    /**
+     * GATT server event hook: notification completion and congestion
      */
-    void sendData(BLECharacteristic* characteristic, const std::vector<uint8_t>& data);
+    static void handleGattsEvent(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf,
+                                 esp_ble_gatts_cb_param_t* param);
+
+    static WiFiSetBLEService* activeInstance;
+
+    /**
+     * Feed a write fragment to the streaming protocol parser
+     * Handles each complete message as it becomes available
+     */
+    void receiveCredentialFragment(const uint8_t* data, size_t length);
+
+    /**
+     * Handle a message completed by the streaming parser
+     */
+    void handleParsedMessage(ParseResult result);
+
+    /**
+     * Negotiate session features from a client HELLO
+     */
+    void handleHello(const HelloData& hello);
 
     // Friend classes for callback access
     friend class ServerCallbacks;
+    friend class NotifyCharacteristicCallbacks;
     friend class CredentialCharacteristicCallbacks;
 };
 
@@ -169,24 +411,35 @@ public:
 
     void onConnect(BLEServer* pServer) override;
     void onDisconnect(BLEServer* pServer) override;
+    void onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) override;
 
 private:
     WiFiSetBLEService* bleService;
 };
 
 /**
- * Credential Write characteristic callbacks
+ * Notifying characteristic callbacks (notification result for flow control)
  */
-class CredentialCharacteristicCallbacks : public BLECharacteristicCallbacks {
+class NotifyCharacteristicCallbacks : public BLECharacteristicCallbacks {
 public:
-    CredentialCharacteristicCallbacks(WiFiSetBLEService* service) : bleService(service) {}
+    NotifyCharacteristicCallbacks(WiFiSetBLEService* service) : bleService(service) {}
 
-    void onWrite(BLECharacteristic* pCharacteristic) override;
+    void onStatus(BLECharacteristic* pCharacteristic, Status s, uint32_t code) override;
 
-private:
+protected:
     WiFiSetBLEService* bleService;
 };
 
+/**
+ * Credential Write characteristic callbacks
+ */
+class CredentialCharacteristicCallbacks : public NotifyCharacteristicCallbacks {
+public:
+    CredentialCharacteristicCallbacks(WiFiSetBLEService* service) : NotifyCharacteristicCallbacks(service) {}
+
+    void onWrite(BLECharacteristic* pCharacteristic) override;
+};
+
 } // namespace WiFiSet
 
 #endif // BLE_SERVICE_H
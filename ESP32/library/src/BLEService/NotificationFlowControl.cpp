@@ -0,0 +1,39 @@
+#include "NotificationFlowControl.h"
+
+namespace WiFiSet {
+
+NotificationFlowControl::NotificationFlowControl(uint8_t credits)
+    : credits(credits > 0 ? credits : 1),
+      inFlight(0),
+      congested(false) {}
+
+bool NotificationFlowControl::canSend() const {
+    return !congested.load() && inFlight.load() < credits;
+}
+
+void NotificationFlowControl::onSent() {
+    inFlight++;
+}
+
+void NotificationFlowControl::onComplete() {
+    // Saturating decrement - a completion may arrive after reset()
+    int current = inFlight.load();
+    while (current > 0 && !inFlight.compare_exchange_weak(current, current - 1)) {
+    }
+}
+
+void NotificationFlowControl::onDropped() {
+    // No completion event will follow
+    onComplete();
+}
+
+void NotificationFlowControl::setCongested(bool isCongested) {
+    congested = isCongested;
+}
+
+void NotificationFlowControl::reset() {
+    inFlight = 0;
+    congested = false;
+}
+
+} // namespace WiFiSet
@@ -0,0 +1,87 @@
+#ifndef NOTIFICATION_FLOW_CONTROL_H
+#define NOTIFICATION_FLOW_CONTROL_H
+
+#include <stdint.h>
+#include <atomic>
+
+namespace WiFiSet {
+
+// Notifications allowed in the controller queue before waiting for completions
+static const uint8_t DEFAULT_NOTIFY_CREDITS = 8;
+
+/**
+ * NotificationFlowControl - Credit-based pacing for BLE notifications
+ *
+ * Tracks notifications handed to the BLE stack against the number of
+ * controller buffers we allow ourselves to occupy. A credit is consumed
+ * per notification handed to the stack and returned when the stack reports
+ * it complete (ESP_GATTS_CONF_EVT), or right away if the stack refused it
+ * (notifications disabled by the client, GATT error). While the stack
+ * reports congestion (ESP_GATTS_CONGEST_EVT) no credits are available.
+ *
+ * Pure logic with no BLE or Arduino dependencies: onSent()/onDropped() are
+ * called from the sending task and onComplete()/setCongested() from the
+ * BT task.
+ */
+class NotificationFlowControl {
+public:
+    /**
+     * @param credits Maximum notifications in flight
+     */
+    explicit NotificationFlowControl(uint8_t credits = DEFAULT_NOTIFY_CREDITS);
+
+    /**
+     * Check if another notification may be sent now
+     */
+    bool canSend() const;
+
+    /**
+     * Record a notification handed to the stack (consumes a credit)
+     */
+    void onSent();
+
+    /**
+     * Record a notification completed by the stack (returns a credit)
+     */
+    void onComplete();
+
+    /**
+     * Record a notification the stack refused after onSent() (returns a credit)
+     */
+    void onDropped();
+
+    /**
+     * Update link congestion state reported by the stack
+     */
+    void setCongested(bool congested);
+
+    /**
+     * Return all credits and clear congestion
+     * Called on connect/disconnect or when completions were lost
+     */
+    void reset();
+
+    /**
+     * Number of notifications currently in flight
+     */
+    int getInFlight() const { return inFlight.load(); }
+
+    /**
+     * Check if the stack reported congestion
+     */
+    bool isCongested() const { return congested.load(); }
+
+    /**
+     * Maximum notifications in flight
+     */
+    uint8_t getCredits() const { return credits; }
+
+private:
+    uint8_t credits;
+    std::atomic<int> inFlight;
+    std::atomic<bool> congested;
+};
+
+} // namespace WiFiSet
+
+#endif // NOTIFICATION_FLOW_CONTROL_H
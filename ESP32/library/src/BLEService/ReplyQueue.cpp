@@ -0,0 +1,66 @@
+#include "ReplyQueue.h"
+#include <string.h>
+
+namespace WiFiSet {
+
+ReplyQueue::ReplyQueue() : head(0), tail(0) {}
+
+void ReplyQueue::write(size_t position, const uint8_t* data, size_t length) {
+    size_t start = position & (REPLY_QUEUE_SIZE - 1);
+    size_t first = REPLY_QUEUE_SIZE - start < length ? REPLY_QUEUE_SIZE - start : length;
+    memcpy(buffer + start, data, first);
+    memcpy(buffer, data + first, length - first);
+}
+
+void ReplyQueue::read(size_t position, uint8_t* data, size_t length) const {
+    size_t start = position & (REPLY_QUEUE_SIZE - 1);
+    size_t first = REPLY_QUEUE_SIZE - start < length ? REPLY_QUEUE_SIZE - start : length;
+    memcpy(data, buffer + start, first);
+    memcpy(data + first, buffer, length - first);
+}
+
+bool ReplyQueue::push(uint8_t channel, const uint8_t* data, size_t length) {
+    size_t position = head.load(std::memory_order_relaxed);
+    size_t used = position - tail.load(std::memory_order_acquire);
+    if (length > 0xFFFF || RECORD_HEADER_SIZE + length > REPLY_QUEUE_SIZE - used) {
+        return false;
+    }
+
+    uint8_t header[RECORD_HEADER_SIZE] = {channel, static_cast<uint8_t>(length & 0xFF),
+                                          static_cast<uint8_t>(length >> 8)};
+    write(position, header, RECORD_HEADER_SIZE);
+    write(position + RECORD_HEADER_SIZE, data, length);
+
+    // Publish the record only once all of its bytes are in place
+    head.store(position + RECORD_HEADER_SIZE + length, std::memory_order_release);
+    return true;
+}
+
+bool ReplyQueue::pop(uint8_t& outChannel, uint8_t* data, size_t capacity, size_t& outLength) {
+    while (true) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        uint8_t header[RECORD_HEADER_SIZE];
+        read(position, header, RECORD_HEADER_SIZE);
+        size_t length = header[1] | (static_cast<size_t>(header[2]) << 8);
+
+        bool fits = length <= capacity;
+        if (fits) {
+            read(position + RECORD_HEADER_SIZE, data, length);
+        }
+
+        // Free the space only after the message was copied out
+        tail.store(position + RECORD_HEADER_SIZE + length, std::memory_order_release);
+
+        if (fits) {
+            outChannel = header[0];
+            outLength = length;
+            return true;
+        }
+    }
+}
+
+} // namespace WiFiSet
@@ -0,0 +1,74 @@
+#ifndef REPLY_QUEUE_H
+#define REPLY_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace WiFiSet {
+
+// Bytes of encoded replies held between a BLE callback and the next loop()
+static const size_t REPLY_QUEUE_SIZE = 512;
+
+/**
+ * ReplyQueue - Encoded messages waiting to be notified from loop()
+ *
+ * Replies produced inside BLE callbacks run on the BT task, which also
+ * delivers the completion events notification flow control waits for, so
+ * they cannot be sent there. The callback pushes the encoded message and
+ * loop() pops and sends it.
+ *
+ * A byte ring with one producer (the BT task) and one consumer (the loop
+ * task). Each record is Channel(1) + Length(2) + Message(N). Never
+ * allocates; pure logic with no BLE or Arduino dependencies.
+ */
+class ReplyQueue {
+public:
+    ReplyQueue();
+
+    /**
+     * Queue a message (producer side)
+     * @param channel Caller-defined tag, returned by pop() (e.g. the characteristic)
+     * @param data Encoded message
+     * @param length Message length
+     * @return false if the queue has no room (the message is dropped)
+     */
+    bool push(uint8_t channel, const uint8_t* data, size_t length);
+
+    /**
+     * Take the oldest message (consumer side)
+     * A message longer than capacity is discarded.
+     * @param outChannel Channel passed to push()
+     * @param buffer Destination for the message
+     * @param capacity Size of buffer
+     * @param outLength Message length
+     * @return false if the queue is empty
+     */
+    bool pop(uint8_t& outChannel, uint8_t* buffer, size_t capacity, size_t& outLength);
+
+    /**
+     * Check if no message is waiting
+     */
+    bool isEmpty() const { return head.load() == tail.load(); }
+
+    /**
+     * Bytes in use, including record headers
+     */
+    size_t size() const { return head.load() - tail.load(); }
+
+private:
+    static const size_t RECORD_HEADER_SIZE = 3;
+
+    static_assert((REPLY_QUEUE_SIZE & (REPLY_QUEUE_SIZE - 1)) == 0, "Queue size must be a power of two");
+
+    uint8_t buffer[REPLY_QUEUE_SIZE];
+    std::atomic<size_t> head;   // Next byte to write (free-running, producer)
+    std::atomic<size_t> tail;   // Next byte to read (free-running, consumer)
+
+    void write(size_t position, const uint8_t* data, size_t length);
+    void read(size_t position, uint8_t* data, size_t length) const;
+};
+
+} // namespace WiFiSet
+
+#endif // REPLY_QUEUE_H
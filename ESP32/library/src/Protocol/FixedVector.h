@@ -0,0 +1,87 @@
+#ifndef FIXED_VECTOR_H
+#define FIXED_VECTOR_H
+
+#include <stddef.h>
+
+namespace WiFiSet {
+
+/**
+ * FixedVector - Inline, fixed-capacity array with a std::vector-like interface
+ *
+ * Storage lives inside the object, so a FixedVector never touches the heap.
+ * push_back() on a full vector is ignored and returns false. Intended for
+ * trivially copyable element types (e.g. WiFiNetworkInfo).
+ *
+ * Usage:
+ *   FixedVector<WiFiNetworkInfo, 64> networks;
+ *   networks.push_back(info);
+ *   for (size_t i = 0; i < networks.size(); i++) use(networks[i]);
+ */
+template <typename T, size_t Capacity>
+class FixedVector {
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    static const size_t CAPACITY = Capacity;
+
+    FixedVector() : count(0) {}
+
+    size_t size() const { return count; }
+    size_t capacity() const { return Capacity; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+
+    T& front() { return items[0]; }
+    const T& front() const { return items[0]; }
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+
+    const T* data() const { return items; }
+
+    /**
+     * Append a copy of value
+     * @return false if the vector is full (value is dropped)
+     */
+    bool push_back(const T& value) {
+        if (count >= Capacity) {
+            return false;
+        }
+        items[count++] = value;
+        return true;
+    }
+
+    void pop_back() {
+        if (count > 0) {
+            count--;
+        }
+    }
+
+    /**
+     * Shrink to newSize elements (growing is not supported)
+     */
+    void truncate(size_t newSize) {
+        if (newSize < count) {
+            count = newSize;
+        }
+    }
+
+    void clear() { count = 0; }
+
+private:
+    T items[Capacity];
+    size_t count;
+};
+
+} // namespace WiFiSet
+
+#endif // FIXED_VECTOR_H
@@ -4,13 +4,15 @@ namespace WiFiSet {
 
 MessageBuilder::MessageBuilder() : sequenceCounter(0) {}
 
-std::vector<uint8_t> MessageBuilder::buildHeader(MessageType type, uint16_t payloadLength) {
-    std::vector<uint8_t> header(4);
-    header[0] = static_cast<uint8_t>(type);
-    header[1] = sequenceCounter;
-    header[2] = payloadLength & 0xFF;        // Low byte (little-endian)
-    header[3] = (payloadLength >> 8) & 0xFF; // High byte
-    return header;
+std::vector<uint8_t> MessageBuilder::toVector(const uint8_t* buffer, size_t length) {
+    return std::vector<uint8_t>(buffer, buffer + length);
+}
+
+size_t MessageBuilder::commit(size_t length) {
+    if (length > 0) {
+        incrementSequence();
+    }
+    return length;
 }
 
 void MessageBuilder::incrementSequence() {
@@ -18,113 +20,167 @@ void MessageBuilder::incrementSequence() {
     // Wraps automatically at 255 (uint8_t overflow)
 }
 
-std::vector<uint8_t> MessageBuilder::buildWiFiListStart() {
-    std::vector<uint8_t> message = buildHeader(MessageType::WIFI_LIST_START, 0);
-    incrementSequence();
-    return message;
-}
+//
+// Buffer encoding (no allocation)
+//
 
-std::vector<uint8_t> MessageBuilder::buildWiFiNetworkEntry(const WiFiNetworkInfo& network) {
-    // Calculate payload size
-    uint8_t ssidLength = network.ssid.length();
-    if (ssidLength > 32) {
-        ssidLength = 32; // WiFi SSID maximum length
-    }
+size_t MessageBuilder::encodeWiFiListStart(uint8_t* buffer, size_t capacity) {
+    return commit(ListStartSchema::encode(buffer, capacity, sequenceCounter));
+}
 
-    uint16_t payloadLength = 1 + ssidLength + 1 + 1 + 1; // SSID_len + SSID + RSSI + Security + Channel
+size_t MessageBuilder::encodeWiFiNetworkEntry(const WiFiNetworkInfo& network, uint8_t* buffer, size_t capacity) {
+    return commit(NetworkEntrySchema::encode(buffer, capacity, sequenceCounter,
+                                             network.ssidRef(), network.rssi, network.securityType, network.channel));
+}
 
-    // Build message
-    std::vector<uint8_t> message = buildHeader(MessageType::WIFI_NETWORK_ENTRY, payloadLength);
+size_t MessageBuilder::encodeWiFiNetworkBatch(
+    const NetworkList& networks,
+    size_t startIndex,
+    uint8_t* buffer,
+    size_t capacity,
+    size_t& outCount
+) {
+    if (startIndex > networks.size()) {
+        startIndex = networks.size();
+    }
 
-    // Add payload
-    message.push_back(ssidLength);
+    size_t length = NetworkBatchSchema::encode(buffer, capacity, sequenceCounter,
+                                               networks.begin() + startIndex, networks.end(), outCount);
+    return commit(outCount > 0 ? length : 0);
+}
 
-    // Add SSID bytes
-    for (uint8_t i = 0; i < ssidLength; i++) {
-        message.push_back(network.ssid[i]);
+size_t MessageBuilder::encodeWiFiNetworkDelta(
+    const NetworkChangeList& changes,
+    size_t startIndex,
+    uint8_t* buffer,
+    size_t capacity,
+    size_t& outCount
+) {
+    if (startIndex > changes.size()) {
+        startIndex = changes.size();
     }
 
-    message.push_back(static_cast<uint8_t>(network.rssi));
-    message.push_back(static_cast<uint8_t>(network.securityType));
-    message.push_back(network.channel);
+    size_t length = NetworkDeltaSchema::encode(buffer, capacity, sequenceCounter,
+                                               changes.begin() + startIndex, changes.end(), outCount);
+    return commit(outCount > 0 ? length : 0);
+}
 
-    incrementSequence();
-    return message;
+size_t MessageBuilder::encodeWiFiListEnd(uint8_t networkCount, uint8_t* buffer, size_t capacity) {
+    return commit(ListEndSchema::encode(buffer, capacity, sequenceCounter, networkCount));
 }
 
-std::vector<uint8_t> MessageBuilder::buildWiFiListEnd(uint8_t networkCount) {
-    std::vector<uint8_t> message = buildHeader(MessageType::WIFI_LIST_END, 1);
-    message.push_back(networkCount);
-    incrementSequence();
-    return message;
+size_t MessageBuilder::encodeCredentialWriteAck(uint8_t statusCode, uint8_t* buffer, size_t capacity) {
+    return commit(CredentialAckSchema::encode(buffer, capacity, sequenceCounter, statusCode));
 }
 
-std::vector<uint8_t> MessageBuilder::buildCredentialWriteAck(uint8_t statusCode) {
-    std::vector<uint8_t> message = buildHeader(MessageType::CREDENTIAL_WRITE_ACK, 1);
-    message.push_back(statusCode);
-    incrementSequence();
-    return message;
+size_t MessageBuilder::encodeIPConfigAck(uint8_t statusCode, uint8_t* buffer, size_t capacity) {
+    return commit(IPConfigAckSchema::encode(buffer, capacity, sequenceCounter, statusCode));
 }
 
-std::vector<uint8_t> MessageBuilder::buildStatusResponse(
+size_t MessageBuilder::encodeStatusResponse(
     ConnectionState state,
     int8_t rssi,
     IPAddress ipAddress,
-    const String& ssid
+    const String& ssid,
+    uint8_t disconnectReason,
+    uint8_t* buffer,
+    size_t capacity
 ) {
-    uint8_t ssidLength = ssid.length();
-    if (ssidLength > 32) {
-        ssidLength = 32;
-    }
+    return commit(StatusResponseSchema::encode(buffer, capacity, sequenceCounter,
+                                               state, rssi, ipAddress, ssid, disconnectReason));
+}
+
+size_t MessageBuilder::encodeError(ErrorCode errorCode, const String& errorMessage, uint8_t* buffer, size_t capacity) {
+    return commit(ErrorSchema::encode(buffer, capacity, sequenceCounter, errorCode, errorMessage));
+}
+
+size_t MessageBuilder::encodeError(ErrorCode errorCode, const char* errorMessage, uint8_t* buffer, size_t capacity) {
+    return commit(ErrorSchema::encode(buffer, capacity, sequenceCounter, errorCode, errorMessage));
+}
+
+size_t MessageBuilder::encodeCapabilities(
+    uint16_t supportedFeatures,
+    uint16_t maxMTU,
+    uint16_t sessionFeatures,
+    uint8_t* buffer,
+    size_t capacity
+) {
+    return commit(CapabilitiesSchema::encode(buffer, capacity, sequenceCounter,
+                                             PROTOCOL_VERSION_MAJOR, PROTOCOL_VERSION_MINOR,
+                                             supportedFeatures, maxMTU, sessionFeatures));
+}
 
-    // Payload: State(1) + RSSI(1) + IP(4) + SSID_len(1) + SSID(N)
-    uint16_t payloadLength = 1 + 1 + 4 + 1 + ssidLength;
+size_t MessageBuilder::encodeSavedNetworkList(const SavedNetworkList& networks, uint8_t* buffer, size_t capacity) {
+    // The list is all or nothing: a partial table would look like deleted networks
+    size_t count = 0;
+    size_t length = SavedNetworkListSchema::encode(buffer, capacity, sequenceCounter,
+                                                   networks.begin(), networks.end(), count);
+    return commit(count == networks.size() ? length : 0);
+}
 
-    std::vector<uint8_t> message = buildHeader(MessageType::STATUS_RESPONSE, payloadLength);
+size_t MessageBuilder::encodeSavedNetworkAck(MessageType request, uint8_t statusCode, uint8_t* buffer, size_t capacity) {
+    return commit(SavedNetworkAckSchema::encode(buffer, capacity, sequenceCounter, request, statusCode));
+}
 
-    // Add payload
-    message.push_back(static_cast<uint8_t>(state));
-    message.push_back(static_cast<uint8_t>(rssi));
+//
+// Vector building (thin wrappers over the buffer encoders)
+//
 
-    // Add IP address (4 bytes, network byte order - big-endian for IP)
-    message.push_back(ipAddress[0]);
-    message.push_back(ipAddress[1]);
-    message.push_back(ipAddress[2]);
-    message.push_back(ipAddress[3]);
+std::vector<uint8_t> MessageBuilder::buildWiFiListStart() {
+    uint8_t buffer[MAX_LIST_START_SIZE];
+    return toVector(buffer, encodeWiFiListStart(buffer, sizeof(buffer)));
+}
 
-    message.push_back(ssidLength);
+std::vector<uint8_t> MessageBuilder::buildWiFiNetworkEntry(const WiFiNetworkInfo& network) {
+    uint8_t buffer[MAX_NETWORK_ENTRY_SIZE];
+    return toVector(buffer, encodeWiFiNetworkEntry(network, buffer, sizeof(buffer)));
+}
 
-    // Add SSID bytes
-    for (uint8_t i = 0; i < ssidLength; i++) {
-        message.push_back(ssid[i]);
-    }
+std::vector<uint8_t> MessageBuilder::buildWiFiListEnd(uint8_t networkCount) {
+    uint8_t buffer[MAX_LIST_END_SIZE];
+    return toVector(buffer, encodeWiFiListEnd(networkCount, buffer, sizeof(buffer)));
+}
 
-    incrementSequence();
-    return message;
+std::vector<uint8_t> MessageBuilder::buildCredentialWriteAck(uint8_t statusCode) {
+    uint8_t buffer[MAX_CREDENTIAL_ACK_SIZE];
+    return toVector(buffer, encodeCredentialWriteAck(statusCode, buffer, sizeof(buffer)));
 }
 
-std::vector<uint8_t> MessageBuilder::buildError(ErrorCode errorCode, const String& errorMessage) {
-    uint8_t messageLength = errorMessage.length();
-    if (messageLength > 255) {
-        messageLength = 255;
-    }
+std::vector<uint8_t> MessageBuilder::buildIPConfigAck(uint8_t statusCode) {
+    uint8_t buffer[MAX_IP_CONFIG_ACK_SIZE];
+    return toVector(buffer, encodeIPConfigAck(statusCode, buffer, sizeof(buffer)));
+}
 
-    // Payload: ErrorCode(1) + MsgLength(1) + Message(N)
-    uint16_t payloadLength = 1 + 1 + messageLength;
+std::vector<uint8_t> MessageBuilder::buildStatusResponse(
+    ConnectionState state,
+    int8_t rssi,
+    IPAddress ipAddress,
+    const String& ssid,
+    uint8_t disconnectReason
+) {
+    uint8_t buffer[MAX_STATUS_RESPONSE_SIZE];
+    return toVector(buffer, encodeStatusResponse(state, rssi, ipAddress, ssid, disconnectReason,
+                                                 buffer, sizeof(buffer)));
+}
 
-    std::vector<uint8_t> message = buildHeader(MessageType::ERROR, payloadLength);
+std::vector<uint8_t> MessageBuilder::buildError(ErrorCode errorCode, const String& errorMessage) {
+    uint8_t buffer[MAX_ERROR_SIZE];
+    return toVector(buffer, encodeError(errorCode, errorMessage, buffer, sizeof(buffer)));
+}
 
-    // Add payload
-    message.push_back(static_cast<uint8_t>(errorCode));
-    message.push_back(messageLength);
+std::vector<uint8_t> MessageBuilder::buildCapabilities(uint16_t supportedFeatures, uint16_t maxMTU, uint16_t sessionFeatures) {
+    uint8_t buffer[MAX_CAPABILITIES_SIZE];
+    return toVector(buffer, encodeCapabilities(supportedFeatures, maxMTU, sessionFeatures, buffer, sizeof(buffer)));
+}
 
-    // Add error message bytes
-    for (uint8_t i = 0; i < messageLength; i++) {
-        message.push_back(errorMessage[i]);
-    }
+std::vector<uint8_t> MessageBuilder::buildSavedNetworkList(const SavedNetworkList& networks) {
+    uint8_t buffer[MAX_SAVED_NETWORK_LIST_SIZE];
+    return toVector(buffer, encodeSavedNetworkList(networks, buffer, sizeof(buffer)));
+}
 
-    incrementSequence();
-    return message;
+std::vector<uint8_t> MessageBuilder::buildSavedNetworkAck(MessageType request, uint8_t statusCode) {
+    uint8_t buffer[MAX_SAVED_NETWORK_ACK_SIZE];
+    return toVector(buffer, encodeSavedNetworkAck(request, statusCode, buffer, sizeof(buffer)));
 }
 
 void MessageBuilder::resetSequence() {
@@ -3,62 +3,202 @@
 
 #include <Arduino.h>
 #include <vector>
+#include "MessageTypes.h"
+#include "MessageSchema.h"
+#include "FixedVector.h"
 
 namespace WiFiSet {
 
-// Message Types (as defined in PROTOCOL.md)
-enum class MessageType : uint8_t {
-    WIFI_LIST_START = 0x01,
-    WIFI_NETWORK_ENTRY = 0x02,
-    WIFI_LIST_END = 0x03,
-    CREDENTIAL_WRITE = 0x10,
-    CREDENTIAL_WRITE_ACK = 0x11,
-    STATUS_REQUEST = 0x20,
-    STATUS_RESPONSE = 0x21,
-    ERROR = 0xFF
+// Maximum encoded size of each outgoing message (derived from the schemas)
+static const size_t MAX_LIST_START_SIZE = ListStartSchema::maxSize;
+static const size_t MAX_NETWORK_ENTRY_PAYLOAD = NetworkEntrySchema::maxPayloadSize;
+static const size_t MAX_NETWORK_ENTRY_SIZE = NetworkEntrySchema::maxSize;
+static const size_t MAX_LIST_END_SIZE = ListEndSchema::maxSize;
+static const size_t MAX_CREDENTIAL_ACK_SIZE = CredentialAckSchema::maxSize;
+static const size_t MAX_IP_CONFIG_ACK_SIZE = IPConfigAckSchema::maxSize;
+static const size_t MAX_STATUS_RESPONSE_SIZE = StatusResponseSchema::maxSize;
+static const size_t MAX_ERROR_SIZE = ErrorSchema::maxSize;
+static const size_t MAX_CAPABILITIES_SIZE = CapabilitiesSchema::maxSize;
+static const size_t MAX_SAVED_NETWORK_ACK_SIZE = SavedNetworkAckSchema::maxSize;
+
+// Distinct networks held by a scan table (raw candidates, results, client baseline)
+static const size_t MAX_NETWORK_LIST_SIZE = 64;
+
+// WiFi Network Information
+// One entry per SSID; rssi, securityType and channel are those of the strongest AP.
+// apCount and channelMask are device-side only and not sent over BLE.
+// Plain data with the SSID stored inline, so tables of networks never allocate.
+// Value-initialize new entries: WiFiNetworkInfo info = WiFiNetworkInfo();
+struct WiFiNetworkInfo {
+    char ssid[MAX_SSID_LENGTH + 1];   // NUL-terminated
+    uint8_t ssidLength;
+    int8_t rssi;
+    SecurityType securityType;
+    uint8_t channel;
+    uint8_t apCount;        // Number of APs merged into this entry
+    uint16_t channelMask;   // Bit n set if an AP was seen on 2.4 GHz channel n (1-14)
+
+    /**
+     * Copy an SSID (truncated to MAX_SSID_LENGTH bytes)
+     */
+    void setSSID(const char* data, size_t length) {
+        if (length > MAX_SSID_LENGTH) {
+            length = MAX_SSID_LENGTH;
+        }
+        memcpy(ssid, data, length);
+        ssid[length] = '\0';
+        ssidLength = static_cast<uint8_t>(length);
+    }
+
+    void setSSID(const char* value) { setSSID(value, strlen(value)); }
+
+    /**
+     * SSID as a protocol string (for the schema encoders)
+     */
+    Schema::StringRef ssidRef() const { return Schema::StringRef(ssid, ssidLength); }
+
+    /**
+     * Hidden networks have an empty SSID
+     */
+    bool hasSSID() const { return ssidLength > 0; }
+
+    bool sameSSID(const WiFiNetworkInfo& other) const {
+        return ssidLength == other.ssidLength && memcmp(ssid, other.ssid, ssidLength) == 0;
+    }
 };
 
-// WiFi Security Types
-enum class SecurityType : uint8_t {
-    OPEN = 0x00,
-    WEP = 0x01,
-    WPA_PSK = 0x02,
-    WPA2_ENTERPRISE = 0x03,
-    WPA3 = 0x04
+// One change in a WiFi Network Delta (REMOVED only carries the SSID)
+struct NetworkChange {
+    NetworkChangeType type;
+    WiFiNetworkInfo network;
+
+    NetworkChange() : type(NetworkChangeType::ADDED), network() {}
+    NetworkChange(NetworkChangeType t, const WiFiNetworkInfo& n) : type(t), network(n) {}
 };
 
-// Connection States
-enum class ConnectionState : uint8_t {
-    NOT_CONFIGURED = 0x00,
-    CONFIGURED_NOT_CONNECTED = 0x01,
-    CONNECTING = 0x02,
-    CONNECTED = 0x03,
-    CONNECTION_FAILED = 0x04
+// A network the device has credentials for (Saved Network List entry)
+// The password never leaves NVS, so it is not part of this record.
+struct SavedNetworkInfo {
+    char ssid[MAX_SSID_LENGTH + 1];   // NUL-terminated
+    uint8_t ssidLength;
+    uint8_t priority;       // Higher is tried first
+    uint8_t failureCount;   // Failed connects since the last success
+    uint32_t lastSuccess;   // Connect stamp of the last success (higher = more recent, 0 = never)
+
+    void setSSID(const char* data, size_t length) {
+        if (length > MAX_SSID_LENGTH) {
+            length = MAX_SSID_LENGTH;
+        }
+        memcpy(ssid, data, length);
+        ssid[length] = '\0';
+        ssidLength = static_cast<uint8_t>(length);
+    }
+
+    void setSSID(const char* value) { setSSID(value, strlen(value)); }
+
+    Schema::StringRef ssidRef() const { return Schema::StringRef(ssid, ssidLength); }
+};
+
+// Fixed-capacity network tables (see FixedVector.h)
+typedef FixedVector<WiFiNetworkInfo, MAX_NETWORK_LIST_SIZE> NetworkList;
+typedef FixedVector<SavedNetworkInfo, MAX_SAVED_NETWORKS> SavedNetworkList;
+
+// A delta can remove every network the client holds and add a full new list
+typedef FixedVector<NetworkChange, 2 * MAX_NETWORK_LIST_SIZE> NetworkChangeList;
+
+// Records of the repeated-record messages (layouts from the entry schemas in MessageSchema.h)
+
+// WiFi Network Batch entry: Network Entry payload
+struct NetworkEntryRecord {
+    typedef WiFiNetworkInfo value_type;
+    static const size_t minSize = NetworkEntrySchema::minPayloadSize;
+    static const size_t maxSize = NetworkEntrySchema::maxPayloadSize;
+
+    static size_t length(const WiFiNetworkInfo& network) {
+        return NetworkEntrySchema::payloadLength(network.ssidRef(), network.rssi, network.securityType,
+                                                 network.channel);
+    }
+
+    static size_t write(uint8_t* buffer, const WiFiNetworkInfo& network) {
+        return NetworkEntrySchema::writePayload(buffer, network.ssidRef(), network.rssi, network.securityType,
+                                                network.channel);
+    }
 };
 
-// Error Codes
-enum class ErrorCode : uint8_t {
-    INVALID_MESSAGE_FORMAT = 0x01,
-    SCAN_FAILED = 0x02,
-    CREDENTIAL_WRITE_FAILED = 0x03,
-    STORAGE_ERROR = 0x04,
-    CONNECTION_TIMEOUT = 0x05,
-    UNKNOWN_MESSAGE_TYPE = 0x06
+// WiFi Network Delta change: removals carry only the SSID
+struct NetworkChangeRecord {
+    typedef NetworkChange value_type;
+    static const size_t minSize = NetworkRemovalEntrySchema::minPayloadSize;
+    static const size_t maxSize = NetworkChangeEntrySchema::maxPayloadSize;
+
+    static size_t length(const NetworkChange& change) {
+        const WiFiNetworkInfo& network = change.network;
+        if (change.type == NetworkChangeType::REMOVED) {
+            return NetworkRemovalEntrySchema::payloadLength(change.type, network.ssidRef());
+        }
+        return NetworkChangeEntrySchema::payloadLength(change.type, network.ssidRef(), network.rssi,
+                                                       network.securityType, network.channel);
+    }
+
+    static size_t write(uint8_t* buffer, const NetworkChange& change) {
+        const WiFiNetworkInfo& network = change.network;
+        if (change.type == NetworkChangeType::REMOVED) {
+            return NetworkRemovalEntrySchema::writePayload(buffer, change.type, network.ssidRef());
+        }
+        return NetworkChangeEntrySchema::writePayload(buffer, change.type, network.ssidRef(), network.rssi,
+                                                      network.securityType, network.channel);
+    }
 };
 
-// WiFi Network Information
-struct WiFiNetworkInfo {
-    String ssid;
-    int8_t rssi;
-    SecurityType securityType;
-    uint8_t channel;
+// Saved Network List entry
+struct SavedNetworkRecord {
+    typedef SavedNetworkInfo value_type;
+    static const size_t minSize = SavedNetworkEntrySchema::minPayloadSize;
+    static const size_t maxSize = SavedNetworkEntrySchema::maxPayloadSize;
+
+    static size_t length(const SavedNetworkInfo& network) {
+        return SavedNetworkEntrySchema::payloadLength(network.ssidRef(), network.priority, network.failureCount,
+                                                      network.lastSuccess);
+    }
+
+    static size_t write(uint8_t* buffer, const SavedNetworkInfo& network) {
+        return SavedNetworkEntrySchema::writePayload(buffer, network.ssidRef(), network.priority,
+                                                     network.failureCount, network.lastSuccess);
+    }
 };
 
+// Count + Network Entry payloads
+typedef Schema::RepeatedSchema<MessageType::WIFI_NETWORK_BATCH, NetworkEntryRecord> NetworkBatchSchema;
+
+// Count + changes
+typedef Schema::RepeatedSchema<MessageType::WIFI_NETWORK_DELTA, NetworkChangeRecord> NetworkDeltaSchema;
+
+// Count + saved network entries (the whole table fits one message)
+typedef Schema::RepeatedSchema<MessageType::SAVED_NETWORK_LIST, SavedNetworkRecord, MAX_SAVED_NETWORKS>
+    SavedNetworkListSchema;
+
+static_assert(NetworkDeltaSchema::minRecordCapacity == 42, "Network Delta layout changed");
+static_assert(SavedNetworkListSchema::maxSize == 317, "Saved Network List layout changed");
+
+// Smallest buffers that hold one batch entry / delta change, and the whole saved network table
+static const size_t MIN_NETWORK_BATCH_SIZE = NetworkBatchSchema::minRecordCapacity;
+static const size_t MIN_NETWORK_DELTA_SIZE = NetworkDeltaSchema::minRecordCapacity;
+static const size_t MAX_SAVED_NETWORK_LIST_SIZE = SavedNetworkListSchema::maxSize;
+
 /**
  * MessageBuilder - Builds binary protocol messages
  *
  * Handles encoding of messages according to the WiFiSet protocol specification.
  * All messages include a 4-byte header: [Type, Sequence, Length_Low, Length_High]
+ *
+ * Two encoding APIs are provided:
+ * - build*()  returns a new std::vector (convenient, allocates)
+ * - encode*() writes into a caller-provided buffer and returns the encoded
+ *   length, or 0 if the buffer is too small. Use the MAX_*_SIZE constants to
+ *   size stack buffers. The encode*() API never touches the heap.
+ *
+ * The sequence counter is only advanced when a message is actually encoded.
+ * Wire layouts come from the schemas in MessageSchema.h.
  */
 class MessageBuilder {
 public:
@@ -90,15 +230,24 @@ public:
      */
     std::vector<uint8_t> buildCredentialWriteAck(uint8_t statusCode);
 
+    /**
+     * Build IP Config Acknowledgment message
+     * Confirms receipt of an IP configuration
+     * @param statusCode 0x00=Success, 0x01=Invalid configuration, 0x02=Storage failure
+     */
+    std::vector<uint8_t> buildIPConfigAck(uint8_t statusCode);
+
     /**
      * Build Status Response message
      * Contains current WiFi connection status
+     * @param disconnectReason WiFi reason code of the last disconnect (0 = none)
      */
     std::vector<uint8_t> buildStatusResponse(
         ConnectionState state,
         int8_t rssi,
         IPAddress ipAddress,
-        const String& ssid
+        const String& ssid,
+        uint8_t disconnectReason = 0
     );
 
     /**
@@ -107,6 +256,138 @@ public:
      */
     std::vector<uint8_t> buildError(ErrorCode errorCode, const String& errorMessage);
 
+    /**
+     * Build Capabilities message
+     * Answers a client HELLO with this device's protocol version and limits
+     * @param supportedFeatures ProtocolFeature bits implemented by this device
+     * @param maxMTU Largest ATT MTU this device accepts
+     * @param sessionFeatures ProtocolFeature bits enabled for this session
+     */
+    std::vector<uint8_t> buildCapabilities(uint16_t supportedFeatures, uint16_t maxMTU, uint16_t sessionFeatures);
+
+    /**
+     * Build Saved Network List message
+     * Lists the networks the device has credentials for (without passwords)
+     */
+    std::vector<uint8_t> buildSavedNetworkList(const SavedNetworkList& networks);
+
+    /**
+     * Build Saved Network Acknowledgment message
+     * @param request Message type of the request being answered
+     * @param statusCode SavedNetworkAckStatus value
+     */
+    std::vector<uint8_t> buildSavedNetworkAck(MessageType request, uint8_t statusCode);
+
+    // ==================== Buffer Encoding (no allocation) ====================
+
+    /**
+     * Encode WiFi List Start message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeWiFiListStart(uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode WiFi Network Entry message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeWiFiNetworkEntry(const WiFiNetworkInfo& network, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode WiFi Network Batch message into buffer
+     * Packs as many entries as fit, starting at networks[startIndex]
+     * @param outCount Number of entries packed (0 if none fit)
+     * @return Encoded length, or 0 if not even one entry fits
+     */
+    size_t encodeWiFiNetworkBatch(
+        const NetworkList& networks,
+        size_t startIndex,
+        uint8_t* buffer,
+        size_t capacity,
+        size_t& outCount
+    );
+
+    /**
+     * Encode WiFi Network Delta message into buffer
+     * Packs as many changes as fit, starting at changes[startIndex]
+     * @param outCount Number of changes packed (0 if none fit)
+     * @return Encoded length, or 0 if not even one change fits
+     */
+    size_t encodeWiFiNetworkDelta(
+        const NetworkChangeList& changes,
+        size_t startIndex,
+        uint8_t* buffer,
+        size_t capacity,
+        size_t& outCount
+    );
+
+    /**
+     * Encode WiFi List End message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeWiFiListEnd(uint8_t networkCount, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode Credential Write Acknowledgment message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeCredentialWriteAck(uint8_t statusCode, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode IP Config Acknowledgment message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeIPConfigAck(uint8_t statusCode, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode Status Response message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeStatusResponse(
+        ConnectionState state,
+        int8_t rssi,
+        IPAddress ipAddress,
+        const String& ssid,
+        uint8_t disconnectReason,
+        uint8_t* buffer,
+        size_t capacity
+    );
+
+    /**
+     * Encode Error message into buffer
+     * Messages longer than 255 bytes are truncated
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeError(ErrorCode errorCode, const String& errorMessage, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode Error message from a static string (no String construction)
+     */
+    size_t encodeError(ErrorCode errorCode, const char* errorMessage, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode Capabilities message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeCapabilities(
+        uint16_t supportedFeatures,
+        uint16_t maxMTU,
+        uint16_t sessionFeatures,
+        uint8_t* buffer,
+        size_t capacity
+    );
+
+    /**
+     * Encode Saved Network List message into buffer
+     * @return Encoded length, or 0 if capacity is too small for the whole list
+     */
+    size_t encodeSavedNetworkList(const SavedNetworkList& networks, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Encode Saved Network Acknowledgment message into buffer
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    size_t encodeSavedNetworkAck(MessageType request, uint8_t statusCode, uint8_t* buffer, size_t capacity);
+
     /**
      * Reset sequence counter
      */
@@ -121,10 +402,15 @@ private:
     uint8_t sequenceCounter;
 
     /**
-     * Build message header
-     * Returns 4-byte header: [Type, Sequence, Length_Low, Length_High]
+     * Advance the sequence counter if a message was encoded
+     * @return length (pass-through)
+     */
+    size_t commit(size_t length);
+
+    /**
+     * Wrap an encode*() result in a vector (used by the build*() API)
      */
-    std::vector<uint8_t> buildHeader(MessageType type, uint16_t payloadLength);
+    static std::vector<uint8_t> toVector(const uint8_t* buffer, size_t length);
 
     /**
      * Increment sequence counter (wraps at 255)
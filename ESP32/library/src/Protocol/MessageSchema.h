@@ -0,0 +1,467 @@
+#ifndef MESSAGE_SCHEMA_H
+#define MESSAGE_SCHEMA_H
+
+#include <string.h>
+#include <WString.h>
+#include <IPAddress.h>
+#include "MessageTypes.h"
+
+namespace WiFiSet {
+
+/**
+ * Compile-time wire schema for every protocol message
+ *
+ * Each message type is described once as a list of fields. The schema
+ * generates the encoder, the decoder and the worst-case size constants, so
+ * payload length arithmetic is never written by hand and buffers can be
+ * sized at compile time. Fixed-width fields compile down to straight-line
+ * byte stores/loads.
+ *
+ * Field types provide:
+ *   value_type                          Value passed to encode / filled by decode
+ *   minSize, maxSize                    Encoded size bounds
+ *   length(value)                       Encoded size of a value
+ *   write(buffer, value)                Encode (caller guarantees space)
+ *   read(payload, length, offset, out)  Decode, false if malformed
+ *
+ * Messages that carry a list (Network Batch, Network Delta, Saved Network
+ * List) use RepeatedSchema: a count byte followed by records, where each
+ * record type provides the encoding half of the field interface.
+ */
+namespace Schema {
+
+/**
+ * Non-owning string view used for string fields
+ * Decoded strings point into the payload buffer (no copy, no allocation).
+ */
+struct StringRef {
+    const char* data;
+    size_t length;
+
+    StringRef() : data(""), length(0) {}
+    StringRef(const char* d, size_t l) : data(d), length(l) {}
+    StringRef(const char* s) : data(s), length(strlen(s)) {}
+    StringRef(const String& s) : data(s.c_str()), length(s.length()) {}
+};
+
+/**
+ * Compile-time sum of field sizes
+ */
+template <size_t... Values>
+struct Sum;
+
+template <>
+struct Sum<> {
+    static const size_t value = 0;
+};
+
+template <size_t First, size_t... Rest>
+struct Sum<First, Rest...> {
+    static const size_t value = First + Sum<Rest...>::value;
+};
+
+/**
+ * Compile-time maximum of sizes
+ */
+template <size_t... Values>
+struct Max;
+
+template <size_t Value>
+struct Max<Value> {
+    static const size_t value = Value;
+};
+
+template <size_t First, size_t... Rest>
+struct Max<First, Rest...> {
+    static const size_t value = First > Max<Rest...>::value ? First : Max<Rest...>::value;
+};
+
+/**
+ * Single-byte field (uint8_t, int8_t or a uint8_t-backed enum)
+ */
+template <typename T>
+struct ByteField {
+    typedef T value_type;
+    static const size_t minSize = 1;
+    static const size_t maxSize = 1;
+
+    static size_t length(const T&) { return 1; }
+
+    static size_t write(uint8_t* buffer, const T& value) {
+        buffer[0] = static_cast<uint8_t>(value);
+        return 1;
+    }
+
+    static bool read(const uint8_t* payload, size_t length, size_t& offset, T& out) {
+        if (offset + 1 > length) {
+            return false;
+        }
+        out = static_cast<T>(payload[offset++]);
+        return true;
+    }
+};
+
+/**
+ * Two-byte unsigned field (little-endian)
+ */
+struct U16Field {
+    typedef uint16_t value_type;
+    static const size_t minSize = 2;
+    static const size_t maxSize = 2;
+
+    static size_t length(const uint16_t&) { return 2; }
+
+    static size_t write(uint8_t* buffer, const uint16_t& value) {
+        buffer[0] = value & 0xFF;
+        buffer[1] = (value >> 8) & 0xFF;
+        return 2;
+    }
+
+    static bool read(const uint8_t* payload, size_t length, size_t& offset, uint16_t& out) {
+        if (offset + 2 > length) {
+            return false;
+        }
+        out = payload[offset] | (static_cast<uint16_t>(payload[offset + 1]) << 8);
+        offset += 2;
+        return true;
+    }
+};
+
+/**
+ * Four-byte unsigned field (little-endian)
+ */
+struct U32Field {
+    typedef uint32_t value_type;
+    static const size_t minSize = 4;
+    static const size_t maxSize = 4;
+
+    static size_t length(const uint32_t&) { return 4; }
+
+    static size_t write(uint8_t* buffer, const uint32_t& value) {
+        buffer[0] = value & 0xFF;
+        buffer[1] = (value >> 8) & 0xFF;
+        buffer[2] = (value >> 16) & 0xFF;
+        buffer[3] = (value >> 24) & 0xFF;
+        return 4;
+    }
+
+    static bool read(const uint8_t* payload, size_t length, size_t& offset, uint32_t& out) {
+        if (offset + 4 > length) {
+            return false;
+        }
+        out = payload[offset] | (static_cast<uint32_t>(payload[offset + 1]) << 8) |
+              (static_cast<uint32_t>(payload[offset + 2]) << 16) | (static_cast<uint32_t>(payload[offset + 3]) << 24);
+        offset += 4;
+        return true;
+    }
+};
+
+/**
+ * IPv4 address field (4 bytes, network byte order)
+ */
+struct IPv4Field {
+    typedef IPAddress value_type;
+    static const size_t minSize = 4;
+    static const size_t maxSize = 4;
+
+    static size_t length(const IPAddress&) { return 4; }
+
+    static size_t write(uint8_t* buffer, const IPAddress& value) {
+        buffer[0] = value[0];
+        buffer[1] = value[1];
+        buffer[2] = value[2];
+        buffer[3] = value[3];
+        return 4;
+    }
+
+    static bool read(const uint8_t* payload, size_t length, size_t& offset, IPAddress& out) {
+        if (offset + 4 > length) {
+            return false;
+        }
+        out = IPAddress(payload[offset], payload[offset + 1], payload[offset + 2], payload[offset + 3]);
+        offset += 4;
+        return true;
+    }
+};
+
+/**
+ * Length-prefixed string field: Length(1) + Bytes(N), MinLength <= N <= MaxLength
+ * Encoding truncates values longer than MaxLength.
+ */
+template <size_t MaxLength, size_t MinLength = 0>
+struct StringField {
+    typedef StringRef value_type;
+    static const size_t minSize = 1 + MinLength;
+    static const size_t maxSize = 1 + MaxLength;
+
+    static size_t clamp(const StringRef& value) {
+        return value.length > MaxLength ? MaxLength : value.length;
+    }
+
+    static size_t length(const StringRef& value) { return 1 + clamp(value); }
+
+    static size_t write(uint8_t* buffer, const StringRef& value) {
+        size_t n = clamp(value);
+        buffer[0] = static_cast<uint8_t>(n);
+        memcpy(buffer + 1, value.data, n);
+        return 1 + n;
+    }
+
+    static bool read(const uint8_t* payload, size_t length, size_t& offset, StringRef& out) {
+        if (offset + 1 > length) {
+            return false;
+        }
+        size_t n = payload[offset];
+        if (n > MaxLength || n < MinLength || offset + 1 + n > length) {
+            return false;
+        }
+        out = StringRef(reinterpret_cast<const char*>(payload + offset + 1), n);
+        offset += 1 + n;
+        return true;
+    }
+};
+
+/**
+ * Write the 4-byte message header: [Type, Sequence, Length_Low, Length_High]
+ */
+inline size_t writeHeader(uint8_t* buffer, MessageType type, uint8_t sequence, uint16_t payloadLength) {
+    buffer[0] = static_cast<uint8_t>(type);
+    buffer[1] = sequence;
+    buffer[2] = payloadLength & 0xFF;        // Low byte (little-endian)
+    buffer[3] = (payloadLength >> 8) & 0xFF; // High byte
+    return MESSAGE_HEADER_SIZE;
+}
+
+/**
+ * Message schema: a message type followed by an ordered list of fields
+ */
+template <MessageType Type, typename... Fields>
+struct MessageSchema {
+    static const MessageType type = Type;
+    static const size_t minPayloadSize = Sum<Fields::minSize...>::value;
+    static const size_t maxPayloadSize = Sum<Fields::maxSize...>::value;
+    static const size_t maxSize = MESSAGE_HEADER_SIZE + maxPayloadSize;
+
+    static_assert(maxPayloadSize <= 0xFFFF, "Payload must fit the 16-bit length field");
+
+    /**
+     * Encoded payload length for the given values
+     */
+    static size_t payloadLength(const typename Fields::value_type&... values) {
+        return sumLengths(Fields::length(values)...);
+    }
+
+    /**
+     * Write payload only (caller guarantees payloadLength() bytes of space)
+     */
+    static size_t writePayload(uint8_t* buffer, const typename Fields::value_type&... values) {
+        size_t offset = 0;
+        // Braced initializer lists are evaluated left to right
+        int expand[] = {0, (offset += Fields::write(buffer + offset, values), 0)...};
+        (void)expand;
+        return offset;
+    }
+
+    /**
+     * Encode header + payload
+     * @return Encoded length, or 0 if capacity is too small
+     */
+    static size_t encode(uint8_t* buffer, size_t capacity, uint8_t sequence,
+                         const typename Fields::value_type&... values) {
+        size_t length = payloadLength(values...);
+        if (capacity < MESSAGE_HEADER_SIZE + length) {
+            return 0;
+        }
+        size_t offset = writeHeader(buffer, Type, sequence, static_cast<uint16_t>(length));
+        return offset + writePayload(buffer + offset, values...);
+    }
+
+    /**
+     * Decode payload (header already consumed)
+     * @return false if the payload is truncated or a field is out of range
+     */
+    static bool decode(const uint8_t* payload, size_t length, typename Fields::value_type&... out) {
+        size_t offset = 0;
+        bool ok = true;
+        int expand[] = {0, (ok = ok && Fields::read(payload, length, offset, out), 0)...};
+        (void)expand;
+        return ok;
+    }
+
+private:
+    static size_t sumLengths() { return 0; }
+
+    template <typename... Rest>
+    static size_t sumLengths(size_t first, Rest... rest) { return first + sumLengths(rest...); }
+};
+
+/**
+ * Repeated-record schema: a message type, a record count, then the records
+ *
+ * Record types provide value_type, minSize, maxSize, length(value) and
+ * write(buffer, value). Records are packed in order until the buffer is
+ * full or MaxCount is reached; the caller decides whether a partial list
+ * is acceptable.
+ */
+template <MessageType Type, typename Record, size_t MaxCount = 0xFF>
+struct RepeatedSchema {
+    typedef ByteField<uint8_t> CountField;
+
+    static const MessageType type = Type;
+    static const size_t maxRecordCount = MaxCount;
+    static const size_t minPayloadSize = CountField::minSize;
+    static const size_t maxPayloadSize = CountField::maxSize + MaxCount * Record::maxSize;
+    static const size_t maxSize = MESSAGE_HEADER_SIZE + maxPayloadSize;
+
+    // Smallest buffer that always holds at least one record
+    static const size_t minRecordCapacity = MESSAGE_HEADER_SIZE + CountField::maxSize + Record::maxSize;
+
+    static_assert(MaxCount <= 0xFF, "Record count must fit the count byte");
+    static_assert(maxPayloadSize <= 0xFFFF, "Payload must fit the 16-bit length field");
+
+    /**
+     * Encode header + count + as many records from [first, last) as fit
+     * @param outCount Number of records written
+     * @return Encoded length, or 0 if capacity cannot hold the header and count
+     */
+    template <typename Iterator>
+    static size_t encode(uint8_t* buffer, size_t capacity, uint8_t sequence,
+                         Iterator first, Iterator last, size_t& outCount) {
+        outCount = 0;
+        size_t offset = MESSAGE_HEADER_SIZE + CountField::maxSize;
+        if (capacity < offset) {
+            return 0;
+        }
+
+        for (; first != last && outCount < MaxCount; ++first) {
+            if (Record::length(*first) > capacity - offset) {
+                break;
+            }
+            offset += Record::write(buffer + offset, *first);
+            outCount++;
+        }
+
+        writeHeader(buffer, Type, sequence, static_cast<uint16_t>(offset - MESSAGE_HEADER_SIZE));
+        CountField::write(buffer + MESSAGE_HEADER_SIZE, static_cast<uint8_t>(outCount));
+        return offset;
+    }
+};
+
+// Common fields
+typedef StringField<MAX_SSID_LENGTH> SsidField;
+typedef ByteField<uint8_t> U8Field;
+typedef ByteField<int8_t> RssiField;
+
+// ==================== Message Schemas (PROTOCOL.md) ====================
+
+typedef MessageSchema<MessageType::WIFI_LIST_START> ListStartSchema;
+
+// SSID + RSSI + Security + Channel
+typedef MessageSchema<MessageType::WIFI_NETWORK_ENTRY,
+                      SsidField, RssiField, ByteField<SecurityType>, U8Field> NetworkEntrySchema;
+
+// One Network Delta change: Kind + SSID + RSSI + Security + Channel (added or updated)
+typedef MessageSchema<MessageType::WIFI_NETWORK_DELTA,
+                      ByteField<NetworkChangeType>, SsidField, RssiField, ByteField<SecurityType>, U8Field>
+    NetworkChangeEntrySchema;
+
+// One Network Delta change: Kind + SSID (removed)
+typedef MessageSchema<MessageType::WIFI_NETWORK_DELTA, ByteField<NetworkChangeType>, SsidField>
+    NetworkRemovalEntrySchema;
+
+// Enable + RSSI Threshold
+typedef MessageSchema<MessageType::SCAN_SUBSCRIBE, U8Field, U8Field> ScanSubscribeSchema;
+
+// Network Count
+typedef MessageSchema<MessageType::WIFI_LIST_END, U8Field> ListEndSchema;
+
+// SSID (1-32) + Password (0-63)
+typedef MessageSchema<MessageType::CREDENTIAL_WRITE,
+                      StringField<MAX_SSID_LENGTH, 1>,
+                      StringField<MAX_PASSWORD_LENGTH>> CredentialWriteSchema;
+
+// Status Code
+typedef MessageSchema<MessageType::CREDENTIAL_WRITE_ACK, U8Field> CredentialAckSchema;
+
+// Mode + IP + Subnet Mask + Gateway + DNS 1 + DNS 2
+typedef MessageSchema<MessageType::IP_CONFIG_WRITE,
+                      ByteField<IPMode>, IPv4Field, IPv4Field, IPv4Field, IPv4Field, IPv4Field> IPConfigWriteSchema;
+
+// Status Code
+typedef MessageSchema<MessageType::IP_CONFIG_ACK, U8Field> IPConfigAckSchema;
+
+// SSID (1-32) + Password (0-63) + Priority
+typedef MessageSchema<MessageType::SAVED_NETWORK_ADD,
+                      StringField<MAX_SSID_LENGTH, 1>,
+                      StringField<MAX_PASSWORD_LENGTH>, U8Field> SavedNetworkAddSchema;
+
+// SSID (1-32)
+typedef MessageSchema<MessageType::SAVED_NETWORK_REMOVE, StringField<MAX_SSID_LENGTH, 1>> SavedNetworkRemoveSchema;
+
+// SSID (1-32) + Priority
+typedef MessageSchema<MessageType::SAVED_NETWORK_PRIORITY,
+                      StringField<MAX_SSID_LENGTH, 1>, U8Field> SavedNetworkPrioritySchema;
+
+typedef MessageSchema<MessageType::SAVED_NETWORK_LIST_REQUEST> SavedNetworkListRequestSchema;
+
+// One Saved Network List entry: SSID + Priority + Failure Count + Last Success
+typedef MessageSchema<MessageType::SAVED_NETWORK_LIST,
+                      SsidField, U8Field, U8Field, U32Field> SavedNetworkEntrySchema;
+
+// Request Type + Status Code
+typedef MessageSchema<MessageType::SAVED_NETWORK_ACK, ByteField<MessageType>, U8Field> SavedNetworkAckSchema;
+
+typedef MessageSchema<MessageType::STATUS_REQUEST> StatusRequestSchema;
+
+// State + RSSI + IP + SSID + Disconnect Reason
+typedef MessageSchema<MessageType::STATUS_RESPONSE,
+                      ByteField<ConnectionState>, RssiField, IPv4Field, SsidField, U8Field> StatusResponseSchema;
+
+// Error Code + Message
+typedef MessageSchema<MessageType::ERROR,
+                      ByteField<ErrorCode>, StringField<MAX_ERROR_MESSAGE_LENGTH>> ErrorSchema;
+
+// Version Major + Version Minor + Features + Max MTU
+typedef MessageSchema<MessageType::HELLO,
+                      U8Field, U8Field, U16Field, U16Field> HelloSchema;
+
+// Version Major + Version Minor + Supported Features + Max MTU + Session Features
+typedef MessageSchema<MessageType::CAPABILITIES,
+                      U8Field, U8Field, U16Field, U16Field, U16Field> CapabilitiesSchema;
+
+// Worst-case sizes are part of the protocol contract
+static_assert(NetworkEntrySchema::maxSize == 40, "Network Entry layout changed");
+static_assert(CredentialWriteSchema::maxSize == 101, "Credential Write layout changed");
+static_assert(StatusResponseSchema::maxSize == 44, "Status Response layout changed");
+static_assert(IPConfigWriteSchema::maxSize == 25, "IP Config Write layout changed");
+static_assert(SavedNetworkAddSchema::maxSize == 102, "Saved Network Add layout changed");
+static_assert(SavedNetworkEntrySchema::maxPayloadSize == 39, "Saved Network List entry layout changed");
+static_assert(ErrorSchema::maxSize == 261, "Error layout changed");
+
+} // namespace Schema
+
+using Schema::ListStartSchema;
+using Schema::NetworkEntrySchema;
+using Schema::NetworkChangeEntrySchema;
+using Schema::NetworkRemovalEntrySchema;
+using Schema::ScanSubscribeSchema;
+using Schema::ListEndSchema;
+using Schema::CredentialWriteSchema;
+using Schema::CredentialAckSchema;
+using Schema::IPConfigWriteSchema;
+using Schema::IPConfigAckSchema;
+using Schema::SavedNetworkAddSchema;
+using Schema::SavedNetworkRemoveSchema;
+using Schema::SavedNetworkPrioritySchema;
+using Schema::SavedNetworkListRequestSchema;
+using Schema::SavedNetworkEntrySchema;
+using Schema::SavedNetworkAckSchema;
+using Schema::StatusRequestSchema;
+using Schema::StatusResponseSchema;
+using Schema::ErrorSchema;
+using Schema::HelloSchema;
+using Schema::CapabilitiesSchema;
+
+} // namespace WiFiSet
+
+#endif // MESSAGE_SCHEMA_H
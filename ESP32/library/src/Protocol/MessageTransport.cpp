@@ -0,0 +1,31 @@
+#include "MessageTransport.h"
+
+namespace WiFiSet {
+
+//
+// MessageFragmenter Implementation
+//
+
+MessageFragmenter::MessageFragmenter(const uint8_t* data, size_t length, size_t maxChunkSize)
+    : data(data),
+      length(length),
+      maxChunkSize(maxChunkSize > 0 ? maxChunkSize : 1),
+      offset(0) {}
+
+bool MessageFragmenter::next(const uint8_t*& outChunk, size_t& outLength) {
+    if (offset >= length) {
+        return false;
+    }
+
+    size_t remaining = length - offset;
+    outChunk = data + offset;
+    outLength = remaining < maxChunkSize ? remaining : maxChunkSize;
+    offset += outLength;
+    return true;
+}
+
+size_t MessageFragmenter::fragmentCount() const {
+    return (length + maxChunkSize - 1) / maxChunkSize;
+}
+
+} // namespace WiFiSet
@@ -0,0 +1,56 @@
+#ifndef MESSAGE_TRANSPORT_H
+#define MESSAGE_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "MessageTypes.h"
+
+namespace WiFiSet {
+
+/**
+ * MessageFragmenter - Splits an encoded message into MTU-sized chunks
+ *
+ * Fragments carry no extra framing: the receiver uses the payload length
+ * in the 4-byte message header to know when a message is complete.
+ *
+ * Usage:
+ *   MessageFragmenter fragmenter(data, length, mtu - 3);
+ *   const uint8_t* chunk;
+ *   size_t chunkLength;
+ *   while (fragmenter.next(chunk, chunkLength)) {
+ *       send(chunk, chunkLength);
+ *   }
+ */
+class MessageFragmenter {
+public:
+    /**
+     * @param data Encoded message (must outlive the fragmenter)
+     * @param length Length of encoded message
+     * @param maxChunkSize Maximum bytes per fragment (e.g. MTU - 3)
+     */
+    MessageFragmenter(const uint8_t* data, size_t length, size_t maxChunkSize);
+
+    /**
+     * Get the next fragment
+     * @param outChunk Pointer to fragment start (points into the message)
+     * @param outLength Fragment length
+     * @return false when all fragments have been returned
+     */
+    bool next(const uint8_t*& outChunk, size_t& outLength);
+
+    /**
+     * Number of fragments the message will be split into
+     */
+    size_t fragmentCount() const;
+
+private:
+    const uint8_t* data;
+    size_t length;
+    size_t maxChunkSize;
+    size_t offset;
+};
+
+} // namespace WiFiSet
+
+#endif // MESSAGE_TRANSPORT_H
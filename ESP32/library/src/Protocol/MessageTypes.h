@@ -0,0 +1,132 @@
+#ifndef MESSAGE_TYPES_H
+#define MESSAGE_TYPES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace WiFiSet {
+
+// Message Types (as defined in PROTOCOL.md)
+enum class MessageType : uint8_t {
+    WIFI_LIST_START = 0x01,
+    WIFI_NETWORK_ENTRY = 0x02,
+    WIFI_LIST_END = 0x03,
+    WIFI_NETWORK_BATCH = 0x04,
+    WIFI_NETWORK_DELTA = 0x05,
+    SCAN_SUBSCRIBE = 0x06,
+    CREDENTIAL_WRITE = 0x10,
+    CREDENTIAL_WRITE_ACK = 0x11,
+    IP_CONFIG_WRITE = 0x12,
+    IP_CONFIG_ACK = 0x13,
+    SAVED_NETWORK_ADD = 0x14,
+    SAVED_NETWORK_REMOVE = 0x15,
+    SAVED_NETWORK_PRIORITY = 0x16,
+    SAVED_NETWORK_LIST_REQUEST = 0x17,
+    SAVED_NETWORK_LIST = 0x18,
+    SAVED_NETWORK_ACK = 0x19,
+    STATUS_REQUEST = 0x20,
+    STATUS_RESPONSE = 0x21,
+    HELLO = 0x30,
+    CAPABILITIES = 0x31,
+    ERROR = 0xFF
+};
+
+// WiFi Security Types
+enum class SecurityType : uint8_t {
+    OPEN = 0x00,
+    WEP = 0x01,
+    WPA_PSK = 0x02,
+    WPA2_ENTERPRISE = 0x03,
+    WPA3 = 0x04
+};
+
+// Change kinds in a WiFi Network Delta
+enum class NetworkChangeType : uint8_t {
+    ADDED = 0x01,
+    REMOVED = 0x02,
+    UPDATED = 0x03
+};
+
+// Connection States
+enum class ConnectionState : uint8_t {
+    NOT_CONFIGURED = 0x00,
+    CONFIGURED_NOT_CONNECTED = 0x01,
+    CONNECTING = 0x02,
+    CONNECTED = 0x03,
+    CONNECTION_FAILED = 0x04
+};
+
+// How the device gets its IP address (IP Config Write)
+enum class IPMode : uint8_t {
+    DHCP = 0x00,
+    STATIC = 0x01
+};
+
+// Error Codes
+enum class ErrorCode : uint8_t {
+    INVALID_MESSAGE_FORMAT = 0x01,
+    SCAN_FAILED = 0x02,
+    CREDENTIAL_WRITE_FAILED = 0x03,
+    STORAGE_ERROR = 0x04,
+    CONNECTION_TIMEOUT = 0x05,
+    UNKNOWN_MESSAGE_TYPE = 0x06
+};
+
+// Credential Write ACK status byte
+namespace CredentialAckStatus {
+    static const uint8_t SUCCESS = 0x00;
+    static const uint8_t INVALID_SSID = 0x01;
+    static const uint8_t INVALID_PASSWORD = 0x02;
+    static const uint8_t STORAGE_FAILURE = 0x03;
+}
+
+// IP Config ACK status byte
+namespace IPConfigAckStatus {
+    static const uint8_t SUCCESS = 0x00;
+    static const uint8_t INVALID_CONFIG = 0x01;
+    static const uint8_t STORAGE_FAILURE = 0x02;
+    static const uint8_t BUSY = 0x03;
+}
+
+// Saved Network ACK status byte
+namespace SavedNetworkAckStatus {
+    static const uint8_t SUCCESS = 0x00;
+    static const uint8_t INVALID_SSID = 0x01;
+    static const uint8_t INVALID_PASSWORD = 0x02;
+    static const uint8_t STORAGE_FAILURE = 0x03;
+    static const uint8_t NOT_FOUND = 0x04;
+    static const uint8_t TABLE_FULL = 0x05;
+    static const uint8_t BUSY = 0x06;
+}
+
+// Protocol version advertised in CAPABILITIES (clients that never send HELLO are treated as 1.0)
+static const uint8_t PROTOCOL_VERSION_MAJOR = 1;
+static const uint8_t PROTOCOL_VERSION_MINOR = 5;
+
+// Optional protocol features negotiated via HELLO / CAPABILITIES (bitmask)
+namespace ProtocolFeature {
+    static const uint16_t NONE = 0x0000;
+    static const uint16_t BATCHED_NETWORK_LIST = 0x0001; // WiFi Network Batch (0x04)
+    static const uint16_t FRAGMENTATION = 0x0002;        // Messages split across MTU-sized notifications
+    static const uint16_t COMPRESSION = 0x0004;          // Reserved
+    static const uint16_t ENCRYPTION = 0x0008;           // Reserved
+    static const uint16_t DELTA_UPDATES = 0x0010;        // Scan Subscribe (0x06) / WiFi Network Delta (0x05)
+    static const uint16_t IP_CONFIG = 0x0020;            // IP Config Write (0x12) / IP Config ACK (0x13)
+    static const uint16_t SAVED_NETWORKS = 0x0040;       // Saved Network messages (0x14 - 0x19)
+}
+
+// Features implemented by this firmware
+static const uint16_t SUPPORTED_FEATURES =
+    ProtocolFeature::BATCHED_NETWORK_LIST | ProtocolFeature::FRAGMENTATION | ProtocolFeature::DELTA_UPDATES |
+    ProtocolFeature::IP_CONFIG | ProtocolFeature::SAVED_NETWORKS;
+
+// Protocol size limits (as defined in PROTOCOL.md)
+static const size_t MESSAGE_HEADER_SIZE = 4;
+static const size_t MAX_SSID_LENGTH = 32;
+static const size_t MAX_PASSWORD_LENGTH = 63;
+static const size_t MAX_ERROR_MESSAGE_LENGTH = 255;
+static const size_t MAX_SAVED_NETWORKS = 8;
+
+} // namespace WiFiSet
+
+#endif // MESSAGE_TYPES_H
@@ -2,9 +2,21 @@
 
 namespace WiFiSet {
 
-ProtocolHandler::ProtocolHandler() : lastError("") {}
+ProtocolHandler::ProtocolHandler()
+    : lastError(Status::OK),
+      parserState(ParserState::HEADER),
+      headerReceived(0),
+      payloadRemaining(0),
+      discardRemaining(0),
+      fieldLength(0),
+      fieldReceived(0),
+      payloadReceived(0),
+      messageFailed(false) {
+    ssidBuffer[0] = '\0';
+    passwordBuffer[0] = '\0';
+}
 
-void ProtocolHandler::setError(const String& error) {
+void ProtocolHandler::setError(Status error) {
     lastError = error;
 }
 
@@ -12,7 +24,7 @@ MessageHeader ProtocolHandler::parseHeader(const uint8_t* data, size_t length) {
     MessageHeader header;
 
     if (length < 4) {
-        setError("Message too short for header");
+        setError(Status::MESSAGE_TOO_SHORT);
         return header;
     }
 
@@ -26,7 +38,7 @@ MessageHeader ProtocolHandler::parseHeader(const uint8_t* data, size_t length) {
 
 bool ProtocolHandler::validateMessage(const uint8_t* data, size_t length) {
     if (length < 4) {
-        setError("Message too short");
+        setError(Status::MESSAGE_TOO_SHORT);
         return false;
     }
 
@@ -38,108 +50,414 @@ bool ProtocolHandler::validateMessage(const uint8_t* data, size_t length) {
     // Check if total length matches header + payload
     size_t expectedLength = 4 + header.payloadLength;
     if (length != expectedLength) {
-        setError("Message length mismatch");
+        setError(Status::MESSAGE_LENGTH_MISMATCH);
         return false;
     }
 
     return true;
 }
 
-bool ProtocolHandler::extractString(const uint8_t* data, size_t available,
-                                    uint8_t maxLength, String& outString,
-                                    size_t& outBytesRead) {
-    if (available < 1) {
-        setError("Not enough data for string length");
-        return false;
-    }
+//
+// Streaming parser
+//
 
-    uint8_t stringLength = data[0];
+void ProtocolHandler::resetParser() {
+    parserState = ParserState::HEADER;
+    headerReceived = 0;
+    payloadRemaining = 0;
+    discardRemaining = 0;
+    messageFailed = false;
+}
 
-    if (stringLength > maxLength) {
-        setError("String length exceeds maximum");
-        return false;
+void ProtocolHandler::failMessage(Status error) {
+    // Keep the first failure; the rest of the payload is discarded
+    if (!messageFailed) {
+        setError(error);
+        messageFailed = true;
     }
+    parserState = ParserState::SKIP;
+}
 
-    if (available < 1 + stringLength) {
-        setError("Not enough data for string content");
-        return false;
+void ProtocolHandler::beginPayload() {
+    message.header.type = static_cast<MessageType>(headerBytes[0]);
+    message.header.sequence = headerBytes[1];
+    message.header.payloadLength = headerBytes[2] | (static_cast<uint16_t>(headerBytes[3]) << 8); // Little-endian
+    message.header.isValid = true;
+    message.credentials = CredentialData();
+    message.hello = HelloData();
+    message.subscribe = ScanSubscribeData();
+    message.ipConfig = IPConfigData();
+    message.savedNetwork = SavedNetworkRequest();
+    message.status = Status::OK;
+
+    payloadRemaining = message.header.payloadLength;
+    payloadReceived = 0;
+    messageFailed = false;
+
+    switch (message.header.type) {
+        case MessageType::CREDENTIAL_WRITE:
+            parserState = ParserState::SSID_LENGTH;
+            break;
+        case MessageType::STATUS_REQUEST:
+        case MessageType::SAVED_NETWORK_LIST_REQUEST:
+            parserState = ParserState::SKIP;
+            if (payloadRemaining != 0) {
+                failMessage(Status::UNEXPECTED_PAYLOAD);
+            }
+            break;
+        case MessageType::HELLO:
+        case MessageType::SCAN_SUBSCRIBE:
+        case MessageType::IP_CONFIG_WRITE:
+        case MessageType::SAVED_NETWORK_ADD:
+        case MessageType::SAVED_NETWORK_REMOVE:
+        case MessageType::SAVED_NETWORK_PRIORITY:
+            // Newer clients may append fields; extra bytes are skipped
+            parserState = ParserState::FIXED_PAYLOAD;
+            break;
+        default:
+            failMessage(Status::UNKNOWN_MESSAGE_TYPE);
+            break;
     }
+}
 
-    // Extract string
-    outString = "";
-    outString.reserve(stringLength);
-    for (uint8_t i = 0; i < stringLength; i++) {
-        outString += (char)data[1 + i];
+ParseResult ProtocolHandler::finishMessage() {
+    // Payload ended before all fields were read
+    switch (parserState) {
+        case ParserState::SSID_LENGTH:
+        case ParserState::PASSWORD_LENGTH:
+            failMessage(Status::TRUNCATED_FIELD);
+            break;
+        case ParserState::SSID_DATA:
+        case ParserState::PASSWORD_DATA:
+            failMessage(Status::TRUNCATED_FIELD);
+            break;
+        default:
+            break;
     }
 
-    outBytesRead = 1 + stringLength;
-    return true;
+    ParseResult result = ParseResult::MESSAGE_INVALID;
+    if (!messageFailed) {
+        result = ParseResult::MESSAGE_READY;
+
+        if (message.header.type == MessageType::CREDENTIAL_WRITE) {
+            // Password can be empty for open networks
+            message.credentials = CredentialData(String(ssidBuffer), String(passwordBuffer));
+        } else if (message.header.type == MessageType::HELLO) {
+            HelloData& hello = message.hello;
+            if (!HelloSchema::decode(payloadBuffer, payloadReceived, hello.versionMajor, hello.versionMinor,
+                                     hello.features, hello.maxMTU)) {
+                setError(Status::TRUNCATED_FIELD);
+                result = ParseResult::MESSAGE_INVALID;
+            }
+        } else if (message.header.type == MessageType::SCAN_SUBSCRIBE) {
+            uint8_t enabled = 0;
+            ScanSubscribeData& subscribe = message.subscribe;
+            if (ScanSubscribeSchema::decode(payloadBuffer, payloadReceived, enabled, subscribe.rssiThreshold)) {
+                subscribe.enabled = enabled != 0;
+            } else {
+                setError(Status::TRUNCATED_FIELD);
+                result = ParseResult::MESSAGE_INVALID;
+            }
+        } else if (message.header.type == MessageType::IP_CONFIG_WRITE) {
+            IPConfigData& config = message.ipConfig;
+            if (!IPConfigWriteSchema::decode(payloadBuffer, payloadReceived, config.mode, config.address,
+                                             config.subnet, config.gateway, config.dns1, config.dns2)) {
+                setError(Status::TRUNCATED_FIELD);
+                result = ParseResult::MESSAGE_INVALID;
+            } else if (!isValidIPConfig(config)) {
+                setError(Status::INVALID_IP_CONFIG);
+                result = ParseResult::MESSAGE_INVALID;
+            }
+        } else if (message.header.type == MessageType::SAVED_NETWORK_LIST_REQUEST) {
+            message.savedNetwork.type = MessageType::SAVED_NETWORK_LIST_REQUEST;
+        } else if (message.header.type == MessageType::SAVED_NETWORK_ADD ||
+                   message.header.type == MessageType::SAVED_NETWORK_REMOVE ||
+                   message.header.type == MessageType::SAVED_NETWORK_PRIORITY) {
+            Status decoded = decodeSavedNetworkRequest();
+            if (decoded != Status::OK) {
+                setError(decoded);
+                result = ParseResult::MESSAGE_INVALID;
+            }
+        }
+    }
+
+    message.status = result == ParseResult::MESSAGE_READY ? Status::OK : lastError;
+
+    resetParser();
+    return result;
 }
 
-CredentialData ProtocolHandler::parseCredentialWrite(const uint8_t* data, size_t length) {
-    CredentialData credentials;
+namespace {
 
-    if (!validateMessage(data, length)) {
-        return credentials;
+// Copy a decoded string view into a String (views point into the payload buffer)
+String toString(const Schema::StringRef& value) {
+    char buffer[MAX_PASSWORD_LENGTH + 1];
+    size_t length = value.length < MAX_PASSWORD_LENGTH ? value.length : MAX_PASSWORD_LENGTH;
+    memcpy(buffer, value.data, length);
+    buffer[length] = '\0';
+    return String(buffer);
+}
+
+} // namespace
+
+Status ProtocolHandler::decodeSavedNetworkRequest() {
+    SavedNetworkRequest& request = message.savedNetwork;
+    request.type = message.header.type;
+
+    Schema::StringRef ssid;
+    Schema::StringRef password;
+    bool decoded = false;
+    switch (request.type) {
+        case MessageType::SAVED_NETWORK_ADD:
+            decoded = SavedNetworkAddSchema::decode(payloadBuffer, payloadReceived, ssid, password, request.priority);
+            break;
+        case MessageType::SAVED_NETWORK_REMOVE:
+            decoded = SavedNetworkRemoveSchema::decode(payloadBuffer, payloadReceived, ssid);
+            break;
+        case MessageType::SAVED_NETWORK_PRIORITY:
+            decoded = SavedNetworkPrioritySchema::decode(payloadBuffer, payloadReceived, ssid, request.priority);
+            break;
+        default:
+            return Status::WRONG_MESSAGE_TYPE;
     }
 
-    MessageHeader header = parseHeader(data, length);
-    if (header.type != MessageType::CREDENTIAL_WRITE) {
-        setError("Not a Credential Write message");
-        return credentials;
+    if (!decoded) {
+        // Report the field that is out of range where it can be told apart
+        size_t ssidLength = payloadReceived > 0 ? payloadBuffer[0] : 0;
+        if (payloadReceived > 0 && ssidLength == 0) {
+            return Status::SSID_EMPTY;
+        }
+        if (ssidLength > MAX_SSID_LENGTH) {
+            return Status::SSID_TOO_LONG;
+        }
+        if (request.type == MessageType::SAVED_NETWORK_ADD && payloadReceived > 1 + ssidLength &&
+            payloadBuffer[1 + ssidLength] > MAX_PASSWORD_LENGTH) {
+            return Status::PASSWORD_TOO_LONG;
+        }
+        return Status::TRUNCATED_FIELD;
+    }
+
+    request.ssid = toString(ssid);
+    request.password = toString(password);
+    return Status::OK;
+}
+
+ParseResult ProtocolHandler::feed(const uint8_t* data, size_t length, size_t& outConsumed) {
+    outConsumed = 0;
+
+    // Rest of an oversized message, already reported
+    if (discardRemaining > 0) {
+        outConsumed = length < discardRemaining ? length : discardRemaining;
+        discardRemaining -= outConsumed;
+        if (outConsumed == length) {
+            return ParseResult::NEED_MORE;
+        }
     }
 
-    const uint8_t* payload = data + 4;
-    size_t payloadRemaining = header.payloadLength;
+    if (parserState == ParserState::HEADER) {
+        while (headerReceived < MESSAGE_HEADER_SIZE && outConsumed < length) {
+            headerBytes[headerReceived++] = data[outConsumed++];
+        }
+
+        if (headerReceived < MESSAGE_HEADER_SIZE) {
+            return ParseResult::NEED_MORE;
+        }
+
+        beginPayload();
+
+        if (payloadRemaining > MAX_PAYLOAD_SIZE) {
+            // Corrupt or hostile header - report it now, then skip the announced payload
+            // so its bytes are not parsed as the next header
+            failMessage(Status::MESSAGE_TOO_LONG);
+            size_t available = length - outConsumed;
+            size_t count = available < payloadRemaining ? available : payloadRemaining;
+            outConsumed += count;
+            uint16_t rest = static_cast<uint16_t>(payloadRemaining - count);
+            payloadRemaining = 0;
+
+            ParseResult result = finishMessage();
+            discardRemaining = rest;
+            return result;
+        }
+    }
 
-    // Extract SSID
-    String ssid;
-    size_t bytesRead = 0;
-    if (!extractString(payload, payloadRemaining, 32, ssid, bytesRead)) {
-        return credentials;
+    while (payloadRemaining > 0) {
+        if (outConsumed >= length) {
+            return ParseResult::NEED_MORE;
+        }
+
+        size_t available = length - outConsumed;
+
+        switch (parserState) {
+            case ParserState::SSID_LENGTH:
+                fieldLength = data[outConsumed++];
+                fieldReceived = 0;
+                payloadRemaining--;
+                if (fieldLength > MAX_SSID_LENGTH) {
+                    failMessage(Status::SSID_TOO_LONG);
+                } else if (fieldLength == 0) {
+                    failMessage(Status::SSID_EMPTY);
+                } else {
+                    parserState = ParserState::SSID_DATA;
+                }
+                break;
+
+            case ParserState::PASSWORD_LENGTH:
+                fieldLength = data[outConsumed++];
+                fieldReceived = 0;
+                payloadRemaining--;
+                if (fieldLength > MAX_PASSWORD_LENGTH) {
+                    failMessage(Status::PASSWORD_TOO_LONG);
+                } else if (fieldLength == 0) {
+                    passwordBuffer[0] = '\0';
+                    parserState = ParserState::SKIP; // Trailing bytes are ignored
+                } else {
+                    parserState = ParserState::PASSWORD_DATA;
+                }
+                break;
+
+            case ParserState::SSID_DATA:
+            case ParserState::PASSWORD_DATA: {
+                bool isSSID = parserState == ParserState::SSID_DATA;
+                char* target = isSSID ? ssidBuffer : passwordBuffer;
+
+                size_t count = fieldLength - fieldReceived;
+                if (count > available) {
+                    count = available;
+                }
+                if (count > payloadRemaining) {
+                    count = payloadRemaining;
+                }
+
+                memcpy(target + fieldReceived, data + outConsumed, count);
+                fieldReceived += count;
+                outConsumed += count;
+                payloadRemaining -= count;
+
+                if (fieldReceived == fieldLength) {
+                    target[fieldLength] = '\0';
+                    parserState = isSSID ? ParserState::PASSWORD_LENGTH : ParserState::SKIP;
+                }
+                break;
+            }
+
+            case ParserState::FIXED_PAYLOAD: {
+                if (payloadReceived >= sizeof(payloadBuffer)) {
+                    parserState = ParserState::SKIP;
+                    break;
+                }
+
+                size_t count = sizeof(payloadBuffer) - payloadReceived;
+                if (count > available) {
+                    count = available;
+                }
+                if (count > payloadRemaining) {
+                    count = payloadRemaining;
+                }
+
+                memcpy(payloadBuffer + payloadReceived, data + outConsumed, count);
+                payloadReceived += count;
+                outConsumed += count;
+                payloadRemaining -= count;
+                break;
+            }
+
+            case ParserState::SKIP:
+            default: {
+                size_t count = available < payloadRemaining ? available : payloadRemaining;
+                outConsumed += count;
+                payloadRemaining -= count;
+                break;
+            }
+        }
     }
 
-    payload += bytesRead;
-    payloadRemaining -= bytesRead;
+    return finishMessage();
+}
+
+//
+// Whole-buffer parsing (single pass through the streaming parser)
+//
 
-    // Validate SSID
-    if (ssid.length() == 0) {
-        setError("SSID cannot be empty");
-        return credentials;
+CredentialData ProtocolHandler::parseCredentialWrite(const uint8_t* data, size_t length) {
+    if (length < MESSAGE_HEADER_SIZE) {
+        setError(Status::MESSAGE_TOO_SHORT);
+        return CredentialData();
     }
 
-    // Extract Password
-    String password;
-    if (!extractString(payload, payloadRemaining, 63, password, bytesRead)) {
-        return credentials;
+    resetParser();
+    size_t consumed = 0;
+    ParseResult result = feed(data, length, consumed);
+
+    if (result == ParseResult::NEED_MORE || consumed != length) {
+        resetParser();
+        setError(Status::MESSAGE_LENGTH_MISMATCH);
+        return CredentialData();
     }
 
-    // Password can be empty for open networks
+    if (message.header.type != MessageType::CREDENTIAL_WRITE) {
+        setError(Status::WRONG_MESSAGE_TYPE);
+        return CredentialData();
+    }
 
-    credentials.ssid = ssid;
-    credentials.password = password;
-    credentials.isValid = true;
+    if (result != ParseResult::MESSAGE_READY) {
+        return CredentialData();
+    }
 
-    return credentials;
+    return message.credentials;
 }
 
 bool ProtocolHandler::parseStatusRequest(const uint8_t* data, size_t length) {
-    if (!validateMessage(data, length)) {
+    if (length < MESSAGE_HEADER_SIZE) {
+        setError(Status::MESSAGE_TOO_SHORT);
         return false;
     }
 
-    MessageHeader header = parseHeader(data, length);
-    if (header.type != MessageType::STATUS_REQUEST) {
-        setError("Not a Status Request message");
+    resetParser();
+    size_t consumed = 0;
+    ParseResult result = feed(data, length, consumed);
+
+    if (result == ParseResult::NEED_MORE || consumed != length) {
+        resetParser();
+        setError(Status::MESSAGE_LENGTH_MISMATCH);
         return false;
     }
 
-    if (header.payloadLength != 0) {
-        setError("Status Request should have no payload");
+    if (message.header.type != MessageType::STATUS_REQUEST) {
+        setError(Status::WRONG_MESSAGE_TYPE);
         return false;
     }
 
-    return true;
+    return result == ParseResult::MESSAGE_READY;
+}
+
+bool ProtocolHandler::isValidIPConfig(const IPConfigData& config) {
+    if (config.mode == IPMode::DHCP) {
+        return true;
+    }
+    if (config.mode != IPMode::STATIC) {
+        return false;
+    }
+
+    // Addresses arrive in network byte order
+    uint32_t address = (static_cast<uint32_t>(config.address[0]) << 24) | (config.address[1] << 16) |
+                       (config.address[2] << 8) | config.address[3];
+    uint32_t mask = (static_cast<uint32_t>(config.subnet[0]) << 24) | (config.subnet[1] << 16) |
+                    (config.subnet[2] << 8) | config.subnet[3];
+    uint32_t gateway = (static_cast<uint32_t>(config.gateway[0]) << 24) | (config.gateway[1] << 16) |
+                       (config.gateway[2] << 8) | config.gateway[3];
+
+    // A mask is a run of ones followed by zeros
+    uint32_t hostBits = ~mask;
+    if (mask == 0 || (hostBits & (hostBits + 1)) != 0) {
+        return false;
+    }
+
+    if (address == 0 || (address & hostBits) == 0 || (address & hostBits) == hostBits) {
+        return false; // Network or broadcast address
+    }
+
+    return gateway == 0 || (gateway & mask) == (address & mask);
 }
 
 } // namespace WiFiSet
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "MessageBuilder.h"
+#include "Status.h"
 
 namespace WiFiSet {
 
@@ -18,6 +19,54 @@ struct CredentialData {
     CredentialData(const String& s, const String& p) : ssid(s), password(p), isValid(true) {}
 };
 
+/**
+ * Parsed client HELLO (protocol version and capability advertisement)
+ */
+struct HelloData {
+    uint8_t versionMajor;
+    uint8_t versionMinor;
+    uint16_t features;  // ProtocolFeature bits supported by the client
+    uint16_t maxMTU;    // Largest ATT MTU the client will use (0 = unspecified)
+
+    HelloData() : versionMajor(0), versionMinor(0), features(0), maxMTU(0) {}
+};
+
+/**
+ * Parsed Scan Subscribe (live network list updates)
+ */
+struct ScanSubscribeData {
+    bool enabled;
+    uint8_t rssiThreshold;  // Minimum RSSI change in dB to report (0 = device default)
+
+    ScanSubscribeData() : enabled(false), rssiThreshold(0) {}
+};
+
+/**
+ * Parsed IP Config Write (how the device gets its address)
+ */
+struct IPConfigData {
+    IPMode mode;
+    IPAddress address;  // STATIC only (as are the fields below)
+    IPAddress subnet;
+    IPAddress gateway;  // 0.0.0.0 = none
+    IPAddress dns1;     // 0.0.0.0 = use the gateway
+    IPAddress dns2;     // 0.0.0.0 = none
+
+    IPConfigData() : mode(IPMode::DHCP) {}
+};
+
+/**
+ * Parsed Saved Network request (add, remove, priority or list)
+ */
+struct SavedNetworkRequest {
+    MessageType type;   // SAVED_NETWORK_ADD, _REMOVE, _PRIORITY or _LIST_REQUEST
+    String ssid;        // All but _LIST_REQUEST
+    String password;    // _ADD only
+    uint8_t priority;   // _ADD and _PRIORITY (higher is tried first)
+
+    SavedNetworkRequest() : type(MessageType::SAVED_NETWORK_LIST_REQUEST), priority(0) {}
+};
+
 /**
  * Message header information
  */
@@ -30,14 +79,50 @@ struct MessageHeader {
     MessageHeader() : type(MessageType::ERROR), sequence(0), payloadLength(0), isValid(false) {}
 };
 
+/**
+ * Result of feeding bytes to the streaming parser
+ */
+enum class ParseResult {
+    NEED_MORE,          // Message incomplete, feed more bytes
+    MESSAGE_READY,      // A complete, valid message is available via getMessage()
+    MESSAGE_INVALID     // A complete message was received but failed validation (see ParsedMessage::status)
+};
+
+/**
+ * Message produced by the streaming parser
+ */
+struct ParsedMessage {
+    MessageHeader header;
+    CredentialData credentials; // Valid for CREDENTIAL_WRITE
+    HelloData hello;            // Valid for HELLO
+    ScanSubscribeData subscribe; // Valid for SCAN_SUBSCRIBE
+    IPConfigData ipConfig;      // Valid for IP_CONFIG_WRITE
+    SavedNetworkRequest savedNetwork; // Valid for the SAVED_NETWORK_* requests
+    Status status;              // Status::OK, or why the message was rejected
+
+    ParsedMessage() : status(Status::OK) {}
+};
+
 /**
  * ProtocolHandler - Parses binary protocol messages
  *
  * Handles decoding of messages received from iOS client according to
  * the WiFiSet protocol specification.
+ *
+ * Messages can be parsed either from a complete buffer (parseCredentialWrite,
+ * parseStatusRequest) or incrementally with feed(), which accepts arbitrary
+ * chunks (BLE write fragments, serial bytes, replayed captures) and decodes
+ * each byte exactly once using fixed-size buffers.
  */
 class ProtocolHandler {
 public:
+    // Largest payload accepted by feed(); longer messages are rejected and skipped
+    static const size_t MAX_PAYLOAD_SIZE =
+        Schema::Max<CredentialWriteSchema::maxPayloadSize, HelloSchema::maxPayloadSize,
+                    ScanSubscribeSchema::maxPayloadSize, IPConfigWriteSchema::maxPayloadSize,
+                    SavedNetworkAddSchema::maxPayloadSize, SavedNetworkRemoveSchema::maxPayloadSize,
+                    SavedNetworkPrioritySchema::maxPayloadSize>::value;
+
     ProtocolHandler();
 
     /**
@@ -51,6 +136,7 @@ public:
     /**
      * Parse Credential Write message
      * Extracts SSID and password from the message
+     * Resets the streaming parser (do not mix with an in-progress feed())
      * @param data Raw message data (including header)
      * @param length Length of data
      * @return Parsed credential data
@@ -59,6 +145,7 @@ public:
 
     /**
      * Parse Status Request message
+     * Resets the streaming parser (do not mix with an in-progress feed())
      * @param data Raw message data (including header)
      * @param length Length of data
      * @return true if valid status request, false otherwise
@@ -75,28 +162,111 @@ public:
     bool validateMessage(const uint8_t* data, size_t length);
 
     /**
-     * Get last error message
+     * Feed bytes to the streaming parser
+     * Consumes bytes up to the end of the current message; feed the
+     * remaining bytes again to parse the next message. A header announcing
+     * more than MAX_PAYLOAD_SIZE bytes fails with Status::MESSAGE_TOO_LONG
+     * at once; the announced payload is then discarded as it arrives, and
+     * parsing resumes at the message after it.
+     * @param data Incoming bytes (any chunk size)
+     * @param length Number of bytes
+     * @param outConsumed Number of bytes consumed
+     * @return Parser result for the current message
+     */
+    ParseResult feed(const uint8_t* data, size_t length, size_t& outConsumed);
+
+    /**
+     * Get the last message completed by feed()
+     * Valid after MESSAGE_READY until the next call to feed()
      */
-    const String& getLastError() const { return lastError; }
+    const ParsedMessage& getMessage() const { return message; }
+
+    /**
+     * Discard any partially parsed message
+     */
+    void resetParser();
+
+    /**
+     * Check if the streaming parser is in the middle of a message
+     */
+    bool isParsing() const {
+        return parserState != ParserState::HEADER || headerReceived > 0 || discardRemaining > 0;
+    }
+
+    /**
+     * Get the status of the last failed operation
+     */
+    Status getLastError() const { return lastError; }
 
 private:
-    String lastError;
+    /**
+     * Streaming parser states
+     */
+    enum class ParserState : uint8_t {
+        HEADER,          // Collecting the 4-byte header
+        SSID_LENGTH,     // Credential Write: SSID length byte
+        SSID_DATA,       // Credential Write: SSID bytes
+        PASSWORD_LENGTH, // Credential Write: password length byte
+        PASSWORD_DATA,   // Credential Write: password bytes
+        FIXED_PAYLOAD,   // Small fixed-layout payload collected for schema decoding
+        SKIP             // Discarding the rest of the payload
+    };
+
+    // Largest payload collected in FIXED_PAYLOAD state
+    static const size_t MAX_FIXED_PAYLOAD_SIZE =
+        Schema::Max<HelloSchema::maxPayloadSize, ScanSubscribeSchema::maxPayloadSize,
+                    IPConfigWriteSchema::maxPayloadSize, SavedNetworkAddSchema::maxPayloadSize,
+                    SavedNetworkRemoveSchema::maxPayloadSize, SavedNetworkPrioritySchema::maxPayloadSize>::value;
+    static_assert(MAX_FIXED_PAYLOAD_SIZE <= 0xFF, "Fixed payload length must fit payloadReceived");
+
+    Status lastError;
+
+    // Streaming parser state
+    ParserState parserState;
+    uint8_t headerBytes[MESSAGE_HEADER_SIZE];
+    uint8_t headerReceived;
+    uint16_t payloadRemaining;
+    uint16_t discardRemaining;   // Payload of a rejected oversized message still to skip
+    uint8_t fieldLength;
+    uint8_t fieldReceived;
+    char ssidBuffer[MAX_SSID_LENGTH + 1];
+    char passwordBuffer[MAX_PASSWORD_LENGTH + 1];
+    uint8_t payloadBuffer[MAX_FIXED_PAYLOAD_SIZE];
+    uint8_t payloadReceived;
+    bool messageFailed;
+    ParsedMessage message;
+
+    /**
+     * Called once the header is complete - selects the payload state
+     */
+    void beginPayload();
+
+    /**
+     * Called when the payload is exhausted - builds the parsed message
+     */
+    ParseResult finishMessage();
+
+    /**
+     * Decode a Saved Network request from payloadBuffer into message.savedNetwork
+     * @return Status::OK, or why the payload was rejected
+     */
+    Status decodeSavedNetworkRequest();
+
+    /**
+     * Record a validation failure and skip the rest of the payload
+     */
+    void failMessage(Status error);
 
     /**
-     * Set error message
+     * Record the last error
      */
-    void setError(const String& error);
+    void setError(Status error);
 
     /**
-     * Extract string from message data
-     * @param data Pointer to start of string length byte
-     * @param maxLength Maximum allowed string length
-     * @param outString Output string
-     * @param outBytesRead Number of bytes read (including length byte)
-     * @return true if successful
+     * Check a decoded IP Config Write (known mode; static: address set,
+     * contiguous subnet mask, gateway inside the subnet)
      */
-    bool extractString(const uint8_t* data, size_t available, uint8_t maxLength,
-                      String& outString, size_t& outBytesRead);
+    static bool isValidIPConfig(const IPConfigData& config);
 };
 
 } // namespace WiFiSet
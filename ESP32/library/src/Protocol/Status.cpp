@@ -0,0 +1,122 @@
+#include "Status.h"
+
+namespace WiFiSet {
+
+const char* statusMessage(Status status) {
+    switch (status) {
+        case Status::OK:                      return "OK";
+        case Status::MESSAGE_TOO_SHORT:       return "Message too short";
+        case Status::MESSAGE_LENGTH_MISMATCH: return "Message length mismatch";
+        case Status::WRONG_MESSAGE_TYPE:      return "Unexpected message type";
+        case Status::UNKNOWN_MESSAGE_TYPE:    return "Unknown message type";
+        case Status::UNEXPECTED_PAYLOAD:      return "Message should have no payload";
+        case Status::TRUNCATED_FIELD:         return "Payload ended inside a field";
+        case Status::SSID_EMPTY:              return "SSID cannot be empty";
+        case Status::SSID_TOO_LONG:           return "SSID exceeds 32 bytes";
+        case Status::PASSWORD_TOO_LONG:       return "Password exceeds 63 bytes";
+        case Status::UNSUPPORTED_VERSION:     return "Unsupported protocol version";
+        case Status::INVALID_IP_CONFIG:       return "Invalid static IP configuration";
+        case Status::MESSAGE_TOO_LONG:        return "Payload longer than any request";
+        case Status::STORAGE_NOT_INITIALIZED: return "NVS not initialized";
+        case Status::STORAGE_OPEN_FAILED:     return "Failed to open NVS";
+        case Status::STORAGE_WRITE_FAILED:    return "Failed to write credentials to NVS";
+        case Status::STORAGE_CLEAR_FAILED:    return "Failed to clear credentials from NVS";
+        case Status::NO_STORED_CREDENTIALS:   return "No credentials stored";
+        case Status::NO_STORED_LOCATION:      return "No AP location stored";
+        case Status::NO_STORED_PMK:           return "No PMK stored";
+        case Status::NO_STORED_IP_CONFIG:     return "No IP configuration stored";
+        case Status::NO_STORED_LEASE:         return "No DHCP lease stored";
+        case Status::NETWORK_TABLE_FULL:      return "No room for another saved network";
+        case Status::NETWORK_NOT_STORED:      return "Network is not saved";
+        case Status::SCAN_FAILED:             return "WiFi scan failed";
+        case Status::CONNECT_TIMEOUT:         return "Connection timeout";
+        case Status::CONNECT_FAILED:          return "Connection failed - wrong password or network issue";
+        case Status::NETWORK_NOT_FOUND:       return "Network not found";
+    }
+    return "Unknown error";
+}
+
+ErrorCode toErrorCode(Status status) {
+    switch (status) {
+        case Status::UNKNOWN_MESSAGE_TYPE:
+            return ErrorCode::UNKNOWN_MESSAGE_TYPE;
+        case Status::SSID_EMPTY:
+        case Status::SSID_TOO_LONG:
+        case Status::PASSWORD_TOO_LONG:
+            return ErrorCode::CREDENTIAL_WRITE_FAILED;
+        case Status::STORAGE_NOT_INITIALIZED:
+        case Status::STORAGE_OPEN_FAILED:
+        case Status::STORAGE_WRITE_FAILED:
+        case Status::STORAGE_CLEAR_FAILED:
+        case Status::NO_STORED_CREDENTIALS:
+        case Status::NO_STORED_LOCATION:
+        case Status::NO_STORED_PMK:
+        case Status::NO_STORED_IP_CONFIG:
+        case Status::NO_STORED_LEASE:
+        case Status::NETWORK_TABLE_FULL:
+        case Status::NETWORK_NOT_STORED:
+            return ErrorCode::STORAGE_ERROR;
+        case Status::SCAN_FAILED:
+            return ErrorCode::SCAN_FAILED;
+        case Status::CONNECT_TIMEOUT:
+        case Status::CONNECT_FAILED:
+        case Status::NETWORK_NOT_FOUND:
+            return ErrorCode::CONNECTION_TIMEOUT;
+        default:
+            return ErrorCode::INVALID_MESSAGE_FORMAT;
+    }
+}
+
+uint8_t toCredentialAckStatus(Status status) {
+    switch (status) {
+        case Status::OK:
+            return CredentialAckStatus::SUCCESS;
+        case Status::PASSWORD_TOO_LONG:
+            return CredentialAckStatus::INVALID_PASSWORD;
+        case Status::STORAGE_NOT_INITIALIZED:
+        case Status::STORAGE_OPEN_FAILED:
+        case Status::STORAGE_WRITE_FAILED:
+        case Status::STORAGE_CLEAR_FAILED:
+        case Status::NO_STORED_CREDENTIALS:
+            return CredentialAckStatus::STORAGE_FAILURE;
+        default:
+            return CredentialAckStatus::INVALID_SSID;
+    }
+}
+
+uint8_t toIPConfigAckStatus(Status status) {
+    switch (status) {
+        case Status::OK:
+            return IPConfigAckStatus::SUCCESS;
+        case Status::STORAGE_NOT_INITIALIZED:
+        case Status::STORAGE_OPEN_FAILED:
+        case Status::STORAGE_WRITE_FAILED:
+        case Status::STORAGE_CLEAR_FAILED:
+            return IPConfigAckStatus::STORAGE_FAILURE;
+        default:
+            return IPConfigAckStatus::INVALID_CONFIG;
+    }
+}
+
+uint8_t toSavedNetworkAckStatus(Status status) {
+    switch (status) {
+        case Status::OK:
+            return SavedNetworkAckStatus::SUCCESS;
+        case Status::PASSWORD_TOO_LONG:
+            return SavedNetworkAckStatus::INVALID_PASSWORD;
+        case Status::STORAGE_NOT_INITIALIZED:
+        case Status::STORAGE_OPEN_FAILED:
+        case Status::STORAGE_WRITE_FAILED:
+        case Status::STORAGE_CLEAR_FAILED:
+        case Status::NO_STORED_CREDENTIALS:
+            return SavedNetworkAckStatus::STORAGE_FAILURE;
+        case Status::NETWORK_NOT_STORED:
+            return SavedNetworkAckStatus::NOT_FOUND;
+        case Status::NETWORK_TABLE_FULL:
+            return SavedNetworkAckStatus::TABLE_FULL;
+        default:
+            return SavedNetworkAckStatus::INVALID_SSID;
+    }
+}
+
+} // namespace WiFiSet
@@ -0,0 +1,80 @@
+#ifndef STATUS_H
+#define STATUS_H
+
+#include <stdint.h>
+#include "MessageTypes.h"
+
+namespace WiFiSet {
+
+/**
+ * Status codes returned by parse, storage and WiFi operations
+ *
+ * A single byte, so failures are reported without building strings.
+ * Values are grouped by subsystem; use statusMessage() for a readable
+ * description and toErrorCode() / the to*AckStatus() helpers for the wire.
+ */
+enum class Status : uint8_t {
+    OK = 0x00,
+
+    // Protocol parsing
+    MESSAGE_TOO_SHORT = 0x10,
+    MESSAGE_LENGTH_MISMATCH = 0x11,
+    WRONG_MESSAGE_TYPE = 0x12,
+    UNKNOWN_MESSAGE_TYPE = 0x13,
+    UNEXPECTED_PAYLOAD = 0x14,
+    TRUNCATED_FIELD = 0x15,
+    SSID_EMPTY = 0x16,
+    SSID_TOO_LONG = 0x17,
+    PASSWORD_TOO_LONG = 0x18,
+    UNSUPPORTED_VERSION = 0x19,
+    INVALID_IP_CONFIG = 0x1A,
+    MESSAGE_TOO_LONG = 0x1B,
+
+    // Storage
+    STORAGE_NOT_INITIALIZED = 0x30,
+    STORAGE_OPEN_FAILED = 0x31,
+    STORAGE_WRITE_FAILED = 0x32,
+    STORAGE_CLEAR_FAILED = 0x33,
+    NO_STORED_CREDENTIALS = 0x34,
+    NO_STORED_LOCATION = 0x35,
+    NO_STORED_PMK = 0x36,
+    NO_STORED_IP_CONFIG = 0x37,
+    NO_STORED_LEASE = 0x38,
+    NETWORK_TABLE_FULL = 0x39,
+    NETWORK_NOT_STORED = 0x3A,
+
+    // WiFi
+    SCAN_FAILED = 0x50,
+    CONNECT_TIMEOUT = 0x51,
+    CONNECT_FAILED = 0x52,
+    NETWORK_NOT_FOUND = 0x53
+};
+
+/**
+ * Human-readable description (static string, never allocates)
+ */
+const char* statusMessage(Status status);
+
+/**
+ * Protocol error code to report for a failure
+ */
+ErrorCode toErrorCode(Status status);
+
+/**
+ * Credential Write ACK status byte for a failure (see CredentialAckStatus)
+ */
+uint8_t toCredentialAckStatus(Status status);
+
+/**
+ * IP Config ACK status byte for a failure (see IPConfigAckStatus)
+ */
+uint8_t toIPConfigAckStatus(Status status);
+
+/**
+ * Saved Network ACK status byte for a failure (see SavedNetworkAckStatus)
+ */
+uint8_t toSavedNetworkAckStatus(Status status);
+
+} // namespace WiFiSet
+
+#endif // STATUS_H
@@ -1,12 +1,32 @@
 #include "NVSManager.h"
+#include <algorithm>
 
 namespace WiFiSet {
 
 const char* NVSManager::NAMESPACE = "wifiset";
 const char* NVSManager::KEY_SSID = "ssid";
 const char* NVSManager::KEY_PASSWORD = "password";
+const char* NVSManager::KEY_BSSID = "bssid";
+const char* NVSManager::KEY_CHANNEL = "channel";
+const char* NVSManager::KEY_AUTH_MODE = "auth";
+const char* NVSManager::KEY_PMK = "pmk";
+const char* NVSManager::KEY_IP_CONFIG = "ipconfig";
+const char* NVSManager::KEY_LEASE = "lease";
+const char* NVSManager::KEY_NETWORK_STAMP = "netstamp";
+
+namespace {
+
+// Saved network order: highest priority first, then most recently connected
+bool isPreferred(const StoredNetwork& a, const StoredNetwork& b) {
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    return a.lastSuccess > b.lastSuccess;
+}
+
+} // namespace
 
-NVSManager::NVSManager() : initialized(false), lastError("") {}
+NVSManager::NVSManager() : initialized(false), networksLoaded(false) {}
 
 NVSManager::~NVSManager() {
     if (initialized) {
@@ -14,73 +34,125 @@ NVSManager::~NVSManager() {
     }
 }
 
-void NVSManager::setError(const String& error) {
-    lastError = error;
-}
-
 bool NVSManager::begin() {
     if (initialized) {
         return true;
     }
 
     initialized = true;
+
+    // Credentials saved before the table existed become its first entry
+    if (preferences.begin(NAMESPACE, false)) {
+        migrateCredentials();
+        preferences.end();
+    }
+
     return true;
 }
 
-bool NVSManager::saveCredentials(const String& ssid, const String& password) {
-    if (!initialized) {
-        setError("NVS not initialized");
-        return false;
+void NVSManager::migrateCredentials() {
+    String ssid = preferences.getString(KEY_SSID, "");
+    if (ssid.length() == 0) {
+        return;
     }
 
-    // Validate input
-    if (ssid.length() == 0 || ssid.length() > 32) {
-        setError("Invalid SSID length");
-        return false;
+    StoredNetwork network;
+    if (findNetwork(ssid, network) >= 0) {
+        return;
     }
 
-    if (password.length() > 63) {
-        setError("Invalid password length");
-        return false;
+    int slot = findFreeSlot();
+    if (slot < 0) {
+        return;
+    }
+
+    network = StoredNetwork();
+    network.setCredentials(ssid, preferences.getString(KEY_PASSWORD, ""));
+    writeNetwork(slot, network);
+}
+
+Status NVSManager::validateCredentials(const String& ssid, const String& password) {
+    if (ssid.length() == 0) {
+        return Status::SSID_EMPTY;
+    }
+
+    if (ssid.length() > MAX_SSID_LENGTH) {
+        return Status::SSID_TOO_LONG;
+    }
+
+    if (password.length() > MAX_PASSWORD_LENGTH) {
+        return Status::PASSWORD_TOO_LONG;
+    }
+
+    return Status::OK;
+}
+
+Status NVSManager::saveCredentials(const String& ssid, const String& password) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Validate input
+    Status valid = validateCredentials(ssid, password);
+    if (valid != Status::OK) {
+        return valid;
     }
 
     // Open preferences for writing
     if (!preferences.begin(NAMESPACE, false)) {
-        setError("Failed to open NVS for writing");
-        return false;
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    // A location found for another network would only slow the next boot down
+    if (preferences.getString(KEY_SSID, "") != ssid) {
+        removeLocationKeys();
+        preferences.remove(KEY_PMK);
+        preferences.remove(KEY_LEASE);
+    } else if (preferences.getString(KEY_PASSWORD, "") != password) {
+        // The PMK is derived from the password
+        preferences.remove(KEY_PMK);
     }
 
     // Save credentials
     size_t ssidWritten = preferences.putString(KEY_SSID, ssid);
     size_t passwordWritten = preferences.putString(KEY_PASSWORD, password);
 
-    preferences.end();
-
-    if (ssidWritten == 0) {
-        setError("Failed to write SSID to NVS");
-        return false;
+    // Keep the table entry in step; a new network may push out the least preferred one
+    StoredNetwork network;
+    int slot = findNetwork(ssid, network);
+    bool tableWritten = true;
+    if (slot < 0 || strcmp(network.password, password.c_str()) != 0) {
+        if (slot < 0) {
+            slot = findFreeSlot();
+            if (slot < 0) {
+                slot = findLeastPreferred();
+            }
+            network = StoredNetwork();
+        }
+        network.setCredentials(ssid, password);
+        network.failureCount = 0;
+        tableWritten = writeNetwork(slot, network);
     }
 
-    if (password.length() > 0 && passwordWritten == 0) {
-        setError("Failed to write password to NVS");
-        return false;
+    preferences.end();
+
+    if (ssidWritten == 0 || (password.length() > 0 && passwordWritten == 0) || !tableWritten) {
+        return Status::STORAGE_WRITE_FAILED;
     }
 
-    return true;
+    return Status::OK;
 }
 
-StoredCredentials NVSManager::loadCredentials() {
-    StoredCredentials credentials;
+Status NVSManager::loadCredentials(StoredCredentials& outCredentials) {
+    outCredentials = StoredCredentials();
 
     if (!initialized) {
-        setError("NVS not initialized");
-        return credentials;
+        return Status::STORAGE_NOT_INITIALIZED;
     }
 
     // Open preferences for reading
     if (!preferences.begin(NAMESPACE, true)) {
-        setError("Failed to open NVS for reading");
-        return credentials;
+        return Status::STORAGE_OPEN_FAILED;
     }
 
     // Load credentials
@@ -91,15 +163,14 @@ StoredCredentials NVSManager::loadCredentials() {
 
     // Validate loaded data
     if (ssid.length() == 0) {
-        setError("No credentials stored");
-        return credentials;
+        return Status::NO_STORED_CREDENTIALS;
     }
 
-    credentials.ssid = ssid;
-    credentials.password = password;
-    credentials.isValid = true;
+    outCredentials.ssid = ssid;
+    outCredentials.password = password;
+    outCredentials.isValid = true;
 
-    return credentials;
+    return Status::OK;
 }
 
 bool NVSManager::hasCredentials() {
@@ -113,35 +184,662 @@ bool NVSManager::hasCredentials() {
     }
 
     bool exists = preferences.isKey(KEY_SSID);
+    char key[8];
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS && !exists; slot++) {
+        networkKey(slot, key);
+        exists = preferences.isKey(key);
+    }
 
     preferences.end();
 
     return exists;
 }
 
-bool NVSManager::clearCredentials() {
+Status NVSManager::saveNetwork(const String& ssid, const String& password, uint8_t priority) {
     if (!initialized) {
-        setError("NVS not initialized");
-        return false;
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    Status valid = validateCredentials(ssid, password);
+    if (valid != Status::OK) {
+        return valid;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    StoredNetwork network;
+    int slot = findNetwork(ssid, network);
+    if (slot < 0) {
+        slot = findFreeSlot();
+        if (slot < 0) {
+            preferences.end();
+            return Status::NETWORK_TABLE_FULL;
+        }
+        network = StoredNetwork();
+    }
+
+    bool passwordChanged = strcmp(network.password, password.c_str()) != 0;
+    if (passwordChanged) {
+        network.failureCount = 0;
+    }
+    network.setCredentials(ssid, password);
+    network.priority = priority;
+    bool success = writeNetwork(slot, network);
+
+    // A new password for the current network replaces the one used at boot;
+    // with no current network (the table was empty) this one becomes it
+    String current = preferences.getString(KEY_SSID, "");
+    if (success && current.length() == 0) {
+        success = writeCurrentNetwork(network);
+    } else if (success && passwordChanged && current == ssid) {
+        size_t passwordWritten = preferences.putString(KEY_PASSWORD, password);
+        success = password.length() == 0 || passwordWritten > 0;
+        preferences.remove(KEY_PMK);
+    }
+
+    preferences.end();
+
+    return success ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::removeNetwork(const String& ssid) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    StoredNetwork network;
+    int slot = findNetwork(ssid, network);
+    if (slot < 0) {
+        preferences.end();
+        return Status::NETWORK_NOT_STORED;
+    }
+
+    char key[8];
+    networkKey(slot, key);
+    bool success = preferences.remove(key);
+    if (success) {
+        networks[slot] = StoredNetwork();
+    }
+
+    // The location, PMK and lease all belong to the current network; the
+    // most preferred network left takes its place, so boot still has one to join
+    bool promoted = true;
+    if (success && preferences.getString(KEY_SSID, "") == ssid) {
+        preferences.remove(KEY_SSID);
+        preferences.remove(KEY_PASSWORD);
+        removeLocationKeys();
+        preferences.remove(KEY_PMK);
+        preferences.remove(KEY_LEASE);
+
+        int next = findMostPreferred();
+        if (next >= 0) {
+            promoted = writeCurrentNetwork(networks[next]);
+        }
+    }
+
+    preferences.end();
+
+    if (!success) {
+        return Status::STORAGE_CLEAR_FAILED;
+    }
+    return promoted ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::setNetworkPriority(const String& ssid, uint8_t priority) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
     }
 
     // Open preferences for writing
     if (!preferences.begin(NAMESPACE, false)) {
-        setError("Failed to open NVS for writing");
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    StoredNetwork network;
+    int slot = findNetwork(ssid, network);
+    if (slot < 0) {
+        preferences.end();
+        return Status::NETWORK_NOT_STORED;
+    }
+
+    bool success = true;
+    if (network.priority != priority) {
+        network.priority = priority;
+        success = writeNetwork(slot, network);
+    }
+
+    preferences.end();
+
+    return success ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::loadNetworks(StoredNetworkList& outNetworks) {
+    outNetworks.clear();
+
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for reading
+    if (!preferences.begin(NAMESPACE, true)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    loadNetworkTable();
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS; slot++) {
+        if (networks[slot].isValid) {
+            outNetworks.push_back(networks[slot]);
+        }
+    }
+
+    preferences.end();
+
+    if (outNetworks.empty()) {
+        return Status::NO_STORED_CREDENTIALS;
+    }
+
+    std::sort(outNetworks.begin(), outNetworks.end(), isPreferred);
+    return Status::OK;
+}
+
+Status NVSManager::recordConnectResult(const String& ssid, bool success) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    StoredNetwork network;
+    int slot = findNetwork(ssid, network);
+    if (slot < 0) {
+        preferences.end();
+        return Status::NETWORK_NOT_STORED;
+    }
+
+    bool written = true;
+    if (success) {
+        // Reconnecting to the most recent network changes nothing
+        uint32_t stamp = preferences.getUInt(KEY_NETWORK_STAMP, 0);
+        if (network.failureCount != 0 || network.lastSuccess != stamp || stamp == 0) {
+            stamp++;
+            network.lastSuccess = stamp;
+            network.failureCount = 0;
+            written = preferences.putUInt(KEY_NETWORK_STAMP, stamp) == sizeof(stamp) &&
+                      writeNetwork(slot, network);
+        }
+    } else if (network.failureCount < 255) {
+        network.failureCount++;
+        if (network.failureCount <= MAX_STORED_FAILURES) {
+            written = writeNetwork(slot, network);
+        } else {
+            networks[slot].failureCount = network.failureCount;
+        }
+    }
+
+    preferences.end();
+
+    return written ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+void NVSManager::networkKey(size_t slot, char* key) {
+    snprintf(key, 8, "net%u", static_cast<uint8_t>(slot));
+}
+
+bool NVSManager::readNetwork(size_t slot, StoredNetwork& outNetwork) {
+    outNetwork = StoredNetwork();
+
+    char key[8];
+    networkKey(slot, key);
+    uint8_t blob[NETWORK_BLOB_SIZE];
+    if (preferences.getBytes(key, blob, sizeof(blob)) != sizeof(blob)) {
         return false;
     }
 
+    size_t ssidLength = blob[6];
+    size_t passwordLength = blob[7 + MAX_SSID_LENGTH];
+    if (ssidLength == 0 || ssidLength > MAX_SSID_LENGTH || passwordLength > MAX_PASSWORD_LENGTH) {
+        return false;
+    }
+
+    outNetwork.priority = blob[0];
+    outNetwork.failureCount = blob[1];
+    outNetwork.lastSuccess = readU32(blob + 2);
+    memcpy(outNetwork.ssid, blob + 7, ssidLength);
+    outNetwork.ssid[ssidLength] = '\0';
+    memcpy(outNetwork.password, blob + 8 + MAX_SSID_LENGTH, passwordLength);
+    outNetwork.password[passwordLength] = '\0';
+    outNetwork.isValid = true;
+    return true;
+}
+
+bool NVSManager::writeNetwork(size_t slot, const StoredNetwork& network) {
+    // Fixed layout: unused string bytes are zero
+    uint8_t blob[NETWORK_BLOB_SIZE];
+    memset(blob, 0, sizeof(blob));
+
+    size_t ssidLength = strlen(network.ssid);
+    size_t passwordLength = strlen(network.password);
+    blob[0] = network.priority;
+    blob[1] = network.failureCount;
+    writeU32(blob + 2, network.lastSuccess);
+    blob[6] = static_cast<uint8_t>(ssidLength);
+    memcpy(blob + 7, network.ssid, ssidLength);
+    blob[7 + MAX_SSID_LENGTH] = static_cast<uint8_t>(passwordLength);
+    memcpy(blob + 8 + MAX_SSID_LENGTH, network.password, passwordLength);
+
+    char key[8];
+    networkKey(slot, key);
+    if (preferences.putBytes(key, blob, sizeof(blob)) != sizeof(blob)) {
+        return false;
+    }
+
+    networks[slot] = network;
+    networks[slot].isValid = true;
+    return true;
+}
+
+void NVSManager::loadNetworkTable() {
+    if (networksLoaded) {
+        return;
+    }
+
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS; slot++) {
+        readNetwork(slot, networks[slot]);
+    }
+    networksLoaded = true;
+}
+
+int NVSManager::findNetwork(const String& ssid, StoredNetwork& outNetwork) {
+    loadNetworkTable();
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS; slot++) {
+        if (networks[slot].isValid && ssid == networks[slot].ssid) {
+            outNetwork = networks[slot];
+            return static_cast<int>(slot);
+        }
+    }
+    outNetwork = StoredNetwork();
+    return -1;
+}
+
+int NVSManager::findFreeSlot() {
+    // An unreadable entry counts as free: findLeastPreferred() would reuse it anyway
+    loadNetworkTable();
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS; slot++) {
+        if (!networks[slot].isValid) {
+            return static_cast<int>(slot);
+        }
+    }
+    return -1;
+}
+
+int NVSManager::findMostPreferred() {
+    loadNetworkTable();
+    int best = -1;
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS; slot++) {
+        if (networks[slot].isValid && (best < 0 || isPreferred(networks[slot], networks[best]))) {
+            best = static_cast<int>(slot);
+        }
+    }
+    return best;
+}
+
+bool NVSManager::writeCurrentNetwork(const StoredNetwork& network) {
+    size_t ssidWritten = preferences.putString(KEY_SSID, network.ssid);
+    size_t passwordWritten = preferences.putString(KEY_PASSWORD, network.password);
+    return ssidWritten > 0 && (network.password[0] == '\0' || passwordWritten > 0);
+}
+
+int NVSManager::findLeastPreferred() {
+    loadNetworkTable();
+    int worst = -1;
+    for (size_t slot = 0; slot < MAX_STORED_NETWORKS; slot++) {
+        const StoredNetwork& network = networks[slot];
+        if (!network.isValid) {
+            return static_cast<int>(slot); // Unreadable entry: reuse its slot
+        }
+        if (worst < 0) {
+            worst = static_cast<int>(slot);
+            continue;
+        }
+        const StoredNetwork& worstNetwork = networks[worst];
+        bool worse = network.priority < worstNetwork.priority ||
+                     (network.priority == worstNetwork.priority &&
+                      (network.failureCount > worstNetwork.failureCount ||
+                       (network.failureCount == worstNetwork.failureCount &&
+                        network.lastSuccess < worstNetwork.lastSuccess)));
+        if (worse) {
+            worst = static_cast<int>(slot);
+        }
+    }
+    return worst;
+}
+
+Status NVSManager::saveLocation(const StoredLocation& location) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    // Skip the flash write when reconnecting to the same AP
+    uint8_t storedBssid[sizeof(location.bssid)];
+    bool unchanged = preferences.getBytes(KEY_BSSID, storedBssid, sizeof(storedBssid)) == sizeof(storedBssid) &&
+                     memcmp(storedBssid, location.bssid, sizeof(storedBssid)) == 0 &&
+                     preferences.getUChar(KEY_CHANNEL, 0) == location.channel &&
+                     preferences.getUChar(KEY_AUTH_MODE, 0xFF) == location.authMode;
+
+    bool success = true;
+    if (!unchanged) {
+        success = preferences.putBytes(KEY_BSSID, location.bssid, sizeof(location.bssid)) == sizeof(location.bssid) &&
+                  preferences.putUChar(KEY_CHANNEL, location.channel) == 1 &&
+                  preferences.putUChar(KEY_AUTH_MODE, location.authMode) == 1;
+    }
+
+    preferences.end();
+
+    return success ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::loadLocation(StoredLocation& outLocation) {
+    outLocation = StoredLocation();
+
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for reading
+    if (!preferences.begin(NAMESPACE, true)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    size_t bssidLength = preferences.getBytes(KEY_BSSID, outLocation.bssid, sizeof(outLocation.bssid));
+    outLocation.channel = preferences.getUChar(KEY_CHANNEL, 0);
+    outLocation.authMode = preferences.getUChar(KEY_AUTH_MODE, 0);
+
+    preferences.end();
+
+    if (bssidLength != sizeof(outLocation.bssid) || outLocation.channel == 0) {
+        outLocation = StoredLocation();
+        return Status::NO_STORED_LOCATION;
+    }
+
+    outLocation.isValid = true;
+    return Status::OK;
+}
+
+Status NVSManager::clearLocation() {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    removeLocationKeys();
+
+    preferences.end();
+
+    return Status::OK;
+}
+
+void NVSManager::removeLocationKeys() {
+    // remove() fails for keys that don't exist, which is fine here
+    preferences.remove(KEY_BSSID);
+    preferences.remove(KEY_CHANNEL);
+    preferences.remove(KEY_AUTH_MODE);
+}
+
+Status NVSManager::savePMK(const StoredPMK& pmk) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    size_t written = preferences.putBytes(KEY_PMK, pmk.key, sizeof(pmk.key));
+
+    preferences.end();
+
+    return written == sizeof(pmk.key) ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::loadPMK(StoredPMK& outPMK) {
+    outPMK = StoredPMK();
+
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for reading
+    if (!preferences.begin(NAMESPACE, true)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    size_t length = preferences.getBytes(KEY_PMK, outPMK.key, sizeof(outPMK.key));
+
+    preferences.end();
+
+    if (length != sizeof(outPMK.key)) {
+        outPMK = StoredPMK();
+        return Status::NO_STORED_PMK;
+    }
+
+    outPMK.isValid = true;
+    return Status::OK;
+}
+
+Status NVSManager::clearPMK() {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    // remove() fails if no PMK is stored, which is fine here
+    preferences.remove(KEY_PMK);
+
+    preferences.end();
+
+    return Status::OK;
+}
+
+Status NVSManager::saveIPConfig(const StoredIPConfig& config) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    uint8_t blob[IP_CONFIG_BLOB_SIZE];
+    blob[0] = config.isStatic ? 1 : 0;
+    writeAddress(blob + 1, config.address);
+    writeAddress(blob + 5, config.subnet);
+    writeAddress(blob + 9, config.gateway);
+    writeAddress(blob + 13, config.dns1);
+    writeAddress(blob + 17, config.dns2);
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    size_t written = preferences.putBytes(KEY_IP_CONFIG, blob, sizeof(blob));
+
+    preferences.end();
+
+    return written == sizeof(blob) ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::loadIPConfig(StoredIPConfig& outConfig) {
+    outConfig = StoredIPConfig();
+
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for reading
+    if (!preferences.begin(NAMESPACE, true)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    uint8_t blob[IP_CONFIG_BLOB_SIZE];
+    size_t length = preferences.getBytes(KEY_IP_CONFIG, blob, sizeof(blob));
+
+    preferences.end();
+
+    if (length != sizeof(blob)) {
+        return Status::NO_STORED_IP_CONFIG;
+    }
+
+    outConfig.isStatic = blob[0] != 0;
+    outConfig.address = readAddress(blob + 1);
+    outConfig.subnet = readAddress(blob + 5);
+    outConfig.gateway = readAddress(blob + 9);
+    outConfig.dns1 = readAddress(blob + 13);
+    outConfig.dns2 = readAddress(blob + 17);
+    outConfig.isValid = true;
+    return Status::OK;
+}
+
+Status NVSManager::saveLease(const StoredLease& lease) {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    uint8_t blob[LEASE_BLOB_SIZE];
+    writeAddress(blob, lease.address);
+    writeAddress(blob + 4, lease.subnet);
+    writeAddress(blob + 8, lease.gateway);
+    writeAddress(blob + 12, lease.dns1);
+    writeAddress(blob + 16, lease.dns2);
+    writeU32(blob + 20, lease.obtainedAt);
+    writeU32(blob + 24, lease.renewAt);
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    size_t written = preferences.putBytes(KEY_LEASE, blob, sizeof(blob));
+
+    preferences.end();
+
+    return written == sizeof(blob) ? Status::OK : Status::STORAGE_WRITE_FAILED;
+}
+
+Status NVSManager::loadLease(StoredLease& outLease) {
+    outLease = StoredLease();
+
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for reading
+    if (!preferences.begin(NAMESPACE, true)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    uint8_t blob[LEASE_BLOB_SIZE];
+    size_t length = preferences.getBytes(KEY_LEASE, blob, sizeof(blob));
+
+    preferences.end();
+
+    if (length != sizeof(blob)) {
+        return Status::NO_STORED_LEASE;
+    }
+
+    outLease.address = readAddress(blob);
+    outLease.subnet = readAddress(blob + 4);
+    outLease.gateway = readAddress(blob + 8);
+    outLease.dns1 = readAddress(blob + 12);
+    outLease.dns2 = readAddress(blob + 16);
+    outLease.obtainedAt = readU32(blob + 20);
+    outLease.renewAt = readU32(blob + 24);
+    outLease.isValid = true;
+    return Status::OK;
+}
+
+Status NVSManager::clearLease() {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
+    // remove() fails if no lease is stored, which is fine here
+    preferences.remove(KEY_LEASE);
+
+    preferences.end();
+
+    return Status::OK;
+}
+
+void NVSManager::writeAddress(uint8_t* buffer, const IPAddress& address) {
+    for (int i = 0; i < 4; i++) {
+        buffer[i] = address[i];
+    }
+}
+
+IPAddress NVSManager::readAddress(const uint8_t* buffer) {
+    return IPAddress(buffer[0], buffer[1], buffer[2], buffer[3]);
+}
+
+void NVSManager::writeU32(uint8_t* buffer, uint32_t value) {
+    buffer[0] = value & 0xFF;
+    buffer[1] = (value >> 8) & 0xFF;
+    buffer[2] = (value >> 16) & 0xFF;
+    buffer[3] = (value >> 24) & 0xFF;
+}
+
+uint32_t NVSManager::readU32(const uint8_t* buffer) {
+    return buffer[0] | (static_cast<uint32_t>(buffer[1]) << 8) |
+           (static_cast<uint32_t>(buffer[2]) << 16) | (static_cast<uint32_t>(buffer[3]) << 24);
+}
+
+Status NVSManager::clearCredentials() {
+    if (!initialized) {
+        return Status::STORAGE_NOT_INITIALIZED;
+    }
+
+    // Open preferences for writing
+    if (!preferences.begin(NAMESPACE, false)) {
+        return Status::STORAGE_OPEN_FAILED;
+    }
+
     // Clear all keys in the namespace
     bool success = preferences.clear();
+    networksLoaded = false;
 
     preferences.end();
 
     if (!success) {
-        setError("Failed to clear credentials from NVS");
-        return false;
+        return Status::STORAGE_CLEAR_FAILED;
     }
 
-    return true;
+    return Status::OK;
 }
 
 } // namespace WiFiSet
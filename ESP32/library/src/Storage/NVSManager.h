@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "../Protocol/Status.h"
+#include "../Protocol/FixedVector.h"
 
 namespace WiFiSet {
 
@@ -18,6 +20,109 @@ struct StoredCredentials {
     StoredCredentials(const String& s, const String& p) : ssid(s), password(p), isValid(true) {}
 };
 
+/**
+ * AP of the last successful connection to the stored network
+ * Lets the next boot connect without scanning.
+ */
+struct StoredLocation {
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t authMode;   // wifi_auth_mode_t
+    bool isValid;
+
+    StoredLocation() : channel(0), authMode(0), isValid(false) { memset(bssid, 0, sizeof(bssid)); }
+};
+
+// Length of the WPA2 pairwise master key
+static const size_t STORED_PMK_LENGTH = 32;
+
+/**
+ * PMK derived from the stored SSID and password
+ * Saves the passphrase derivation on every connect.
+ */
+struct StoredPMK {
+    uint8_t key[STORED_PMK_LENGTH];
+    bool isValid;
+
+    StoredPMK() : isValid(false) { memset(key, 0, sizeof(key)); }
+};
+
+/**
+ * How the device gets its IP address
+ */
+struct StoredIPConfig {
+    bool isStatic;          // false = DHCP
+    IPAddress address;      // Static settings (unused for DHCP)
+    IPAddress subnet;
+    IPAddress gateway;
+    IPAddress dns1;
+    IPAddress dns2;
+    bool isValid;
+
+    StoredIPConfig() : isStatic(false), isValid(false) {}
+};
+
+/**
+ * Last DHCP lease obtained on the stored network
+ * Times are time() seconds, as the system clock keeps running in deep sleep.
+ */
+struct StoredLease {
+    IPAddress address;
+    IPAddress subnet;
+    IPAddress gateway;
+    IPAddress dns1;
+    IPAddress dns2;
+    uint32_t obtainedAt;
+    uint32_t renewAt;       // Renewal time (T1) of the lease
+    bool isValid;
+
+    StoredLease() : obtainedAt(0), renewAt(0), isValid(false) {}
+};
+
+// Entries in the saved network table
+static const size_t MAX_STORED_NETWORKS = 8;
+
+// Failures in a row written to NVS; later ones are only counted in RAM
+static const uint8_t MAX_STORED_FAILURES = 3;
+
+/**
+ * One network in the saved network table
+ * Plain data with the strings stored inline, so the table never allocates.
+ * lastSuccess is a counter rather than a clock time: the clock starts at 0
+ * again after a power-on reset, a counter kept in NVS keeps its order.
+ */
+struct StoredNetwork {
+    char ssid[MAX_SSID_LENGTH + 1];
+    char password[MAX_PASSWORD_LENGTH + 1];
+    uint8_t priority;       // Higher is tried first
+    uint8_t failureCount;   // Failed connects since the last success (stops at 255, at MAX_STORED_FAILURES in NVS)
+    uint32_t lastSuccess;   // Connect stamp of the last success (higher = more recent, 0 = never)
+    bool isValid;
+
+    StoredNetwork() : priority(0), failureCount(0), lastSuccess(0), isValid(false) {
+        ssid[0] = '\0';
+        password[0] = '\0';
+    }
+
+    /**
+     * Set SSID and password (truncated to the protocol limits)
+     */
+    void setCredentials(const String& newSSID, const String& newPassword) {
+        copyField(ssid, newSSID, MAX_SSID_LENGTH);
+        copyField(password, newPassword, MAX_PASSWORD_LENGTH);
+        isValid = true;
+    }
+
+private:
+    static void copyField(char* field, const String& value, size_t maxLength) {
+        size_t length = value.length() > maxLength ? maxLength : value.length();
+        memcpy(field, value.c_str(), length);
+        field[length] = '\0';
+    }
+};
+
+typedef FixedVector<StoredNetwork, MAX_STORED_NETWORKS> StoredNetworkList;
+
 /**
  * NVSManager - Manages persistent storage of WiFi credentials
  *
@@ -26,8 +131,14 @@ struct StoredCredentials {
  *
  * Storage namespace: "wifiset"
  * Keys:
- *   - "ssid": WiFi network name
- *   - "password": WiFi password
+ *   - "ssid": Name of the current network (the one last configured or connected to)
+ *   - "password": Its password
+ *   - "net0" - "net7": StoredNetwork table, the current network included
+ *   - "netstamp": Last connect stamp handed out (see StoredNetwork::lastSuccess)
+ *   - "bssid", "channel", "auth": StoredLocation (removed when the SSID changes)
+ *   - "pmk": StoredPMK (removed when the SSID or password changes)
+ *   - "ipconfig": StoredIPConfig
+ *   - "lease": StoredLease (removed when the SSID changes)
  */
 class NVSManager {
 public:
@@ -42,49 +153,227 @@ public:
     bool begin();
 
     /**
-     * Save WiFi credentials to NVS
+     * Save WiFi credentials to NVS and make them the current network
+     * The network is also added to the saved network table (keeping its
+     * priority if already there). A full table drops its least preferred entry.
      * @param ssid WiFi network name (max 32 bytes)
      * @param password WiFi password (max 63 bytes)
-     * @return true if save successful
+     * @return Status::OK, or the reason the save failed
      */
-    bool saveCredentials(const String& ssid, const String& password);
+    Status saveCredentials(const String& ssid, const String& password);
 
     /**
-     * Load saved WiFi credentials from NVS
-     * @return Stored credentials (isValid will be false if none saved)
+     * Load the credentials of the current network
+     * @param outCredentials Stored credentials (isValid will be false if none saved)
+     * @return Status::OK, or Status::NO_STORED_CREDENTIALS / a storage failure
      */
-    StoredCredentials loadCredentials();
+    Status loadCredentials(StoredCredentials& outCredentials);
 
     /**
-     * Check if credentials are stored in NVS
+     * Check if any network is saved
      * @return true if credentials exist
      */
     bool hasCredentials();
 
     /**
-     * Clear stored credentials from NVS
-     * @return true if clear successful
+     * Add a network to the saved network table, or update its password and priority
+     * Does not change the current network (unless it updates its password), but
+     * becomes the current network if there is none.
+     * @param priority Higher is tried first
+     * @return Status::OK, Status::NETWORK_TABLE_FULL, or the reason the save failed
+     */
+    Status saveNetwork(const String& ssid, const String& password, uint8_t priority);
+
+    /**
+     * Remove a network from the saved network table
+     * Removing the current network also forgets its location, PMK and lease,
+     * and makes the most preferred remaining network current.
+     * @return Status::OK, Status::NETWORK_NOT_STORED, or the reason the removal failed
+     */
+    Status removeNetwork(const String& ssid);
+
+    /**
+     * Change the priority of a saved network
+     * @return Status::OK, Status::NETWORK_NOT_STORED, or the reason the save failed
+     */
+    Status setNetworkPriority(const String& ssid, uint8_t priority);
+
+    /**
+     * Load the saved network table
+     * @param outNetworks Highest priority first, then most recently connected
+     * @return Status::OK, or Status::NO_STORED_CREDENTIALS / a storage failure
+     */
+    Status loadNetworks(StoredNetworkList& outNetworks);
+
+    /**
+     * Record the outcome of a connect to a saved network
+     * Success stamps lastSuccess and clears failureCount; failure counts up.
+     * Nothing is written if a success doesn't change the entry, or for a
+     * failure past MAX_STORED_FAILURES (backoff retries would wear the flash).
+     * @return Status::OK, Status::NETWORK_NOT_STORED, or the reason the save failed
+     */
+    Status recordConnectResult(const String& ssid, bool success);
+
+    /**
+     * Save the AP of a successful connection to the stored network
+     * Nothing is written if the stored location is already the same.
+     * @return Status::OK, or the reason the save failed
+     */
+    Status saveLocation(const StoredLocation& location);
+
+    /**
+     * Load the AP of the last successful connection
+     * @param outLocation Stored location (isValid will be false if none saved)
+     * @return Status::OK, or Status::NO_STORED_LOCATION / a storage failure
      */
-    bool clearCredentials();
+    Status loadLocation(StoredLocation& outLocation);
 
     /**
-     * Get last error message
+     * Forget the stored location (e.g. it no longer leads to the network)
+     * @return Status::OK, or the reason the clear failed
      */
-    const String& getLastError() const { return lastError; }
+    Status clearLocation();
+
+    /**
+     * Save the PMK of the stored credentials
+     * @return Status::OK, or the reason the save failed
+     */
+    Status savePMK(const StoredPMK& pmk);
+
+    /**
+     * Load the PMK of the stored credentials
+     * @param outPMK Stored key (isValid will be false if none saved)
+     * @return Status::OK, or Status::NO_STORED_PMK / a storage failure
+     */
+    Status loadPMK(StoredPMK& outPMK);
+
+    /**
+     * Forget the stored PMK (e.g. the AP rejected it)
+     * @return Status::OK, or the reason the clear failed
+     */
+    Status clearPMK();
+
+    /**
+     * Save how the device gets its IP address
+     * @return Status::OK, or the reason the save failed
+     */
+    Status saveIPConfig(const StoredIPConfig& config);
+
+    /**
+     * Load the IP configuration
+     * @param outConfig Stored configuration (isValid will be false if none saved)
+     * @return Status::OK, or Status::NO_STORED_IP_CONFIG / a storage failure
+     */
+    Status loadIPConfig(StoredIPConfig& outConfig);
+
+    /**
+     * Save the DHCP lease obtained on the stored network
+     * @return Status::OK, or the reason the save failed
+     */
+    Status saveLease(const StoredLease& lease);
+
+    /**
+     * Load the last DHCP lease
+     * @param outLease Stored lease (isValid will be false if none saved)
+     * @return Status::OK, or Status::NO_STORED_LEASE / a storage failure
+     */
+    Status loadLease(StoredLease& outLease);
+
+    /**
+     * Forget the stored DHCP lease
+     * @return Status::OK, or the reason the clear failed
+     */
+    Status clearLease();
+
+    /**
+     * Clear all saved networks and settings from NVS
+     * @return Status::OK, or the reason the clear failed
+     */
+    Status clearCredentials();
 
 private:
     Preferences preferences;
-    String lastError;
     bool initialized;
 
+    // Copy of the saved network table, read from NVS once and kept in step by every write
+    StoredNetwork networks[MAX_STORED_NETWORKS];
+    bool networksLoaded;
+
     static const char* NAMESPACE;
     static const char* KEY_SSID;
     static const char* KEY_PASSWORD;
+    static const char* KEY_BSSID;
+    static const char* KEY_CHANNEL;
+    static const char* KEY_AUTH_MODE;
+    static const char* KEY_PMK;
+    static const char* KEY_IP_CONFIG;
+    static const char* KEY_LEASE;
+    static const char* KEY_NETWORK_STAMP;
+
+    // Blob layouts: addresses in network byte order, times little-endian
+    static const size_t IP_CONFIG_BLOB_SIZE = 1 + 5 * 4;
+    static const size_t LEASE_BLOB_SIZE = 5 * 4 + 2 * 4;
+
+    // Priority + Failure Count + Last Success + SSID (length-prefixed) + Password (length-prefixed)
+    static const size_t NETWORK_BLOB_SIZE = 1 + 1 + 4 + 1 + MAX_SSID_LENGTH + 1 + MAX_PASSWORD_LENGTH;
+
+    /**
+     * Check credential lengths
+     */
+    static Status validateCredentials(const String& ssid, const String& password);
+
+    /**
+     * Add the pre-table credentials to the saved network table (preferences must be open for writing)
+     */
+    void migrateCredentials();
+
+    /**
+     * Remove the location keys (preferences must be open for writing)
+     */
+    void removeLocationKeys();
+
+    // Saved network table (preferences must be open)
+    bool readNetwork(size_t slot, StoredNetwork& outNetwork);
+    bool writeNetwork(size_t slot, const StoredNetwork& network);
+
+    /**
+     * Fill the table copy from NVS if it isn't loaded yet (preferences must be open)
+     */
+    void loadNetworkTable();
 
     /**
-     * Set error message
+     * Find ssid in the table
+     * @return Slot of the network (outNetwork filled in), or -1
      */
-    void setError(const String& error);
+    int findNetwork(const String& ssid, StoredNetwork& outNetwork);
+
+    /**
+     * First empty slot, or -1 if the table is full
+     */
+    int findFreeSlot();
+
+    /**
+     * Slot of the entry to try first (see loadNetworks()), or -1 if the table is empty
+     */
+    int findMostPreferred();
+
+    /**
+     * Make network the current one (preferences must be open for writing)
+     */
+    bool writeCurrentNetwork(const StoredNetwork& network);
+
+    /**
+     * Slot of the entry to drop for a new network: lowest priority, then most
+     * failures, then least recently connected
+     */
+    int findLeastPreferred();
+
+    static void networkKey(size_t slot, char* key);
+
+    static void writeAddress(uint8_t* buffer, const IPAddress& address);
+    static IPAddress readAddress(const uint8_t* buffer);
+    static void writeU32(uint8_t* buffer, uint32_t value);
+    static uint32_t readU32(const uint8_t* buffer);
 };
 
 } // namespace WiFiSet
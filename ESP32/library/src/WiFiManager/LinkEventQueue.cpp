@@ -0,0 +1,34 @@
+#include "LinkEventQueue.h"
+
+namespace WiFiSet {
+
+LinkEventQueue::LinkEventQueue() : head(0), tail(0), dropped(0) {}
+
+bool LinkEventQueue::push(const LinkEvent& event) {
+    size_t position = head.load(std::memory_order_relaxed);
+    if (position - tail.load(std::memory_order_acquire) >= LINK_EVENT_QUEUE_SIZE) {
+        dropped++;
+        return false;
+    }
+
+    events[position & (LINK_EVENT_QUEUE_SIZE - 1)] = event;
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool LinkEventQueue::pop(LinkEvent& out) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    if (position == head.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    out = events[position & (LINK_EVENT_QUEUE_SIZE - 1)];
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+void LinkEventQueue::clear() {
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+} // namespace WiFiSet
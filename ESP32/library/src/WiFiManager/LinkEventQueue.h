@@ -0,0 +1,80 @@
+#ifndef LINK_EVENT_QUEUE_H
+#define LINK_EVENT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace WiFiSet {
+
+// WiFi events held between the WiFi event task and pollConnection()
+static const size_t LINK_EVENT_QUEUE_SIZE = 16;
+
+/**
+ * Station link event recorded on the WiFi event task
+ */
+struct LinkEvent {
+    enum Type : uint8_t {
+        STA_CONNECTED,  // detail = auth mode of the AP
+        GOT_IP,         // detail unused
+        DISCONNECTED    // detail = WiFi reason code
+    };
+
+    Type type;
+    uint8_t detail;
+
+    LinkEvent() : type(GOT_IP), detail(0) {}
+    LinkEvent(Type t, uint8_t d) : type(t), detail(d) {}
+};
+
+/**
+ * LinkEventQueue - WiFi events in the order the driver reported them
+ *
+ * A ring with one producer (the WiFi event task) and one consumer (the
+ * main loop), so a disconnect followed by a reconnect is replayed in that
+ * order and each disconnect keeps its own reason code. Never allocates;
+ * pure logic with no WiFi or Arduino dependencies.
+ */
+class LinkEventQueue {
+public:
+    LinkEventQueue();
+
+    /**
+     * Record an event (producer side)
+     * @return false if the queue is full (the event is dropped and counted)
+     */
+    bool push(const LinkEvent& event);
+
+    /**
+     * Take the oldest event (consumer side)
+     * @return false if the queue is empty
+     */
+    bool pop(LinkEvent& out);
+
+    /**
+     * Discard all recorded events (consumer side)
+     */
+    void clear();
+
+    /**
+     * Check if no event is waiting
+     */
+    bool isEmpty() const { return head.load() == tail.load(); }
+
+    /**
+     * Events dropped because the queue was full since the last call
+     */
+    uint32_t takeDropped() { return dropped.exchange(0); }
+
+private:
+    static_assert((LINK_EVENT_QUEUE_SIZE & (LINK_EVENT_QUEUE_SIZE - 1)) == 0, "Queue size must be a power of two");
+
+    LinkEvent events[LINK_EVENT_QUEUE_SIZE];
+    std::atomic<size_t> head;       // Next slot to write (free-running, producer)
+    std::atomic<size_t> tail;       // Next slot to read (free-running, consumer)
+    std::atomic<uint32_t> dropped;
+};
+
+} // namespace WiFiSet
+
+#endif // LINK_EVENT_QUEUE_H
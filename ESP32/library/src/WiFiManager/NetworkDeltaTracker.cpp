@@ -0,0 +1,69 @@
+#include "NetworkDeltaTracker.h"
+
+namespace WiFiSet {
+
+NetworkDeltaTracker::NetworkDeltaTracker() : valid(false) {}
+
+int NetworkDeltaTracker::find(const NetworkList& networks, const WiFiNetworkInfo& network) {
+    for (size_t i = 0; i < networks.size(); i++) {
+        if (networks[i].sameSSID(network)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void NetworkDeltaTracker::setBaseline(const NetworkList& networks) {
+    baseline.clear();
+    for (size_t i = 0; i < networks.size(); i++) {
+        if (networks[i].hasSSID()) {
+            baseline.push_back(networks[i]);
+        }
+    }
+    valid = true;
+}
+
+size_t NetworkDeltaTracker::update(const NetworkList& networks, uint8_t rssiThreshold,
+                                   NetworkChangeList& out) {
+    out.clear();
+
+    // Gone from the latest scan (out of range, or no longer in the top K)
+    size_t kept = 0;
+    for (size_t i = 0; i < baseline.size(); i++) {
+        if (find(networks, baseline[i]) < 0) {
+            out.push_back(NetworkChange(NetworkChangeType::REMOVED, baseline[i]));
+        } else {
+            if (kept != i) {
+                baseline[kept] = baseline[i];
+            }
+            kept++;
+        }
+    }
+    baseline.truncate(kept);
+
+    for (size_t i = 0; i < networks.size(); i++) {
+        const WiFiNetworkInfo& network = networks[i];
+        if (!network.hasSSID()) {
+            continue;
+        }
+
+        int index = find(baseline, network);
+        if (index < 0) {
+            baseline.push_back(network);
+            out.push_back(NetworkChange(NetworkChangeType::ADDED, network));
+            continue;
+        }
+
+        WiFiNetworkInfo& known = baseline[index];
+        int rssiChange = abs(static_cast<int>(network.rssi) - static_cast<int>(known.rssi));
+        if (rssiChange >= rssiThreshold || network.channel != known.channel ||
+            network.securityType != known.securityType) {
+            known = network;
+            out.push_back(NetworkChange(NetworkChangeType::UPDATED, network));
+        }
+    }
+
+    return out.size();
+}
+
+} // namespace WiFiSet
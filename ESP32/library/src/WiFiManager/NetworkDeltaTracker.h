@@ -0,0 +1,78 @@
+#ifndef NETWORK_DELTA_TRACKER_H
+#define NETWORK_DELTA_TRACKER_H
+
+#include <Arduino.h>
+#include "../Protocol/MessageBuilder.h"
+#include "NetworkSelector.h"
+
+namespace WiFiSet {
+
+// RSSI change (dB) reported to a subscribed client unless it asks otherwise
+static const uint8_t DEFAULT_DELTA_RSSI_THRESHOLD = 5;
+
+// Rescan period while a client is subscribed to network list updates
+static const unsigned long DEFAULT_SCAN_SUBSCRIPTION_INTERVAL_MS = 10000;
+
+/**
+ * NetworkDeltaTracker - Remembers the list a client holds and diffs new scans against it
+ *
+ * After a full list is sent, setBaseline() records it. Each later scan is
+ * passed to update(), which reports networks that appeared, disappeared or
+ * moved (channel or security change, or an RSSI change of at least the
+ * threshold) and folds those changes into the baseline. Small RSSI drift is
+ * not reported, and the baseline keeps the last reported value, so slow
+ * drift is reported once it adds up to the threshold.
+ *
+ * Networks are keyed by SSID; hidden networks (empty SSID) are not tracked.
+ */
+class NetworkDeltaTracker {
+public:
+    NetworkDeltaTracker();
+
+    /**
+     * Record the list the client has just received
+     */
+    void setBaseline(const NetworkList& networks);
+
+    /**
+     * Forget the baseline (e.g. client disconnected, or a change transfer
+     * was cut short); the client needs a full list again
+     */
+    void clear() {
+        baseline.clear();
+        valid = false;
+    }
+
+    /**
+     * Check if the baseline matches what the client holds
+     */
+    bool hasBaseline() const { return valid; }
+
+    /**
+     * Diff a new scan against the baseline and update the baseline
+     * @param networks Latest scan results
+     * @param rssiThreshold Minimum RSSI change in dB to report
+     * @param out Replaced with the changes (removals first)
+     * @return Number of changes
+     */
+    size_t update(const NetworkList& networks, uint8_t rssiThreshold,
+                  NetworkChangeList& out);
+
+    /**
+     * Networks the client currently holds
+     */
+    const NetworkList& getBaseline() const { return baseline; }
+
+private:
+    NetworkList baseline;
+    bool valid;
+
+    /**
+     * Index of the entry with the same SSID as network, or -1
+     */
+    static int find(const NetworkList& networks, const WiFiNetworkInfo& network);
+};
+
+} // namespace WiFiSet
+
+#endif // NETWORK_DELTA_TRACKER_H
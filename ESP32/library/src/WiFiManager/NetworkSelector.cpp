@@ -0,0 +1,110 @@
+#include "NetworkSelector.h"
+#include <algorithm>
+
+namespace WiFiSet {
+
+namespace {
+
+// Heap order over candidate indices: the weakest network ends up on top
+struct WeakerOnTop {
+    const NetworkList& networks;
+
+    explicit WeakerOnTop(const NetworkList& n) : networks(n) {}
+
+    bool operator()(uint8_t a, uint8_t b) const {
+        return networks[a].rssi > networks[b].rssi;
+    }
+};
+
+uint16_t channelBit(uint8_t channel) {
+    // 5 GHz channels don't fit the mask
+    return (channel >= 1 && channel <= 14) ? static_cast<uint16_t>(1u << channel) : 0;
+}
+
+} // namespace
+
+NetworkSelector::NetworkSelector(size_t capacity)
+    : capacity(capacity > MAX_SCAN_CANDIDATES ? MAX_SCAN_CANDIDATES : capacity) {}
+
+void NetworkSelector::add(const WiFiNetworkInfo& network) {
+    if (network.hasSSID()) {
+        for (size_t i = 0; i < candidates.size(); i++) {
+            WiFiNetworkInfo& existing = candidates[i];
+            if (!existing.sameSSID(network)) {
+                continue;
+            }
+
+            // Another AP of a known network: report its strongest AP
+            if (network.rssi > existing.rssi) {
+                existing.rssi = network.rssi;
+                existing.securityType = network.securityType;
+                existing.channel = network.channel;
+            }
+            if (existing.apCount < 255) {
+                existing.apCount++;
+            }
+            existing.channelMask |= channelBit(network.channel);
+            return;
+        }
+    }
+
+    WiFiNetworkInfo entry = network;
+    entry.apCount = 1;
+    entry.channelMask = channelBit(network.channel);
+
+    if (candidates.size() < capacity) {
+        candidates.push_back(entry);
+        return;
+    }
+
+    if (capacity == 0) {
+        return;
+    }
+
+    // Table full: only a network stronger than the weakest one gets in
+    size_t weakest = findWeakest();
+    if (entry.rssi > candidates[weakest].rssi) {
+        candidates[weakest] = entry;
+    }
+}
+
+size_t NetworkSelector::findWeakest() const {
+    size_t weakest = 0;
+    for (size_t i = 1; i < candidates.size(); i++) {
+        if (candidates[i].rssi < candidates[weakest].rssi) {
+            weakest = i;
+        }
+    }
+    return weakest;
+}
+
+void NetworkSelector::selectTop(size_t k, NetworkList& out) {
+    out.clear();
+    if (k == 0) {
+        return;
+    }
+
+    // Bounded min-heap of the k strongest seen so far
+    WeakerOnTop weakerOnTop(candidates);
+    heap.clear();
+    for (size_t i = 0; i < candidates.size(); i++) {
+        uint8_t index = static_cast<uint8_t>(i);
+        if (heap.size() < k) {
+            heap.push_back(index);
+            std::push_heap(heap.begin(), heap.end(), weakerOnTop);
+        } else if (candidates[i].rssi > candidates[heap.front()].rssi) {
+            std::pop_heap(heap.begin(), heap.end(), weakerOnTop);
+            heap.back() = index;
+            std::push_heap(heap.begin(), heap.end(), weakerOnTop);
+        }
+    }
+
+    // Strongest first
+    std::sort_heap(heap.begin(), heap.end(), weakerOnTop);
+
+    for (size_t i = 0; i < heap.size(); i++) {
+        out.push_back(candidates[heap[i]]);
+    }
+}
+
+} // namespace WiFiSet
@@ -0,0 +1,85 @@
+#ifndef NETWORK_SELECTOR_H
+#define NETWORK_SELECTOR_H
+
+#include <Arduino.h>
+#include "../Protocol/MessageBuilder.h"
+
+namespace WiFiSet {
+
+// Distinct SSIDs kept while a scan runs
+static const size_t MAX_SCAN_CANDIDATES = MAX_NETWORK_LIST_SIZE;
+
+// Networks reported per scan unless configured otherwise
+static const size_t DEFAULT_SCAN_TOP_K = 20;
+
+/**
+ * NetworkSelector - Merges raw scan results by SSID and ranks them by signal
+ *
+ * Mesh and multi-AP networks appear once per access point in a raw scan.
+ * add() folds them into one entry per SSID, keeping the strongest AP's
+ * RSSI, channel and security plus the AP count and the set of channels.
+ * selectTop() then picks the K strongest entries with a bounded min-heap
+ * (O(n log K)), so the list sent to the client holds the networks users
+ * actually pick from.
+ *
+ * Hidden networks (empty SSID) are not merged with each other.
+ *
+ * Candidates and the selection heap are fixed-size members, so a selector
+ * kept alive across scans never allocates.
+ *
+ * Usage:
+ *   NetworkSelector selector;
+ *   for (each raw result) selector.add(info);
+ *   selector.selectTop(20, results);
+ */
+class NetworkSelector {
+public:
+    /**
+     * @param capacity Maximum distinct SSIDs kept (at most MAX_SCAN_CANDIDATES); when full, a new SSID
+     *                 replaces the weakest candidate if it is stronger
+     */
+    explicit NetworkSelector(size_t capacity = MAX_SCAN_CANDIDATES);
+
+    /**
+     * Merge one raw scan result
+     */
+    void add(const WiFiNetworkInfo& network);
+
+    /**
+     * Discard all candidates
+     */
+    void clear() { candidates.clear(); }
+
+    /**
+     * Merged candidates in discovery order
+     * A new SSID is appended unless the table is full, in which case it
+     * takes the slot of the weakest candidate.
+     */
+    const NetworkList& getCandidates() const { return candidates; }
+
+    /**
+     * Number of merged candidates
+     */
+    size_t size() const { return candidates.size(); }
+
+    /**
+     * Pick the strongest candidates
+     * @param k Maximum number of networks to return
+     * @param out Replaced with up to k networks, strongest first
+     */
+    void selectTop(size_t k, NetworkList& out);
+
+private:
+    NetworkList candidates;
+    FixedVector<uint8_t, MAX_SCAN_CANDIDATES> heap;  // Candidate indices for selectTop(), weakest on top
+    size_t capacity;
+
+    /**
+     * Index of the weakest candidate (candidates must not be empty)
+     */
+    size_t findWeakest() const;
+};
+
+} // namespace WiFiSet
+
+#endif // NETWORK_SELECTOR_H
@@ -0,0 +1,55 @@
+#include "PairwiseMasterKey.h"
+#include <mbedtls/version.h>
+#include <mbedtls/md.h>
+#include <mbedtls/pkcs5.h>
+
+namespace WiFiSet {
+
+bool PairwiseMasterKey::derive(const String& ssid, const String& passphrase) {
+    isValid = false;
+
+    if (ssid.length() == 0 || !isPassphrase(passphrase)) {
+        return false;
+    }
+
+    const unsigned char* password = reinterpret_cast<const unsigned char*>(passphrase.c_str());
+    const unsigned char* salt = reinterpret_cast<const unsigned char*>(ssid.c_str());
+
+#if MBEDTLS_VERSION_NUMBER >= 0x03030000
+    // mbedTLS 3.3+ (Arduino core 3.x)
+    int ret = mbedtls_pkcs5_pbkdf2_hmac_ext(MBEDTLS_MD_SHA1, password, passphrase.length(),
+                                            salt, ssid.length(), PMK_ITERATIONS, PMK_LENGTH, key);
+#else
+    mbedtls_md_context_t md;
+    mbedtls_md_init(&md);
+    int ret = mbedtls_md_setup(&md, mbedtls_md_info_from_type(MBEDTLS_MD_SHA1), 1);
+    if (ret == 0) {
+        ret = mbedtls_pkcs5_pbkdf2_hmac(&md, password, passphrase.length(),
+                                        salt, ssid.length(), PMK_ITERATIONS, PMK_LENGTH, key);
+    }
+    mbedtls_md_free(&md);
+#endif
+
+    if (ret != 0) {
+        memset(key, 0, sizeof(key));
+        return false;
+    }
+
+    isValid = true;
+    return true;
+}
+
+String PairwiseMasterKey::toPSK() const {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    char hex[PMK_HEX_LENGTH + 1];
+    for (size_t i = 0; i < PMK_LENGTH; i++) {
+        hex[2 * i] = HEX_DIGITS[key[i] >> 4];
+        hex[2 * i + 1] = HEX_DIGITS[key[i] & 0x0F];
+    }
+    hex[PMK_HEX_LENGTH] = '\0';
+
+    return String(hex);
+}
+
+} // namespace WiFiSet
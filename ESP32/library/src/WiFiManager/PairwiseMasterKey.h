@@ -0,0 +1,79 @@
+#ifndef PAIRWISE_MASTER_KEY_H
+#define PAIRWISE_MASTER_KEY_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+namespace WiFiSet {
+
+// WPA/WPA2-Personal PMK: PBKDF2-HMAC-SHA1(passphrase, SSID, 4096 iterations, 32 bytes)
+static const size_t PMK_LENGTH = 32;
+static const size_t PMK_HEX_LENGTH = 2 * PMK_LENGTH;
+static const unsigned int PMK_ITERATIONS = 4096;
+
+// Passphrase length range defined by IEEE 802.11 (64 characters is a hex PSK)
+static const size_t MIN_PASSPHRASE_LENGTH = 8;
+static const size_t MAX_PASSPHRASE_LENGTH = 63;
+
+/**
+ * PairwiseMasterKey - The WPA2-PSK key derived from an SSID and passphrase
+ *
+ * Turning a passphrase into the PMK costs 4096 PBKDF2 iterations, which the
+ * supplicant would otherwise repeat on every connect. Derive it once, store
+ * it, and pass toPSK() to WiFi.begin() in place of the passphrase: a
+ * 64-digit hex password is taken as the PSK itself.
+ *
+ * Only WPA/WPA2-Personal uses this key. WPA3 (SAE) authenticates with the
+ * passphrase, so check usedBy() with the AP's auth mode before using it.
+ *
+ * Usage:
+ *   PairwiseMasterKey pmk;
+ *   if (pmk.derive(ssid, password)) save(pmk.key);
+ *   WiFi.begin(ssid.c_str(), pmk.toPSK().c_str());
+ */
+struct PairwiseMasterKey {
+    uint8_t key[PMK_LENGTH];
+    bool isValid;
+
+    PairwiseMasterKey() : isValid(false) { memset(key, 0, sizeof(key)); }
+
+    /**
+     * Derive the key (blocks for the 4096 PBKDF2 iterations)
+     * @return false if the passphrase can't have a PMK (open network, hex PSK,
+     *         wrong length) or the derivation failed
+     */
+    bool derive(const String& ssid, const String& passphrase);
+
+    /**
+     * Adopt a stored key
+     */
+    void set(const uint8_t* value) {
+        memcpy(key, value, sizeof(key));
+        isValid = true;
+    }
+
+    /**
+     * The key as 64 lowercase hex digits, accepted by WiFi.begin() as a password
+     */
+    String toPSK() const;
+
+    /**
+     * Check if a password is a passphrase a PMK can be derived from
+     */
+    static bool isPassphrase(const String& password) {
+        return password.length() >= MIN_PASSPHRASE_LENGTH && password.length() <= MAX_PASSPHRASE_LENGTH;
+    }
+
+    /**
+     * Check if an AP with this auth mode accepts the PMK in place of the passphrase
+     */
+    static bool usedBy(wifi_auth_mode_t authMode) {
+        return authMode == WIFI_AUTH_WPA_PSK ||
+               authMode == WIFI_AUTH_WPA2_PSK ||
+               authMode == WIFI_AUTH_WPA_WPA2_PSK;
+    }
+};
+
+} // namespace WiFiSet
+
+#endif // PAIRWISE_MASTER_KEY_H
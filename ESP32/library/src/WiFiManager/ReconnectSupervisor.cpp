@@ -0,0 +1,115 @@
+#include "ReconnectSupervisor.h"
+#include <esp_system.h>
+
+namespace WiFiSet {
+
+ReconnectSupervisor::ReconnectSupervisor()
+    : active(false),
+      attemptRunning(false),
+      outageStart(0),
+      retryAt(0) {}
+
+void ReconnectSupervisor::setConfig(const ReconnectConfig& newConfig) {
+    config = newConfig;
+    if (config.jitterPercent > 100) {
+        config.jitterPercent = 100;
+    }
+    if (config.maxDelayMs < config.initialDelayMs) {
+        config.maxDelayMs = config.initialDelayMs;
+    }
+    if (!config.enabled) {
+        cancel();
+    }
+}
+
+void ReconnectSupervisor::linkLost(unsigned long now) {
+    if (!config.enabled || active) {
+        return;
+    }
+
+    active = true;
+    attemptRunning = false;
+    outageStart = now;
+    stats.outages++;
+    stats.currentRetries = 0;
+    scheduleRetry(now);
+}
+
+bool ReconnectSupervisor::isRetryDue(unsigned long now) const {
+    // Signed difference keeps working across the millis() wrap
+    return active && !attemptRunning && static_cast<long>(now - retryAt) >= 0;
+}
+
+void ReconnectSupervisor::attemptStarted() {
+    attemptRunning = true;
+    stats.attempts++;
+    if (stats.currentRetries < 0xFFFF) {
+        stats.currentRetries++;
+    }
+}
+
+void ReconnectSupervisor::attemptFailed(unsigned long now) {
+    if (!active) {
+        return;
+    }
+    attemptRunning = false;
+    scheduleRetry(now);
+}
+
+void ReconnectSupervisor::linkRestored(unsigned long now) {
+    if (!active) {
+        return;
+    }
+
+    unsigned long recovery = now - outageStart;
+    stats.recoveries++;
+    stats.lastRecoveryMs = recovery;
+    stats.totalRecoveryMs += recovery;
+    if (recovery > stats.maxRecoveryMs) {
+        stats.maxRecoveryMs = recovery;
+    }
+    Serial.printf("[WiFi] Recovered after %lu ms and %u retries\n", recovery, stats.currentRetries);
+
+    cancel();
+}
+
+void ReconnectSupervisor::cancel() {
+    active = false;
+    attemptRunning = false;
+    stats.currentRetries = 0;
+}
+
+ReconnectStats ReconnectSupervisor::getStats(unsigned long now) const {
+    ReconnectStats result = stats;
+    result.nextRetryInMs = 0;
+    if (active && !attemptRunning && static_cast<long>(retryAt - now) > 0) {
+        result.nextRetryInMs = retryAt - now;
+    }
+    return result;
+}
+
+void ReconnectSupervisor::scheduleRetry(unsigned long now) {
+    unsigned long delayMs = retryDelay(stats.currentRetries);
+    retryAt = now + delayMs;
+    Serial.printf("[WiFi] Reconnect in %lu ms\n", delayMs);
+}
+
+unsigned long ReconnectSupervisor::retryDelay(uint16_t retries) const {
+    // Double per retry, stopping at the cap (checked before shifting, so it can't overflow)
+    unsigned long delayMs = config.initialDelayMs;
+    for (uint16_t i = 0; i < retries && delayMs < config.maxDelayMs; i++) {
+        delayMs = delayMs > config.maxDelayMs / 2 ? config.maxDelayMs : delayMs * 2;
+    }
+    if (delayMs > config.maxDelayMs) {
+        delayMs = config.maxDelayMs;
+    }
+
+    // Shorten by a random 0 - jitterPercent %
+    unsigned long spread = delayMs / 100 * config.jitterPercent;
+    if (spread > 0) {
+        delayMs -= esp_random() % (spread + 1);
+    }
+    return delayMs;
+}
+
+} // namespace WiFiSet
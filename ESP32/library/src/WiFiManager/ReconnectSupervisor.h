@@ -0,0 +1,165 @@
+#ifndef RECONNECT_SUPERVISOR_H
+#define RECONNECT_SUPERVISOR_H
+
+#include <Arduino.h>
+
+namespace WiFiSet {
+
+// Backoff defaults: 2 s, 4 s, 8 s ... up to 5 minutes, each cut by up to half at random
+static const unsigned long DEFAULT_RECONNECT_INITIAL_DELAY_MS = 2000;
+static const unsigned long DEFAULT_RECONNECT_MAX_DELAY_MS = 300000;
+static const uint8_t DEFAULT_RECONNECT_JITTER_PERCENT = 50;
+
+/**
+ * Reconnect backoff settings
+ */
+struct ReconnectConfig {
+    bool enabled;
+    unsigned long initialDelayMs;   // Delay before the first retry (before jitter)
+    unsigned long maxDelayMs;       // Cap on the doubled delay
+    uint8_t jitterPercent;          // Each delay is shortened by a random 0 - jitterPercent % (0 - 100)
+
+    ReconnectConfig()
+        : enabled(true),
+          initialDelayMs(DEFAULT_RECONNECT_INITIAL_DELAY_MS),
+          maxDelayMs(DEFAULT_RECONNECT_MAX_DELAY_MS),
+          jitterPercent(DEFAULT_RECONNECT_JITTER_PERCENT) {}
+};
+
+/**
+ * Reconnect metrics (since boot)
+ */
+struct ReconnectStats {
+    uint32_t outages;           // Link losses (and failed boot connects) handed to the supervisor
+    uint32_t recoveries;        // Outages that ended with a connection
+    uint32_t attempts;          // Retries started, all outages
+    uint16_t currentRetries;    // Retries in the current outage (0 when connected)
+    unsigned long lastRecoveryMs;   // Time to recovery of the last outage
+    unsigned long maxRecoveryMs;    // Longest time to recovery
+    unsigned long totalRecoveryMs;  // Sum over all recoveries (see averageRecoveryMs())
+    unsigned long nextRetryInMs;    // Time left until the next retry (0 = none scheduled or due now)
+
+    ReconnectStats()
+        : outages(0),
+          recoveries(0),
+          attempts(0),
+          currentRetries(0),
+          lastRecoveryMs(0),
+          maxRecoveryMs(0),
+          totalRecoveryMs(0),
+          nextRetryInMs(0) {}
+
+    /**
+     * Mean time to recovery in milliseconds (0 if nothing recovered yet)
+     */
+    unsigned long averageRecoveryMs() const { return recoveries > 0 ? totalRecoveryMs / recoveries : 0; }
+};
+
+/**
+ * ReconnectSupervisor - Schedules WiFi reconnects with capped exponential backoff and jitter
+ *
+ * Only decides when to retry; the caller starts the attempt and reports
+ * the outcome. The delay before retry n is min(maxDelayMs,
+ * initialDelayMs * 2^n), shortened by a random share of up to
+ * jitterPercent. The jitter applies to the first retry too: after a power
+ * blip every device loses the AP at the same moment, and the random
+ * spread keeps them from associating in lockstep.
+ *
+ * All methods take millis() and never block.
+ *
+ * Usage:
+ *   supervisor.linkLost(millis());
+ *   // in loop():
+ *   if (supervisor.isRetryDue(millis())) { supervisor.attemptStarted(); beginConnect(...); }
+ *   // when the attempt ends:
+ *   success ? supervisor.linkRestored(millis()) : supervisor.attemptFailed(millis());
+ */
+class ReconnectSupervisor {
+public:
+    ReconnectSupervisor();
+
+    /**
+     * Set the backoff (takes effect from the next scheduled retry)
+     * Disabling it cancels a running outage.
+     */
+    void setConfig(const ReconnectConfig& config);
+
+    /**
+     * Get the backoff settings
+     */
+    const ReconnectConfig& getConfig() const { return config; }
+
+    /**
+     * The link dropped or could not be brought up: schedule the first retry
+     * Ignored while an outage is already being handled.
+     */
+    void linkLost(unsigned long now);
+
+    /**
+     * Check if a retry should start now
+     */
+    bool isRetryDue(unsigned long now) const;
+
+    /**
+     * A retry was started (no new retry is due until it is reported)
+     */
+    void attemptStarted();
+
+    /**
+     * The retry failed: schedule the next one with a longer delay
+     */
+    void attemptFailed(unsigned long now);
+
+    /**
+     * The link is up: end the outage and record its time to recovery
+     * Any connect that succeeds counts, whether the supervisor started it or not.
+     */
+    void linkRestored(unsigned long now);
+
+    /**
+     * Stop retrying without counting a recovery (e.g. credentials cleared)
+     */
+    void cancel();
+
+    /**
+     * Check if an outage is being handled
+     */
+    bool isActive() const { return active; }
+
+    /**
+     * Check if a retry started by attemptStarted() has not been reported yet
+     */
+    bool isAttemptRunning() const { return attemptRunning; }
+
+    /**
+     * Retries started in the current outage
+     */
+    uint16_t getCurrentRetries() const { return stats.currentRetries; }
+
+    /**
+     * Metrics, with nextRetryInMs as of now
+     */
+    ReconnectStats getStats(unsigned long now) const;
+
+private:
+    ReconnectConfig config;
+    ReconnectStats stats;
+    bool active;
+    bool attemptRunning;
+    unsigned long outageStart;
+    unsigned long retryAt;
+
+    /**
+     * Schedule the next retry from now, based on the retries made so far
+     */
+    void scheduleRetry(unsigned long now);
+
+    /**
+     * Backoff delay before retry number retries, jitter applied
+     */
+    unsigned long retryDelay(uint16_t retries) const;
+};
+
+} // namespace WiFiSet
+
+#endif // RECONNECT_SUPERVISOR_H
@@ -0,0 +1,77 @@
+#include "SavedNetworkSelector.h"
+#include <algorithm>
+
+namespace WiFiSet {
+
+namespace {
+
+// Connect order over matches (see SavedNetworkSelector)
+struct BetterFirst {
+    const SavedNetworkList& networks;
+
+    explicit BetterFirst(const SavedNetworkList& n) : networks(n) {}
+
+    bool operator()(const SavedNetworkMatch& a, const SavedNetworkMatch& b) const {
+        bool aUsable = a.rssi >= MIN_USABLE_RSSI;
+        bool bUsable = b.rssi >= MIN_USABLE_RSSI;
+        if (aUsable != bUsable) {
+            return aUsable;
+        }
+
+        const SavedNetworkInfo& aNetwork = networks[a.index];
+        const SavedNetworkInfo& bNetwork = networks[b.index];
+        bool aReliable = aNetwork.failureCount < MAX_PREFERRED_FAILURES;
+        bool bReliable = bNetwork.failureCount < MAX_PREFERRED_FAILURES;
+        if (aReliable != bReliable) {
+            return aReliable;
+        }
+
+        if (aNetwork.priority != bNetwork.priority) {
+            return aNetwork.priority > bNetwork.priority;
+        }
+        if (a.rssi != b.rssi) {
+            return a.rssi > b.rssi;
+        }
+        if (aNetwork.lastSuccess != bNetwork.lastSuccess) {
+            return aNetwork.lastSuccess > bNetwork.lastSuccess;
+        }
+        return a.index < b.index;
+    }
+};
+
+} // namespace
+
+void SavedNetworkSelector::setNetworks(const SavedNetworkList& saved) {
+    networks = saved;
+    matches.clear();
+}
+
+void SavedNetworkSelector::match(const NetworkList& candidates) {
+    matches.clear();
+
+    for (size_t i = 0; i < networks.size(); i++) {
+        const SavedNetworkInfo& network = networks[i];
+        for (size_t j = 0; j < candidates.size(); j++) {
+            const WiFiNetworkInfo& candidate = candidates[j];
+            if (candidate.ssidLength != network.ssidLength ||
+                memcmp(candidate.ssid, network.ssid, network.ssidLength) != 0) {
+                continue;
+            }
+
+            // Candidates are merged by SSID, so there is one match at most
+            SavedNetworkMatch found;
+            found.index = static_cast<uint8_t>(i);
+            found.rssi = candidate.rssi;
+            found.channel = candidate.channel;
+            matches.push_back(found);
+            break;
+        }
+    }
+}
+
+void SavedNetworkSelector::rank(SavedNetworkMatchList& out) const {
+    out = matches;
+    std::sort(out.begin(), out.end(), BetterFirst(networks));
+}
+
+} // namespace WiFiSet
@@ -0,0 +1,83 @@
+#ifndef SAVED_NETWORK_SELECTOR_H
+#define SAVED_NETWORK_SELECTOR_H
+
+#include <Arduino.h>
+#include "../Protocol/MessageBuilder.h"
+
+namespace WiFiSet {
+
+// Weaker networks are tried only after every usable one
+static const int8_t MIN_USABLE_RSSI = -85;
+
+// Networks that failed this many times in a row are tried after the others
+static const uint8_t MAX_PREFERRED_FAILURES = 3;
+
+/**
+ * A saved network seen by the last scan
+ */
+struct SavedNetworkMatch {
+    uint8_t index;      // Into SavedNetworkSelector::getNetworks()
+    int8_t rssi;        // Of the strongest AP
+    uint8_t channel;
+
+    SavedNetworkMatch() : index(0), rssi(0), channel(0) {}
+};
+
+typedef FixedVector<SavedNetworkMatch, MAX_SAVED_NETWORKS> SavedNetworkMatchList;
+
+/**
+ * SavedNetworkSelector - Picks which saved network to join from a scan
+ *
+ * match() looks up every saved network in the merged scan candidates and
+ * keeps the ones in range. rank() orders them for connecting:
+ *   1. Usable signal (at least MIN_USABLE_RSSI) before weak signal
+ *   2. Fewer than MAX_PREFERRED_FAILURES failures in a row before more
+ *   3. Higher priority
+ *   4. Stronger signal
+ *   5. More recent success
+ * so a network the user preferred wins whenever it is reachable, and a
+ * network that keeps failing doesn't hold up the others.
+ *
+ * Usage:
+ *   SavedNetworkSelector selector;
+ *   selector.setNetworks(saved);
+ *   selector.match(scanCandidates);
+ *   selector.rank(order);
+ */
+class SavedNetworkSelector {
+public:
+    /**
+     * Replace the saved networks (discards the matches)
+     */
+    void setNetworks(const SavedNetworkList& saved);
+
+    /**
+     * The saved networks, in the order given to setNetworks()
+     */
+    const SavedNetworkList& getNetworks() const { return networks; }
+
+    /**
+     * Record which saved networks appear in a scan
+     * @param candidates Scan results merged by SSID (replaces earlier matches)
+     */
+    void match(const NetworkList& candidates);
+
+    /**
+     * Discard the matches
+     */
+    void clearMatches() { matches.clear(); }
+
+    /**
+     * Saved networks found by the last match(), best first
+     * @param out Replaced with one entry per saved network in range
+     */
+    void rank(SavedNetworkMatchList& out) const;
+
+private:
+    SavedNetworkList networks;
+    SavedNetworkMatchList matches;
+};
+
+} // namespace WiFiSet
+
+#endif // SAVED_NETWORK_SELECTOR_H
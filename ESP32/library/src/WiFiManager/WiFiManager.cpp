@@ -1,25 +1,63 @@
 #include "WiFiManager.h"
+#include <esp_wifi.h>
+#include <esp_system.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include <lwip/priv/tcpip_priv.h>
+#include <soc/soc_caps.h>
+#include <time.h>
 
 namespace WiFiSet {
 
-WiFiManager::WiFiManager() : lastError(""), connectionState(ConnectionState::NOT_CONFIGURED), credentialsConfigured(false) {}
-
-void WiFiManager::setError(const String& error) {
+WiFiManager::WiFiManager()
+    : lastError(Status::OK),
+      connectionState(ConnectionState::NOT_CONFIGURED),
+      credentialsConfigured(false),
+      connectPhase(ConnectPhase::IDLE),
+      connectResult(WiFiConnectResult::FAILED_UNKNOWN),
+      connectStart(0),
+      connectTimeout(0),
+      connectAuthMode(WIFI_AUTH_MAX),
+      expectedAuthMode(WIFI_AUTH_MAX),
+      lastDisconnectReason(0),
+      connectDonePending(false),
+      eventsRegistered(false),
+      cachedLeaseThisBoot(false),
+      leasePending(false),
+      usingCachedLease(false),
+      fixedAddressApplied(false),
+      scanState(ScanState::IDLE),
+      maxScanResults(DEFAULT_SCAN_TOP_K),
+      channelSlicedScan(false),
+      scanChannel(0),
+      scanSliceGap(false),
+      scanSliceEnd(0),
+      scanTimestamp(0),
+      scanCacheTTL(DEFAULT_SCAN_CACHE_TTL_MS),
+      scanCacheHits(0),
+      scanCacheMisses(0),
+      probeState(ScanState::IDLE),
+      probeHint(0),
+      probeChannel(0) {}
+
+void WiFiManager::setError(Status error) {
     lastError = error;
 }
 
 void WiFiManager::begin() {
+    if (!eventsRegistered) {
+        WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info) {
+            handleEvent(event, info);
+        });
+        eventsRegistered = true;
+    }
+
     WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false);  // Retries are paced by the caller
     WiFi.disconnect(true);  // true = erase AP config from memory
-    delay(500);  // Give WiFi stack time to fully initialize
-
-    // Wait for WiFi to be ready (status should become IDLE)
-    unsigned long startWait = millis();
-    while (WiFi.status() == WL_DISCONNECTED && millis() - startWait < 2000) {
-        delay(100);
-    }
-    Serial.printf("[WiFi] Initial status: %d\n", WiFi.status());
 
+    // No need to wait for the driver: WiFi.begin() and scans queue behind its startup
     updateConnectionState();
 }
 
@@ -42,110 +80,740 @@ SecurityType WiFiManager::convertEncryptionType(wifi_auth_mode_t authMode) {
     }
 }
 
-std::vector<WiFiNetworkInfo> WiFiManager::scanNetworks() {
-    std::vector<WiFiNetworkInfo> networks;
+const NetworkList& WiFiManager::scanNetworks() {
+    // Shares the candidate table with the asynchronous scan, and the radio with the probe
+    if (scanState == ScanState::RUNNING) {
+        cancelScan();
+    }
+    cancelProbe();
+
+    applyScanConfig();
+
+    // A partial channel mask is scanned channel by channel
+    bool perChannel = scanConfig.channelMask != 0;
+    uint8_t channel = perChannel ? nextScanChannel(0) : 0;
+    do {
+        int numNetworks = runScan(false, channel);
+        if (numNetworks < 0) {
+            setError(Status::SCAN_FAILED);
+            scanCandidates.clear();
+            return scanResults;
+        }
+        collectScanResults(numNetworks, channel, scanCandidates);
+        channel = perChannel ? nextScanChannel(channel) : 0;
+    } while (channel != 0);
+
+    finishScan();
+    return scanResults;
+}
+
+void WiFiManager::setScanConfig(const ScanConfig& config) {
+    scanConfig = config;
+
+    // Channels outside 1-13 are ignored; all of them (or none) means a full scan
+    scanConfig.channelMask &= ALL_SCAN_CHANNELS;
+    if (scanConfig.channelMask == ALL_SCAN_CHANNELS) {
+        scanConfig.channelMask = 0;
+    }
+
+    if (scanConfig.maxDwellMs > 0 && scanConfig.minDwellMs > scanConfig.maxDwellMs) {
+        scanConfig.minDwellMs = scanConfig.maxDwellMs;
+    }
+}
+
+bool WiFiManager::isPerChannelScan() const {
+    return channelSlicedScan || scanConfig.channelMask != 0;
+}
+
+uint8_t WiFiManager::nextScanChannel(uint8_t channel) const {
+    uint16_t mask = scanConfig.channelMask != 0 ? scanConfig.channelMask : ALL_SCAN_CHANNELS;
+    for (uint8_t next = channel + 1; next <= MAX_WIFI_CHANNEL; next++) {
+        if (mask & (1u << next)) {
+            return next;
+        }
+    }
+    return 0;
+}
+
+uint32_t WiFiManager::scanDwellMs(uint8_t channel) const {
+    if (scanConfig.maxDwellMs > 0) {
+        return scanConfig.maxDwellMs;
+    }
+    return (channelSlicedScan && channel != 0) ? SCAN_SLICE_DWELL_MS : DEFAULT_SCAN_DWELL_MS;
+}
+
+void WiFiManager::applyScanConfig() {
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    WiFi.setScanActiveMinTime(scanConfig.minDwellMs > 0 ? scanConfig.minDwellMs : DEFAULT_SCAN_MIN_DWELL_MS);
+#endif
+    // Older cores always use DEFAULT_SCAN_MIN_DWELL_MS
+
+#if SOC_WIFI_SUPPORT_5G
+    // The band mode also applies to connections
+    WiFi.setBandMode(scanConfig.band == ScanBand::DUAL ? WIFI_BAND_MODE_AUTO : WIFI_BAND_MODE_2G_ONLY);
+#endif
+    // 2.4 GHz-only chips ignore ScanConfig::band
+}
+
+int16_t WiFiManager::runScan(bool async, uint8_t channel) {
+    return WiFi.scanNetworks(async, scanConfig.showHidden, scanConfig.type == ScanType::PASSIVE,
+                             scanDwellMs(channel), channel);
+}
+
+void WiFiManager::setMaxScanResults(size_t k) {
+    if (k < 1) {
+        k = 1;
+    } else if (k > MAX_SCAN_CANDIDATES) {
+        k = MAX_SCAN_CANDIDATES;
+    }
+    maxScanResults = k;
+}
+
+bool WiFiManager::startScan() {
+    if (scanState == ScanState::RUNNING) {
+        return true;
+    }
+
+    // Shares the radio with the probe
+    cancelProbe();
+
+    // Previous results stay available as the cache until this scan completes
+    scanCandidates.clear();
+    scanSliceGap = false;
+    applyScanConfig();
+
+    if (isPerChannelScan()) {
+        scanChannel = nextScanChannel(0);
+        return startScanSlice();
+    }
+
+    // async = true: returns WIFI_SCAN_RUNNING immediately
+    if (runScan(true, 0) == WIFI_SCAN_FAILED) {
+        setError(Status::SCAN_FAILED);
+        scanState = ScanState::FAILED;
+        return false;
+    }
+
+    scanState = ScanState::RUNNING;
+    return true;
+}
+
+bool WiFiManager::startScanSlice() {
+    if (runScan(true, scanChannel) == WIFI_SCAN_FAILED) {
+        setError(Status::SCAN_FAILED);
+        scanState = ScanState::FAILED;
+        return false;
+    }
+
+    scanState = ScanState::RUNNING;
+    return true;
+}
+
+ScanState WiFiManager::pollScan() {
+    if (scanState != ScanState::RUNNING) {
+        return scanState;
+    }
+
+    // Between slices the radio belongs to BLE
+    if (scanSliceGap) {
+        if (millis() - scanSliceEnd < SCAN_SLICE_GAP_MS) {
+            return scanState;
+        }
+        scanSliceGap = false;
+        startScanSlice();
+        return scanState;
+    }
+
+    int result = WiFi.scanComplete();
+    if (result == WIFI_SCAN_RUNNING) {
+        return scanState;
+    }
+
+    if (result < 0) {
+        setError(Status::SCAN_FAILED);
+        scanState = ScanState::FAILED;
+        return scanState;
+    }
+
+    // A slice also hears strong APs on neighbouring channels; their own slice reports them
+    bool perChannel = isPerChannelScan();
+    collectScanResults(result, perChannel ? scanChannel : 0, scanCandidates);
+
+    uint8_t nextChannel = perChannel ? nextScanChannel(scanChannel) : 0;
+    if (nextChannel != 0) {
+        scanChannel = nextChannel;
+        if (channelSlicedScan) {
+            scanSliceGap = true;
+            scanSliceEnd = millis();
+        } else {
+            startScanSlice();
+        }
+        return scanState;
+    }
+
+    finishScan();
+    scanState = ScanState::COMPLETE;
+    return scanState;
+}
+
+void WiFiManager::finishScan() {
+    savedNetworks.match(scanCandidates.getCandidates());
+    scanCandidates.selectTop(maxScanResults, scanResults);
+    scanCandidates.clear();
 
-    // Start WiFi scan
-    int numNetworks = WiFi.scanNetworks();
+    scanTimestamp = millis();
+    if (scanTimestamp == 0) {
+        scanTimestamp = 1; // 0 means "no results"
+    }
+}
 
-    if (numNetworks == -1) {
-        setError("WiFi scan failed");
-        return networks;
+void WiFiManager::cancelScan() {
+    if (scanState == ScanState::RUNNING && !scanSliceGap) {
+        esp_wifi_scan_stop();
+        WiFi.scanDelete();
     }
+    scanSliceGap = false;
+    scanCandidates.clear();
+    scanState = ScanState::IDLE;
+}
 
-    if (numNetworks == 0) {
-        // No networks found, but not an error
-        return networks;
+bool WiFiManager::isScanCacheFresh() const {
+    return hasScanResults() && scanCacheTTL > 0 && getScanCacheAge() < scanCacheTTL;
+}
+
+bool WiFiManager::lookupScanCache() {
+    bool fresh = isScanCacheFresh();
+    if (fresh) {
+        scanCacheHits++;
+    } else {
+        scanCacheMisses++;
     }
+    return fresh;
+}
+
+unsigned long WiFiManager::getScanCacheAge() const {
+    return hasScanResults() ? millis() - scanTimestamp : 0;
+}
 
-    // Convert scan results to WiFiNetworkInfo
-    for (int i = 0; i < numNetworks && i < 50; i++) { // Limit to 50 networks
-        WiFiNetworkInfo info;
-        info.ssid = WiFi.SSID(i);
-        info.rssi = static_cast<int8_t>(WiFi.RSSI(i));
-        info.securityType = convertEncryptionType(WiFi.encryptionType(i));
-        info.channel = static_cast<uint8_t>(WiFi.channel(i));
+ScanCacheStats WiFiManager::getScanCacheStats() const {
+    ScanCacheStats stats;
+    stats.hits = scanCacheHits;
+    stats.misses = scanCacheMisses;
+    stats.ageMs = getScanCacheAge();
+    return stats;
+}
+
+void WiFiManager::collectScanResults(int count, uint8_t channel, NetworkSelector& out) {
+    // Convert scan results to WiFiNetworkInfo, merging by SSID
+    // Read the driver's records directly: WiFi.SSID(i) would build a String per AP
+    for (int i = 0; i < count; i++) {
+        const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+        if (record == nullptr) {
+            continue;
+        }
+        if (channel != 0 && record->primary != channel) {
+            continue;
+        }
 
-        networks.push_back(info);
+        WiFiNetworkInfo info = WiFiNetworkInfo();
+        const char* ssid = reinterpret_cast<const char*>(record->ssid);
+        info.setSSID(ssid, strnlen(ssid, sizeof(record->ssid)));
+        info.rssi = record->rssi;
+        info.securityType = convertEncryptionType(record->authmode);
+        info.channel = record->primary;
+        out.add(info);
     }
 
     // Clean up scan results
     WiFi.scanDelete();
-
-    return networks;
 }
 
 WiFiConnectResult WiFiManager::connect(const String& ssid, const String& password, unsigned long timeoutMs) {
+    return connectTo(ssid, password, nullptr, timeoutMs);
+}
+
+WiFiConnectResult WiFiManager::connect(const String& ssid, const String& password, const NetworkLocation& location,
+                                       unsigned long timeoutMs) {
+    return connectTo(ssid, password, location.isKnown() ? &location : nullptr, timeoutMs);
+}
+
+bool WiFiManager::startProbe(const String& ssid, uint8_t hintChannel) {
+    cancelProbe();
+    if (ssid.length() == 0) {
+        return false;
+    }
+
+    // Shares the radio with the asynchronous scan
+    if (scanState == ScanState::RUNNING) {
+        cancelScan();
+    }
+
+    probeSSID = ssid;
+    probeHint = hintChannel <= MAX_WIFI_CHANNEL ? hintChannel : 0;
+    probeChannel = nextProbeChannel(0);
+    probeResult = NetworkLocation();
+    return startProbeScan();
+}
+
+bool WiFiManager::startProbeScan() {
+    // Directed probe: only APs answering for probeSSID are reported
+    if (WiFi.scanNetworks(true, true, false, PROBE_DWELL_MS, probeChannel, probeSSID.c_str()) == WIFI_SCAN_FAILED) {
+        setError(Status::SCAN_FAILED);
+        probeState = ScanState::FAILED;
+        return false;
+    }
+
+    probeState = ScanState::RUNNING;
+    return true;
+}
+
+uint8_t WiFiManager::nextProbeChannel(uint8_t channel) const {
+    if (channel == 0) {
+        return probeHint != 0 ? probeHint : 1;
+    }
+
+    uint8_t next = channel == probeHint ? 1 : channel + 1;
+    if (next == probeHint) {
+        next++;
+    }
+    return next <= MAX_WIFI_CHANNEL ? next : 0;
+}
+
+ScanState WiFiManager::pollProbe() {
+    if (probeState != ScanState::RUNNING) {
+        return probeState;
+    }
+
+    int result = WiFi.scanComplete();
+    if (result == WIFI_SCAN_RUNNING) {
+        return probeState;
+    }
+
+    if (result < 0) {
+        setError(Status::SCAN_FAILED);
+        probeState = ScanState::FAILED;
+        return probeState;
+    }
+
+    bool found = false;
+    for (int i = 0; i < result; i++) {
+        const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+        if (record == nullptr || record->primary != probeChannel) {
+            continue;
+        }
+        if (!found || record->rssi > probeResult.rssi) {
+            memcpy(probeResult.bssid, record->bssid, sizeof(probeResult.bssid));
+            probeResult.channel = record->primary;
+            probeResult.rssi = record->rssi;
+            probeResult.authMode = record->authmode;
+            found = true;
+        }
+    }
+    WiFi.scanDelete();
+
+    if (found) {
+        Serial.printf("[WiFi] Found '%s' on channel %u (%d dBm)\n", probeSSID.c_str(), probeResult.channel,
+                      probeResult.rssi);
+        probeState = ScanState::COMPLETE;
+        return probeState;
+    }
+
+    probeChannel = nextProbeChannel(probeChannel);
+    if (probeChannel == 0) {
+        setError(Status::NETWORK_NOT_FOUND);
+        probeState = ScanState::FAILED;
+        return probeState;
+    }
+
+    startProbeScan();
+    return probeState;
+}
+
+void WiFiManager::cancelProbe() {
+    if (probeState == ScanState::RUNNING) {
+        esp_wifi_scan_stop();
+        WiFi.scanDelete();
+    }
+    probeState = ScanState::IDLE;
+}
+
+WiFiConnectResult WiFiManager::connectTo(const String& ssid, const String& password, const NetworkLocation* location,
+                                         unsigned long timeoutMs) {
+    if (!startConnect(ssid, password, location, timeoutMs)) {
+        return connectResult;
+    }
+
+    // Events arrive from the WiFi task while this waits
+    uint8_t events = ConnectEvent::NONE;
+    while (isConnecting()) {
+        events |= pollConnection();
+        delay(10);
+    }
+
+    // The caller handles the result; a new lease is still reported by the next pollConnection()
+    connectDonePending = false;
+    if (events & ConnectEvent::LEASE_UPDATED) {
+        leasePending = true;
+    }
+    return connectResult;
+}
+
+bool WiFiManager::beginConnect(const String& ssid, const String& password, unsigned long timeoutMs) {
+    return startConnect(ssid, password, nullptr, timeoutMs);
+}
+
+bool WiFiManager::beginConnect(const String& ssid, const String& password, const NetworkLocation& location,
+                               unsigned long timeoutMs) {
+    return startConnect(ssid, password, location.isKnown() ? &location : nullptr, timeoutMs);
+}
+
+bool WiFiManager::startConnect(const String& ssid, const String& password, const NetworkLocation* location,
+                               unsigned long timeoutMs) {
     if (ssid.length() == 0) {
-        setError("SSID cannot be empty");
-        return WiFiConnectResult::FAILED_UNKNOWN;
+        setError(Status::SSID_EMPTY);
+        connectResult = WiFiConnectResult::FAILED_UNKNOWN;
+        return false;
     }
 
+    // A running scan would keep the radio busy and make the connect fail
+    cancelScan();
+    cancelProbe();
+
     Serial.printf("[WiFi] Connecting to: '%s'\n", ssid.c_str());
     Serial.printf("[WiFi] Password length: %d\n", password.length());
 
-    // Ensure WiFi is in clean state
-    WiFi.disconnect(true);
+    // Events from an earlier link or attempt don't belong to this one
+    linkEvents.clear();
+
+    connectSSID = ssid;
+    connectAuthMode = WIFI_AUTH_MAX;
+    expectedAuthMode = location != nullptr ? location->authMode : WIFI_AUTH_MAX;
+    lastDisconnectReason = 0;
+    connectStart = millis();
+    connectTimeout = timeoutMs;
+    connectPhase = ConnectPhase::ASSOCIATING;
+    connectionState = ConnectionState::CONNECTING;
+
+    // WiFi.begin() leaves the current AP itself (reported as ASSOC_LEAVE)
     WiFi.mode(WIFI_STA);
+    applyIPConfig(ssid);
+    wl_status_t status;
+    if (location != nullptr) {
+        // A location from a scan match has a channel but no BSSID
+        status = WiFi.begin(ssid.c_str(), password.c_str(), location->channel,
+                            location->hasBSSID() ? location->bssid : nullptr);
+    } else {
+        status = WiFi.begin(ssid.c_str(), password.c_str());
+    }
 
-    // Wait for WiFi to be ready (IDLE status = 0)
-    unsigned long startWait = millis();
-    while (WiFi.status() != WL_IDLE_STATUS && millis() - startWait < 2000) {
-        delay(50);
+    if (status == WL_CONNECTED) {
+        // Same network as the current link: no events will follow
+        finishConnect(WiFiConnectResult::SUCCESS);
+    } else if (status == WL_CONNECT_FAILED) {
+        finishConnect(WiFiConnectResult::FAILED_UNKNOWN);
     }
-    Serial.printf("[WiFi] Pre-connect status: %d\n", WiFi.status());
+    return true;
+}
 
-    // Update state to connecting
-    connectionState = ConnectionState::CONNECTING;
+void WiFiManager::handleEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    // Runs on the WiFi event task: only record the event for pollConnection()
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            linkEvents.push(LinkEvent(LinkEvent::STA_CONNECTED, static_cast<uint8_t>(info.wifi_sta_connected.authmode)));
+            break;
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            linkEvents.push(LinkEvent(LinkEvent::GOT_IP, 0));
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            linkEvents.push(LinkEvent(LinkEvent::DISCONNECTED, info.wifi_sta_disconnected.reason));
+            break;
+        default:
+            break;
+    }
+}
 
-    // Start connection
-    Serial.println("[WiFi] Calling WiFi.begin()...");
-    WiFi.begin(ssid.c_str(), password.c_str());
-
-    // Wait for connection with timeout
-    unsigned long startTime = millis();
-    while (WiFi.status() != WL_CONNECTED) {
-        if (millis() - startTime > timeoutMs) {
-            Serial.printf("[WiFi] Timeout after %lu ms\n", timeoutMs);
-            setError("Connection timeout");
-            connectionState = ConnectionState::CONNECTION_FAILED;
-            WiFi.disconnect();
-            return WiFiConnectResult::FAILED_TIMEOUT;
-        }
+uint8_t WiFiManager::pollConnection() {
+    uint8_t events = ConnectEvent::NONE;
 
-        // Check for specific failure reasons
-        wl_status_t status = WiFi.status();
-        if (status == WL_CONNECT_FAILED) {
-            Serial.println("[WiFi] WL_CONNECT_FAILED - wrong password?");
-            setError("Connection failed - wrong password or network issue");
-            connectionState = ConnectionState::CONNECTION_FAILED;
-            WiFi.disconnect();
-            return WiFiConnectResult::FAILED_WRONG_PASSWORD;
-        } else if (status == WL_NO_SSID_AVAIL) {
-            Serial.println("[WiFi] WL_NO_SSID_AVAIL - network not found");
-            setError("Network not found");
-            connectionState = ConnectionState::CONNECTION_FAILED;
-            WiFi.disconnect();
-            return WiFiConnectResult::FAILED_NOT_FOUND;
+    uint32_t dropped = linkEvents.takeDropped();
+    if (dropped > 0) {
+        Serial.printf("[WiFi] %u events lost (queue full)\n", static_cast<unsigned>(dropped));
+    }
+
+    // Replay in the order the driver reported them
+    LinkEvent event;
+    while (linkEvents.pop(event)) {
+        switch (event.type) {
+            case LinkEvent::STA_CONNECTED:
+                events |= ConnectEvent::STA_CONNECTED;
+                connectAuthMode = static_cast<wifi_auth_mode_t>(event.detail);
+                if (connectPhase == ConnectPhase::ASSOCIATING) {
+                    connectPhase = ConnectPhase::OBTAINING_IP;
+
+                    // A pinned AP that changed its security is not the one we knew
+                    if (expectedAuthMode != WIFI_AUTH_MAX && connectAuthMode != expectedAuthMode) {
+                        Serial.printf("[WiFi] Auth mode changed (%d, expected %d)\n", connectAuthMode,
+                                      expectedAuthMode);
+                        finishConnect(WiFiConnectResult::FAILED_UNKNOWN);
+                    }
+                }
+                break;
+
+            case LinkEvent::GOT_IP:
+                events |= ConnectEvent::GOT_IP;
+                if (isConnecting()) {
+                    finishConnect(WiFiConnectResult::SUCCESS);
+                }
+                if (!fixedAddressApplied) {
+                    recordLease();
+                }
+                break;
+
+            case LinkEvent::DISCONNECTED: {
+                uint8_t reason = event.detail;
+
+                // ASSOC_LEAVE without a link is our own WiFi.begin() or WiFi.disconnect()
+                if (reason != WIFI_REASON_ASSOC_LEAVE || connectPhase == ConnectPhase::CONNECTED) {
+                    lastDisconnectReason = reason;
+                    events |= ConnectEvent::DISCONNECTED;
+                    Serial.printf("[WiFi] Disconnected, reason %u\n", reason);
+
+                    if (isConnecting()) {
+                        finishConnect(resultForReason(reason));
+                    } else if (connectPhase == ConnectPhase::CONNECTED) {
+                        connectPhase = ConnectPhase::IDLE;
+                        events |= ConnectEvent::LINK_LOST;
+                    }
+                }
+                break;
+            }
         }
+    }
+
+    if (isConnecting() && millis() - connectStart > connectTimeout) {
+        Serial.printf("[WiFi] Timeout after %lu ms\n", connectTimeout);
+        finishConnect(WiFiConnectResult::FAILED_TIMEOUT);
+    }
+
+    checkLeaseRenewal();
 
-        // Print status every second
-        static unsigned long lastPrint = 0;
-        if (millis() - lastPrint > 1000) {
-            Serial.printf("[WiFi] Status: %d, waiting...\n", status);
-            lastPrint = millis();
+    // Also covers an attempt that finished inside beginConnect()
+    if (connectDonePending) {
+        connectDonePending = false;
+        events |= ConnectEvent::CONNECT_DONE;
+    }
+
+    if (leasePending) {
+        leasePending = false;
+        events |= ConnectEvent::LEASE_UPDATED;
+    }
+
+    return events;
+}
+
+void WiFiManager::finishConnect(WiFiConnectResult result) {
+    connectResult = result;
+    connectDonePending = true;
+
+    if (result == WiFiConnectResult::SUCCESS) {
+        Serial.printf("[WiFi] Connected in %lu ms! IP: %s\n", millis() - connectStart,
+                      WiFi.localIP().toString().c_str());
+
+        // Reported by getLastLocation()
+        const uint8_t* bssid = WiFi.BSSID();
+        if (bssid != nullptr) {
+            memcpy(lastLocation.bssid, bssid, sizeof(lastLocation.bssid));
         }
+        lastLocation.channel = static_cast<uint8_t>(WiFi.channel());
+        lastLocation.rssi = static_cast<int8_t>(WiFi.RSSI());
+        lastLocation.authMode = connectAuthMode;
+        lastLocationSSID = connectSSID;
+
+        connectPhase = ConnectPhase::CONNECTED;
+        connectionState = ConnectionState::CONNECTED;
+        return;
+    }
+
+    switch (result) {
+        case WiFiConnectResult::FAILED_NOT_FOUND:
+            setError(Status::NETWORK_NOT_FOUND);
+            break;
+        case WiFiConnectResult::FAILED_TIMEOUT:
+            setError(Status::CONNECT_TIMEOUT);
+            break;
+        default:
+            setError(Status::CONNECT_FAILED);
+            break;
+    }
+
+    connectPhase = ConnectPhase::FAILED;
+    connectionState = ConnectionState::CONNECTION_FAILED;
+
+    // Stop the driver retrying on its own
+    WiFi.disconnect();
+}
+
+void WiFiManager::setCachedLease(const String& ssid, const DhcpLease& saved) {
+    cachedLease = saved;
+    cachedLeaseSSID = ssid;
+    cachedLeaseThisBoot = false;
+}
 
-        delay(100);
+void WiFiManager::applyIPConfig(const String& ssid) {
+    usingCachedLease = false;
+
+    if (ipConfig.isStatic) {
+        applyFixedAddress(ipConfig.address, ipConfig.gateway, ipConfig.subnet, ipConfig.dns1, ipConfig.dns2);
+        return;
+    }
+
+    if (isCachedLeaseCurrent(ssid)) {
+        Serial.printf("[WiFi] Reusing DHCP lease %s for %lu s\n", cachedLease.address.toString().c_str(),
+                      static_cast<unsigned long>(cachedLease.renewAt - time(nullptr)));
+        applyFixedAddress(cachedLease.address, cachedLease.gateway, cachedLease.subnet,
+                          cachedLease.dns1, cachedLease.dns2);
+        usingCachedLease = true;
+        return;
     }
 
-    // Connection successful
-    Serial.printf("[WiFi] Connected! IP: %s\n", WiFi.localIP().toString().c_str());
-    connectionState = ConnectionState::CONNECTED;
-    return WiFiConnectResult::SUCCESS;
+    // Passing no address restarts the DHCP client
+    if (fixedAddressApplied) {
+        WiFi.config(IPAddress(), IPAddress(), IPAddress());
+        fixedAddressApplied = false;
+    }
+}
+
+void WiFiManager::applyFixedAddress(const IPAddress& address, const IPAddress& gateway, const IPAddress& subnet,
+                                    const IPAddress& dns1, const IPAddress& dns2) {
+    // Most networks serve DNS from the gateway
+    IPAddress primaryDNS = static_cast<uint32_t>(dns1) != 0 ? dns1 : gateway;
+    if (!WiFi.config(address, gateway, subnet, primaryDNS, dns2)) {
+        Serial.println("[WiFi] Could not set a fixed address, using DHCP");
+        return;
+    }
+    fixedAddressApplied = true;
+}
+
+bool WiFiManager::isCachedLeaseCurrent(const String& ssid) const {
+    if (!cachedLease.isValid() || ssid != cachedLeaseSSID) {
+        return false;
+    }
+
+    // After a power-on reset the clock starts again at 0 and can't date a saved lease
+    if (!cachedLeaseThisBoot && !isClockContinuous()) {
+        return false;
+    }
+
+    uint32_t now = static_cast<uint32_t>(time(nullptr));
+    return now >= cachedLease.obtainedAt && now < cachedLease.renewAt;
+}
+
+void WiFiManager::recordLease() {
+    uint32_t renewSeconds = dhcpRenewSeconds();
+    if (renewSeconds == 0) {
+        return;
+    }
+    if (renewSeconds > MAX_LEASE_REUSE_S) {
+        renewSeconds = MAX_LEASE_REUSE_S;
+    }
+
+    uint32_t now = static_cast<uint32_t>(time(nullptr));
+    lease.address = WiFi.localIP();
+    lease.subnet = WiFi.subnetMask();
+    lease.gateway = WiFi.gatewayIP();
+    lease.dns1 = WiFi.dnsIP(0);
+    lease.dns2 = WiFi.dnsIP(1);
+    lease.obtainedAt = now;
+    lease.renewAt = now + renewSeconds;
+    leaseSSID = WiFi.SSID();
+    leasePending = true;
+
+    // Later connects to this network this boot can reuse it too
+    cachedLease = lease;
+    cachedLeaseSSID = leaseSSID;
+    cachedLeaseThisBoot = true;
+}
+
+void WiFiManager::checkLeaseRenewal() {
+    if (!usingCachedLease || connectPhase != ConnectPhase::CONNECTED) {
+        return;
+    }
+
+    if (static_cast<uint32_t>(time(nullptr)) < cachedLease.renewAt) {
+        return;
+    }
+
+    // Past T1 the address must be renewed with the server: let DHCP take over
+    Serial.println("[WiFi] Cached lease due for renewal, starting DHCP");
+    usingCachedLease = false;
+    fixedAddressApplied = false;
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+}
+
+namespace {
+
+// Reads the DHCP client's lease on the tcpip thread, which owns struct dhcp
+struct DhcpRenewCall {
+    struct tcpip_api_call_data call;    // Must be first (passed to tcpip_api_call)
+    struct netif* lwipNetif;
+    uint32_t renewSeconds;
+};
+
+err_t readDhcpRenew(struct tcpip_api_call_data* call) {
+    DhcpRenewCall* request = reinterpret_cast<DhcpRenewCall*>(call);
+    struct dhcp* client = netif_dhcp_data(request->lwipNetif);
+    if (client != nullptr && client->state == DHCP_STATE_BOUND) {
+        request->renewSeconds = client->offered_t1_renew;
+    }
+    return ERR_OK;
+}
+
+} // namespace
+
+uint32_t WiFiManager::dhcpRenewSeconds() {
+    esp_netif_t* staNetif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (staNetif == nullptr) {
+        return 0;
+    }
+
+    struct netif* lwipNetif = static_cast<struct netif*>(esp_netif_get_netif_impl(staNetif));
+    if (lwipNetif == nullptr) {
+        return 0;
+    }
+
+    // Read once right after GOT_IP, while the client sits in BOUND
+    DhcpRenewCall request = {};
+    request.lwipNetif = lwipNetif;
+    request.renewSeconds = 0;
+    if (tcpip_api_call(readDhcpRenew, &request.call) != ERR_OK) {
+        return 0;
+    }
+    return request.renewSeconds;
+}
+
+bool WiFiManager::isClockContinuous() {
+    esp_reset_reason_t reason = esp_reset_reason();
+    return reason == ESP_RST_DEEPSLEEP || reason == ESP_RST_SW;
+}
+
+WiFiConnectResult WiFiManager::resultForReason(uint8_t reason) {
+    switch (reason) {
+        case WIFI_REASON_NO_AP_FOUND:
+            return WiFiConnectResult::FAILED_NOT_FOUND;
+        case WIFI_REASON_AUTH_FAIL:
+        case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_HANDSHAKE_TIMEOUT:
+            return WiFiConnectResult::FAILED_WRONG_PASSWORD;
+        default:
+            return WiFiConnectResult::FAILED_UNKNOWN;
+    }
 }
 
 void WiFiManager::disconnect() {
+    // The ASSOC_LEAVE that follows is then not taken for a lost link
+    if (isConnecting() || connectPhase == ConnectPhase::CONNECTED) {
+        connectPhase = ConnectPhase::IDLE;
+    }
     WiFi.disconnect();
     updateConnectionState();
 }
@@ -155,7 +823,9 @@ bool WiFiManager::isConnected() {
 }
 
 void WiFiManager::updateConnectionState() {
-    if (WiFi.status() == WL_CONNECTED) {
+    if (isConnecting()) {
+        connectionState = ConnectionState::CONNECTING;
+    } else if (WiFi.status() == WL_CONNECTED) {
         connectionState = ConnectionState::CONNECTED;
     } else if (credentialsConfigured) {
         // Credentials are saved in NVS but not currently connected
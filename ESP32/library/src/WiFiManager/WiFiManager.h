@@ -3,8 +3,11 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <vector>
 #include "../Protocol/MessageBuilder.h"
+#include "../Protocol/Status.h"
+#include "NetworkSelector.h"
+#include "SavedNetworkSelector.h"
+#include "LinkEventQueue.h"
 
 namespace WiFiSet {
 
@@ -19,10 +22,183 @@ enum class WiFiConnectResult {
     FAILED_UNKNOWN
 };
 
+/**
+ * Progress of an asynchronous connect (see beginConnect())
+ */
+enum class ConnectPhase : uint8_t {
+    IDLE,           // No attempt running and no link up
+    ASSOCIATING,    // WiFi.begin() called, waiting for STA_CONNECTED
+    OBTAINING_IP,   // Associated, waiting for GOT_IP
+    CONNECTED,      // Last attempt succeeded and the link is up
+    FAILED          // Last attempt failed (see getConnectResult())
+};
+
+/**
+ * WiFi events handled by pollConnection() (bit mask)
+ */
+namespace ConnectEvent {
+    static const uint8_t NONE = 0x00;
+    static const uint8_t STA_CONNECTED = 0x01;  // Associated with the AP
+    static const uint8_t GOT_IP = 0x02;         // DHCP finished
+    static const uint8_t DISCONNECTED = 0x04;   // Link lost or attempt rejected (see getLastDisconnectReason())
+    static const uint8_t CONNECT_DONE = 0x08;   // Attempt finished (see getConnectResult())
+    static const uint8_t LEASE_UPDATED = 0x10;  // DHCP granted a new lease (see getLease())
+    static const uint8_t LINK_LOST = 0x20;      // An established link dropped (not through disconnect())
+}
+
+/**
+ * Asynchronous scan state
+ */
+enum class ScanState {
+    IDLE,       // No scan started (or results consumed)
+    RUNNING,    // Scan in progress
+    COMPLETE,   // Results available via getScanResults()
+    FAILED      // Scan failed (see getLastError())
+};
+
+/**
+ * Scan cache metrics (for tuning the cache TTL)
+ */
+struct ScanCacheStats {
+    uint32_t hits;          // Client requests served from a fresh cache
+    uint32_t misses;        // Client requests that needed a new scan
+    unsigned long ageMs;    // Age of the cached results (0 if none)
+
+    ScanCacheStats() : hits(0), misses(0), ageMs(0) {}
+
+    /**
+     * Fraction of requests served from cache (0.0 - 1.0)
+     */
+    float hitRate() const {
+        uint32_t total = hits + misses;
+        return total > 0 ? static_cast<float>(hits) / total : 0.0f;
+    }
+};
+
+// Default lifetime of cached scan results
+static const unsigned long DEFAULT_SCAN_CACHE_TTL_MS = 30000;
+
+// Channel-sliced scanning: one channel per step, radio returned to BLE in between
+static const uint8_t MAX_WIFI_CHANNEL = 13;
+static const uint32_t SCAN_SLICE_DWELL_MS = 120;
+static const uint32_t DEFAULT_SCAN_DWELL_MS = 300;       // Arduino core default
+static const uint32_t DEFAULT_SCAN_MIN_DWELL_MS = 100;   // Arduino core default (active scans)
+static const unsigned long SCAN_SLICE_GAP_MS = 100;
+
+// Bits 1-13 of a ScanConfig channel mask
+static const uint16_t ALL_SCAN_CHANNELS = ((1u << (MAX_WIFI_CHANNEL + 1)) - 1) & ~1u;
+
+// Targeted probe for a known network: dwell per channel
+static const uint32_t PROBE_DWELL_MS = 40;
+
+/**
+ * Where a known network was found (targeted probe or last connection)
+ */
+struct NetworkLocation {
+    uint8_t bssid[6];
+    uint8_t channel;            // 0 = unknown
+    int8_t rssi;
+    wifi_auth_mode_t authMode;  // WIFI_AUTH_MAX = unknown
+
+    NetworkLocation() : channel(0), rssi(0), authMode(WIFI_AUTH_MAX) { memset(bssid, 0, sizeof(bssid)); }
+
+    bool isKnown() const { return channel != 0; }
+
+    /**
+     * Check if the location names an AP (a channel alone still skips the all-channel search)
+     */
+    bool hasBSSID() const {
+        static const uint8_t NONE[6] = {0, 0, 0, 0, 0, 0};
+        return memcmp(bssid, NONE, sizeof(bssid)) != 0;
+    }
+};
+
+/**
+ * How the station gets its address
+ */
+struct IPConfig {
+    bool isStatic;          // false = DHCP
+    IPAddress address;      // Static settings (unused for DHCP)
+    IPAddress subnet;
+    IPAddress gateway;
+    IPAddress dns1;         // 0.0.0.0 = use the gateway
+    IPAddress dns2;
+
+    IPConfig() : isStatic(false) {}
+};
+
+/**
+ * An address granted by DHCP
+ * Times are time() seconds. The system clock keeps running through deep
+ * sleep and software resets, so a lease saved before sleeping can be dated
+ * after waking up.
+ */
+struct DhcpLease {
+    IPAddress address;
+    IPAddress subnet;
+    IPAddress gateway;
+    IPAddress dns1;
+    IPAddress dns2;
+    uint32_t obtainedAt;
+    uint32_t renewAt;       // Renewal time (T1); 0 = no lease
+
+    DhcpLease() : obtainedAt(0), renewAt(0) {}
+
+    bool isValid() const { return renewAt != 0; }
+};
+
+// Longest a lease is reused without asking the DHCP server (caps infinite leases)
+static const uint32_t MAX_LEASE_REUSE_S = 24UL * 60 * 60;
+
+/**
+ * How a scan probes each channel
+ */
+enum class ScanType : uint8_t {
+    ACTIVE,     // Send probe requests (fast, finds most networks quickly)
+    PASSIVE     // Only listen for beacons (slower, needed where probing is restricted)
+};
+
+/**
+ * Which bands a scan covers
+ */
+enum class ScanBand : uint8_t {
+    BAND_2G4,   // 2.4 GHz only
+    DUAL        // 2.4 GHz and 5 GHz on chips with a 5 GHz radio, else 2.4 GHz
+};
+
+/**
+ * Scan parameters
+ *
+ * Short dwell times finish quickly but miss APs with long beacon intervals
+ * or busy channels; long dwell times are more complete but hold the radio
+ * (and the BLE link) longer. Dense deployments usually want active scans
+ * with a short dwell; quiet or sparse sites can afford longer dwells.
+ */
+struct ScanConfig {
+    ScanType type;
+    uint32_t minDwellMs;    // Active scans: minimum time per channel (0 = driver default)
+    uint32_t maxDwellMs;    // Maximum time per channel (0 = default, SCAN_SLICE_DWELL_MS when sliced)
+    uint16_t channelMask;   // Bit n scans 2.4 GHz channel n (1-13); 0 = all channels
+    bool showHidden;        // Report networks that hide their SSID
+    ScanBand band;
+
+    ScanConfig()
+        : type(ScanType::ACTIVE),
+          minDwellMs(0),
+          maxDwellMs(0),
+          channelMask(0),
+          showHidden(false),
+          band(ScanBand::BAND_2G4) {}
+};
+
 /**
  * WiFiManager - Manages WiFi scanning and connections
  *
  * Handles WiFi network scanning, connection management, and status monitoring.
+ * Connection progress comes from WiFi.onEvent(): events are recorded on the
+ * WiFi task and applied by pollConnection() from the main loop.
+ * Scan candidates and results live in fixed-size tables inside the manager,
+ * so scanning does not allocate beyond the driver's own scan buffer.
  */
 class WiFiManager {
 public:
@@ -30,18 +206,154 @@ public:
 
     /**
      * Initialize WiFi
-     * Sets WiFi mode to STA (station mode)
+     * Sets WiFi mode to STA (station mode) and turns off the driver's
+     * immediate auto-reconnect: a lost link is reported as
+     * ConnectEvent::LINK_LOST and retried by the caller (see ReconnectSupervisor).
      */
     void begin();
 
     /**
-     * Scan for available WiFi networks
-     * @return Vector of discovered networks
+     * Scan for available WiFi networks (blocking)
+     * The results replace the scan cache.
+     * @return One entry per SSID, strongest first (at most getMaxScanResults())
+     */
+    const NetworkList& scanNetworks();
+
+    /**
+     * Start an asynchronous scan and return immediately
+     * Poll with pollScan() from the main loop. If a scan is already running
+     * it is left to finish.
+     * @return false if the scan could not be started
+     */
+    bool startScan();
+
+    /**
+     * Check progress of the asynchronous scan
+     * On completion the merged networks are ranked into getScanResults() and
+     * the driver's scan buffer is released.
+     * @return Current scan state
      */
-    std::vector<WiFiNetworkInfo> scanNetworks();
+    ScanState pollScan();
 
     /**
-     * Connect to WiFi network
+     * Abort a running asynchronous scan (e.g. before connecting)
+     */
+    void cancelScan();
+
+    /**
+     * Get the current asynchronous scan state without polling the driver
+     */
+    ScanState getScanState() const { return scanState; }
+
+    /**
+     * Scan one channel per step instead of all channels at once
+     * Each step holds the radio for about SCAN_SLICE_DWELL_MS, then leaves it
+     * to BLE for SCAN_SLICE_GAP_MS. Results found so far are available from
+     * getPartialScanResults() while the scan runs.
+     * @param enabled true for channel-sliced scans (default: false)
+     */
+    void setChannelSlicedScan(bool enabled) { channelSlicedScan = enabled; }
+
+    /**
+     * Check if channel-sliced scanning is enabled
+     */
+    bool isChannelSlicedScan() const { return channelSlicedScan; }
+
+    /**
+     * Set the scan parameters used by scanNetworks() and startScan()
+     * Takes effect from the next scan. A channel mask that selects only some
+     * channels scans them one at a time (without the BLE gap unless
+     * channel-sliced scanning is enabled) and skips 5 GHz.
+     */
+    void setScanConfig(const ScanConfig& config);
+
+    /**
+     * Get the scan parameters
+     */
+    const ScanConfig& getScanConfig() const { return scanConfig; }
+
+    /**
+     * Networks found so far by the running scan, merged by SSID
+     * In discovery order and not yet ranked: getScanResults() is re-ordered
+     * and trimmed to the strongest networks when the scan completes.
+     */
+    const NetworkList& getPartialScanResults() const { return scanCandidates.getCandidates(); }
+
+    /**
+     * Results of the last completed asynchronous scan, strongest first
+     * Kept as the scan cache until the next scan completes.
+     */
+    const NetworkList& getScanResults() const { return scanResults; }
+
+    /**
+     * Set the saved networks each completed scan is matched against
+     * See rankSavedNetworks().
+     */
+    void setSavedNetworks(const SavedNetworkList& saved) { savedNetworks.setNetworks(saved); }
+
+    /**
+     * Saved networks given to setSavedNetworks()
+     */
+    const SavedNetworkList& getSavedNetworks() const { return savedNetworks.getNetworks(); }
+
+    /**
+     * Saved networks seen by the last completed scan, best first (see SavedNetworkSelector)
+     * Matched before the scan is trimmed to getMaxScanResults(), so a saved
+     * network with a weak signal in a crowded scan is still found.
+     */
+    void rankSavedNetworks(SavedNetworkMatchList& out) const { savedNetworks.rank(out); }
+
+    /**
+     * Set how many networks a scan reports
+     * Networks are merged by SSID first, then the strongest k are kept.
+     * @param k Maximum networks per scan (1 - MAX_SCAN_CANDIDATES, default DEFAULT_SCAN_TOP_K)
+     */
+    void setMaxScanResults(size_t k);
+
+    /**
+     * Get the maximum number of networks a scan reports
+     */
+    size_t getMaxScanResults() const { return maxScanResults; }
+
+    /**
+     * Set how long scan results stay fresh
+     * @param ttlMs Cache lifetime in milliseconds (0 disables caching)
+     */
+    void setScanCacheTTL(unsigned long ttlMs) { scanCacheTTL = ttlMs; }
+
+    /**
+     * Get the scan cache lifetime
+     */
+    unsigned long getScanCacheTTL() const { return scanCacheTTL; }
+
+    /**
+     * Check if a completed scan is cached (fresh or not)
+     */
+    bool hasScanResults() const { return scanTimestamp != 0; }
+
+    /**
+     * Check if the cached results are younger than the TTL
+     */
+    bool isScanCacheFresh() const;
+
+    /**
+     * Look up the cache on behalf of a client, counting a hit or miss
+     * @return true if the cached results are fresh
+     */
+    bool lookupScanCache();
+
+    /**
+     * Get age of the cached results in milliseconds (0 if none)
+     */
+    unsigned long getScanCacheAge() const;
+
+    /**
+     * Get cache hit/miss counters and current age
+     */
+    ScanCacheStats getScanCacheStats() const;
+
+    /**
+     * Connect to WiFi network (blocks until the attempt finishes)
      * @param ssid Network name
      * @param password Network password (empty for open networks)
      * @param timeoutMs Connection timeout in milliseconds (default 10000)
@@ -49,8 +361,141 @@ public:
      */
     WiFiConnectResult connect(const String& ssid, const String& password, unsigned long timeoutMs = 10000);
 
+    /**
+     * Start connecting and return immediately
+     * Drive the attempt with pollConnection() from the main loop; it ends
+     * with ConnectEvent::CONNECT_DONE and getConnectResult().
+     * @return false if the attempt could not start (e.g. empty SSID)
+     */
+    bool beginConnect(const String& ssid, const String& password, unsigned long timeoutMs = 10000);
+
+    /**
+     * Start connecting to a specific AP and return immediately
+     * @param location BSSID and channel of the AP (e.g. from getProbeResult()); a
+     *                 known authMode must match or the attempt fails once associated
+     */
+    bool beginConnect(const String& ssid, const String& password, const NetworkLocation& location,
+                      unsigned long timeoutMs = 10000);
+
+    /**
+     * Apply WiFi events received since the last call and check the timeout
+     * @return ConnectEvent bits for what happened
+     */
+    uint8_t pollConnection();
+
+    /**
+     * Get the progress of the current or last connect attempt
+     */
+    ConnectPhase getConnectPhase() const { return connectPhase; }
+
+    /**
+     * Check if a connect attempt is running
+     */
+    bool isConnecting() const {
+        return connectPhase == ConnectPhase::ASSOCIATING || connectPhase == ConnectPhase::OBTAINING_IP;
+    }
+
+    /**
+     * SSID of the current or last connect attempt
+     */
+    const String& getConnectSSID() const { return connectSSID; }
+
+    /**
+     * Result of the last finished connect attempt
+     */
+    WiFiConnectResult getConnectResult() const { return connectResult; }
+
+    /**
+     * WiFi reason code of the last disconnect (wifi_err_reason_t, 0 = none)
+     */
+    uint8_t getLastDisconnectReason() const { return lastDisconnectReason; }
+
+    /**
+     * Connect to a specific AP
+     * Skips the driver's own all-channel search for the SSID.
+     * @param location BSSID and channel of the AP (e.g. from getProbeResult())
+     */
+    WiFiConnectResult connect(const String& ssid, const String& password, const NetworkLocation& location,
+                              unsigned long timeoutMs = 10000);
+
+    /**
+     * Start looking for one network, channel by channel, and return immediately
+     * Sends directed probes for ssid on hintChannel first, then on the other
+     * channels, one asynchronous scan per channel. Each channel takes about
+     * PROBE_DWELL_MS, so a network that is still on its last channel is
+     * found in tens of milliseconds. Poll with pollProbe() from the main
+     * loop. Cancels a running asynchronous scan; startScan() and connects
+     * cancel the probe in turn.
+     * @param hintChannel Channel to try first (0 = start at channel 1)
+     * @return false if the probe could not be started
+     */
+    bool startProbe(const String& ssid, uint8_t hintChannel);
+
+    /**
+     * Check progress of the probe, starting the next channel's scan if needed
+     * @return RUNNING, COMPLETE once the network was found (see
+     *         getProbeResult()), FAILED if no channel had it or a scan failed,
+     *         IDLE if nothing was started or the probe was cancelled
+     */
+    ScanState pollProbe();
+
+    /**
+     * Abort a running probe
+     */
+    void cancelProbe();
+
+    /**
+     * Strongest matching AP on the first channel the probe saw the network on
+     */
+    const NetworkLocation& getProbeResult() const { return probeResult; }
+
+    /**
+     * AP and channel of the last successful connection (see getLastLocationSSID())
+     */
+    const NetworkLocation& getLastLocation() const { return lastLocation; }
+
+    /**
+     * SSID of the last successful connection
+     */
+    const String& getLastLocationSSID() const { return lastLocationSSID; }
+
+    /**
+     * Set how the station gets its address (takes effect from the next connect)
+     */
+    void setIPConfig(const IPConfig& config) { ipConfig = config; }
+
+    /**
+     * Get the address settings
+     */
+    const IPConfig& getIPConfig() const { return ipConfig; }
+
+    /**
+     * Reuse a saved DHCP lease when connecting to ssid
+     * Until its renewal time the leased address is configured directly, so
+     * the connect finishes without a DHCP exchange. Once the lease reaches
+     * its renewal time, or if the clock can't date it (power-on reset), the
+     * connect uses DHCP as usual. Ignored with a static IPConfig.
+     */
+    void setCachedLease(const String& ssid, const DhcpLease& lease);
+
+    /**
+     * Lease granted by the last DHCP exchange this boot (see ConnectEvent::LEASE_UPDATED)
+     */
+    const DhcpLease& getLease() const { return lease; }
+
+    /**
+     * SSID of the network that granted getLease()
+     */
+    const String& getLeaseSSID() const { return leaseSSID; }
+
+    /**
+     * Check if the current link uses a cached lease instead of DHCP
+     */
+    bool isUsingCachedLease() const { return usingCachedLease; }
+
     /**
      * Disconnect from WiFi
+     * Not reported as ConnectEvent::LINK_LOST.
      */
     void disconnect();
 
@@ -85,9 +530,9 @@ public:
     String getSSID();
 
     /**
-     * Get last error message
+     * Get the status of the last failed scan or connect
      */
-    const String& getLastError() const { return lastError; }
+    Status getLastError() const { return lastError; }
 
     /**
      * Convert ESP32 WiFi encryption type to protocol security type
@@ -106,15 +551,176 @@ public:
     String getConfiguredSSID() const { return configuredSSID; }
 
 private:
-    String lastError;
+    Status lastError;
     String configuredSSID;
+    NetworkLocation lastLocation;   // Of the last successful connection
+    String lastLocationSSID;
     ConnectionState connectionState;
     bool credentialsConfigured;
+    ConnectPhase connectPhase;
+    WiFiConnectResult connectResult;
+    unsigned long connectStart;
+    unsigned long connectTimeout;
+    String connectSSID;
+    wifi_auth_mode_t connectAuthMode;       // Reported by STA_CONNECTED
+    wifi_auth_mode_t expectedAuthMode;      // From the location (WIFI_AUTH_MAX = any)
+    uint8_t lastDisconnectReason;
+    bool connectDonePending;        // CONNECT_DONE not yet returned by pollConnection()
+    bool eventsRegistered;
+    IPConfig ipConfig;
+    DhcpLease cachedLease;          // Offered for reuse by setCachedLease() or the last DHCP exchange
+    String cachedLeaseSSID;
+    bool cachedLeaseThisBoot;       // Dated by this boot's clock
+    DhcpLease lease;                // From the last DHCP exchange
+    String leaseSSID;
+    bool leasePending;              // LEASE_UPDATED not yet returned by pollConnection()
+    bool usingCachedLease;
+    bool fixedAddressApplied;       // WiFi.config() set an address (DHCP client stopped)
+
+    // Filled on the WiFi event task, drained in order by pollConnection()
+    LinkEventQueue linkEvents;
+    ScanState scanState;
+    NetworkList scanResults;
+    NetworkSelector scanCandidates;
+    SavedNetworkSelector savedNetworks;
+    size_t maxScanResults;
+    bool channelSlicedScan;
+    ScanConfig scanConfig;
+    uint8_t scanChannel;            // Channel of the current slice
+    bool scanSliceGap;              // Waiting between slices
+    unsigned long scanSliceEnd;
+    unsigned long scanTimestamp;    // millis() when scanResults completed (0 = none)
+    unsigned long scanCacheTTL;
+    uint32_t scanCacheHits;
+    uint32_t scanCacheMisses;
+    ScanState probeState;
+    String probeSSID;
+    uint8_t probeHint;              // Channel probed first (0 = none)
+    uint8_t probeChannel;           // Channel of the running probe scan
+    NetworkLocation probeResult;
+
+    /**
+     * Start the scan for scanChannel
+     */
+    bool startScanSlice();
+
+    /**
+     * Start the directed probe scan for probeChannel
+     */
+    bool startProbeScan();
+
+    /**
+     * Channel to probe after channel: the hint first, then 1..MAX_WIFI_CHANNEL
+     * without the hint (0 = start, returns 0 when none are left)
+     */
+    uint8_t nextProbeChannel(uint8_t channel) const;
+
+    /**
+     * Check if the scan runs one channel at a time
+     * True for channel-sliced scans and for a channel mask that leaves out channels
+     */
+    bool isPerChannelScan() const;
+
+    /**
+     * Next channel in the scan's channel mask after channel (0 = none left)
+     */
+    uint8_t nextScanChannel(uint8_t channel) const;
+
+    /**
+     * Maximum dwell per channel for a scan of channel (0 = all channels)
+     */
+    uint32_t scanDwellMs(uint8_t channel) const;
+
+    /**
+     * Apply the ScanConfig settings the driver takes outside scanNetworks()
+     */
+    void applyScanConfig();
+
+    /**
+     * Start a driver scan of one channel (0 = all channels) with the ScanConfig
+     * @return Driver result (WIFI_SCAN_FAILED, WIFI_SCAN_RUNNING or a network count)
+     */
+    int16_t runScan(bool async, uint8_t channel);
+
+    /**
+     * Rank the merged candidates into scanResults and stamp the cache
+     */
+    void finishScan();
+
+    /**
+     * Merge the driver's scan results into out and free them
+     * @param channel Only keep APs on this channel (0 = all channels)
+     */
+    void collectScanResults(int count, uint8_t channel, NetworkSelector& out);
+
+    /**
+     * Shared body of the connect() overloads (location may be null)
+     */
+    WiFiConnectResult connectTo(const String& ssid, const String& password, const NetworkLocation* location,
+                                unsigned long timeoutMs);
+
+    /**
+     * Shared body of the beginConnect() overloads (location may be null)
+     */
+    bool startConnect(const String& ssid, const String& password, const NetworkLocation* location,
+                      unsigned long timeoutMs);
+
+    /**
+     * WiFi.onEvent() handler (runs on the WiFi event task)
+     */
+    void handleEvent(arduino_event_id_t event, arduino_event_info_t info);
+
+    /**
+     * End the running attempt with result
+     */
+    void finishConnect(WiFiConnectResult result);
+
+    /**
+     * Configure a static address, the cached lease, or DHCP for a connect to ssid
+     */
+    void applyIPConfig(const String& ssid);
+
+    /**
+     * Configure a fixed address (DHCP client stopped)
+     */
+    void applyFixedAddress(const IPAddress& address, const IPAddress& gateway, const IPAddress& subnet,
+                           const IPAddress& dns1, const IPAddress& dns2);
+
+    /**
+     * Check if the cached lease is for ssid and before its renewal time
+     */
+    bool isCachedLeaseCurrent(const String& ssid) const;
+
+    /**
+     * Remember the lease the DHCP client was just granted
+     */
+    void recordLease();
+
+    /**
+     * Hand a link on a cached lease back to DHCP at the lease's renewal time
+     */
+    void checkLeaseRenewal();
+
+    /**
+     * Renewal time (T1) of the DHCP client's current lease in seconds (0 = not bound)
+     * Read on the tcpip thread; blocks until it has run.
+     */
+    static uint32_t dhcpRenewSeconds();
+
+    /**
+     * Check if the system clock kept running since before this boot
+     */
+    static bool isClockContinuous();
+
+    /**
+     * Map a disconnect reason during a connect attempt to a result
+     */
+    static WiFiConnectResult resultForReason(uint8_t reason);
 
     /**
-     * Set error message
+     * Record the last error
      */
-    void setError(const String& error);
+    void setError(Status error);
 
     /**
      * Update connection state
@@ -2,56 +2,85 @@
 
 using namespace WiFiSet;
 
+static_assert(STORED_PMK_LENGTH == PMK_LENGTH, "NVS PMK slot must hold a PairwiseMasterKey");
+static_assert(MAX_STORED_NETWORKS == MAX_SAVED_NETWORKS, "Saved Network List must hold the NVS network table");
+static_assert(MAX_STORED_FAILURES >= MAX_PREFERRED_FAILURES, "NVS must keep counting failures until the selector demotes a network");
+
 WiFiSetESP32::WiFiSetESP32(const char* deviceName)
     : deviceName(deviceName),
       lastConnectionState(ConnectionState::NOT_CONFIGURED),
+      lastSentState(ConnectionState::NOT_CONFIGURED),
       lastStatusUpdate(0),
+      clientConnectPending(false),
+      reconnectUsedPMK(false),
+      bootConnect(BootConnect::IDLE),
+      bootMatchIndex(0),
+      bootAttemptNetwork(-1),
+      bootCurrentStep(0),
+      bootUsedPMK(false),
+      bootStart(0),
       pendingClientConnect(false),
       pendingClientDisconnect(false),
-      pendingCredentials(false) {}
+      pendingCredentials(false),
+      pendingStatusRequest(false),
+      pendingScanSubscription(false),
+      pendingSubscribeEnabled(false),
+      pendingSubscribeThreshold(0),
+      pendingIPConfig(false),
+      pendingSavedNetworkRequest(false),
+      scanTransfer(ScanTransfer::IDLE),
+      scanSendIndex(0),
+      scanListStarted(false),
+      scanListSent(false),
+      scanRefreshPending(false),
+      backgroundScanRefresh(true),
+      lastScanRequest(0),
+      scanSubscribed(false),
+      scanDeltaUpdate(false),
+      deltaRssiThreshold(DEFAULT_DELTA_RSSI_THRESHOLD),
+      scanSubscriptionInterval(DEFAULT_SCAN_SUBSCRIPTION_INTERVAL_MS) {
+    // Keep the BLE link responsive while scanning for a client
+    wifiManager.setChannelSlicedScan(true);
+}
 
 WiFiSetESP32::~WiFiSetESP32() {}
 
 void WiFiSetESP32::begin() {
+    unsigned long start = millis();
+
     // Initialize NVS
     nvsManager.begin();
 
     // Initialize WiFi Manager
     wifiManager.begin();
 
-    // Initialize BLE Service
-    bleService.begin(deviceName.c_str());
-    bleService.setCallbacks(this);
-
     // Load saved credentials
-    StoredCredentials credentials = nvsManager.loadCredentials();
+    StoredCredentials credentials;
+    Status loaded = nvsManager.loadCredentials(credentials);
 
-    if (credentials.isValid) {
-        // Mark that we have credentials configured (with SSID for status display)
-        wifiManager.setCredentialsConfigured(true, credentials.ssid);
+    // Static IP, or the last lease while it is still current: no DHCP exchange
+    loadAddressSettings(credentials.ssid);
 
-        // Attempt to connect with saved credentials
-        WiFiConnectResult result = wifiManager.connect(credentials.ssid, credentials.password);
+    if (nvsManager.hasCredentials()) {
+        // Mark that we have credentials configured (with SSID for status display)
+        wifiManager.setCredentialsConfigured(true, loaded == Status::OK ? credentials.ssid : String());
+        lastConnectionState = ConnectionState::CONFIGURED_NOT_CONNECTED;
 
-        if (result == WiFiConnectResult::SUCCESS) {
-            lastConnectionState = ConnectionState::CONNECTED;
-            if (wifiConnectedCallback) {
-                wifiConnectedCallback(wifiManager.getIPAddress());
-            }
-        } else {
-            lastConnectionState = ConnectionState::CONFIGURED_NOT_CONNECTED;
-            if (wifiConnectionFailedCallback) {
-                wifiConnectionFailedCallback();
-            }
-        }
+        // The driver associates while BLE starts below; loop() takes it from there
+        startBootConnect();
     } else {
         lastConnectionState = ConnectionState::NOT_CONFIGURED;
     }
 
+    // Initialize BLE Service
+    bleService.begin(deviceName.c_str());
+    bleService.setCallbacks(this);
+
     // Always start BLE advertising to allow WiFi configuration/reconfiguration
-    // Start after WiFi to ensure proper radio coexistence
-    delay(500);
+    // (the coexistence scheduler shares the radio with a running connect)
     bleService.startAdvertising();
+
+    Serial.printf("[WiFiSet] Started in %lu ms\n", millis() - start);
 }
 
 void WiFiSetESP32::loop() {
@@ -66,14 +95,14 @@ void WiFiSetESP32::loop() {
             bleClientConnectedCallback();
         }
 
-        // Small delay to let serial output complete
-        delay(100);
+        // A new client starts without a list or a subscription
+        updateScanSubscription(false, 0);
+        clientNetworks.clear();
 
-        // Perform WiFi scan and send results
-        performWiFiScanAndSend();
+        // Scan runs in the background; results are streamed from processWiFiScan()
+        startWiFiScan();
 
         // Send current status
-        delay(100);
         sendCurrentStatus();
     }
 
@@ -90,13 +119,37 @@ void WiFiSetESP32::loop() {
             credentialsReceivedCallback(ssid, password);
         }
 
-        // Small delay
-        delay(100);
+        // Let the credential ACK reach the client before WiFi takes the radio
+        bleService.flushNotifications();
 
         // Handle WiFi connection
         handleWiFiConnection(ssid, password);
     }
 
+    // Handle deferred IP Config Write
+    if (pendingIPConfig) {
+        handleIPConfig(pendingIPConfigData);
+        pendingIPConfig = false; // Another write is turned away until now
+    }
+
+    // Handle deferred Saved Network request
+    if (pendingSavedNetworkRequest) {
+        handleSavedNetworkRequest(pendingSavedNetworkData);
+        pendingSavedNetworkRequest = false; // Another request is turned away until now
+    }
+
+    // Handle deferred status request
+    if (pendingStatusRequest) {
+        pendingStatusRequest = false;
+        sendCurrentStatus();
+    }
+
+    // Handle deferred Scan Subscribe
+    if (pendingScanSubscription) {
+        pendingScanSubscription = false;
+        updateScanSubscription(pendingSubscribeEnabled, pendingSubscribeThreshold);
+    }
+
     // Handle deferred BLE client disconnect
     if (pendingClientDisconnect) {
         pendingClientDisconnect = false;
@@ -106,6 +159,19 @@ void WiFiSetESP32::loop() {
         }
     }
 
+    uint8_t events = wifiManager.pollConnection();
+    if (events != ConnectEvent::NONE) {
+        handleConnectionEvents(events);
+    }
+
+    processBootScan();
+
+    processBootProbe();
+
+    superviseReconnect();
+
+    processWiFiScan();
+
     monitorConnection();
 }
 
@@ -132,7 +198,9 @@ void WiFiSetESP32::monitorConnection() {
 
     // Send status update to BLE client if state changed or every 10 seconds
     if (currentState != lastConnectionState || (millis() - lastStatusUpdate > 10000)) {
-        if (bleService.isClientConnected()) {
+        // WiFi events may already have reported this state
+        if (bleService.isClientConnected() &&
+            (currentState != lastSentState || millis() - lastStatusUpdate > 10000)) {
             sendCurrentStatus();
         }
 
@@ -160,67 +228,813 @@ void WiFiSetESP32::sendCurrentStatus() {
     int8_t rssi = wifiManager.getRSSI();
     IPAddress ip = wifiManager.getIPAddress();
     String ssid = wifiManager.getSSID();
+    uint8_t reason = state == ConnectionState::CONNECTED ? 0 : wifiManager.getLastDisconnectReason();
 
-    bleService.sendStatusResponse(state, rssi, ip, ssid);
+    bleService.sendStatusResponse(state, rssi, ip, ssid, reason);
+    lastSentState = state;
+    lastStatusUpdate = millis();
 }
 
-void WiFiSetESP32::performWiFiScanAndSend() {
-    // Give time for BLE connection to stabilize
-    delay(1000);
-    yield();
+void WiFiSetESP32::startWiFiScan() {
+    scanListSent = false;
+    scanRefreshPending = false;
 
-    // Perform WiFi scan (minimal debug output)
-    std::vector<WiFiNetworkInfo> networks = wifiManager.scanNetworks();
+    bool fresh = wifiManager.lookupScanCache();
+    bool stale = wifiManager.getScanCacheTTL() > 0 && wifiManager.hasScanResults();
+    if (fresh || (backgroundScanRefresh && stale)) {
+        // Serve the cached list right away; a stale one is refreshed afterwards
+        scanRefreshPending = !fresh;
+        beginNetworkListTransfer();
+        return;
+    }
 
-    delay(100);
-    yield();
+    // A scan can't start while the radio is joining an AP (e.g. at boot)
+    if (wifiManager.isConnecting()) {
+        scanTransfer = ScanTransfer::WAITING;
+        return;
+    }
 
-    // Send network list to BLE client
-    if (bleService.isClientConnected()) {
-        bleService.sendWiFiNetworkList(networks);
-        delay(100);
-        Serial.printf("[SCAN] Sent %d networks\n", networks.size());
+    requestWiFiScan();
+}
+
+void WiFiSetESP32::requestWiFiScan() {
+    lastScanRequest = millis();
+
+    if (!wifiManager.startScan()) {
+        finishFailedScan();
+        return;
     }
+
+    // A subscribed client that already has a list only gets the changes
+    scanDeltaUpdate = scanSubscribed && scanListSent && clientNetworks.hasBaseline();
+
+    // Results are streamed as the scan finds them
+    scanSendIndex = 0;
+    scanListStarted = false;
+    scanTransfer = ScanTransfer::SCANNING;
+}
+
+void WiFiSetESP32::finishFailedScan() {
+    // Report an empty list so the client isn't left waiting
+    // (unless it already has a list from the cache)
+    if (!scanListSent) {
+        bleService.beginWiFiNetworkList();
+        bleService.endWiFiNetworkList(0);
+        scanListSent = true;
+    }
+    scanTransfer = ScanTransfer::IDLE;
+}
+
+void WiFiSetESP32::beginNetworkListTransfer() {
+    scanSendIndex = 0;
+    scanListStarted = false;
+    scanTransfer = ScanTransfer::SENDING;
+}
+
+void WiFiSetESP32::processWiFiScan() {
+    if (!bleService.isClientConnected()) {
+        // Nobody to send to; a running scan finishes on its own
+        scanTransfer = ScanTransfer::IDLE;
+        return;
+    }
+
+    switch (scanTransfer) {
+        case ScanTransfer::IDLE: {
+            // Background refresh: keep a connected client's list within the TTL
+            unsigned long ttl = wifiManager.getScanCacheTTL();
+            unsigned long elapsed = millis() - lastScanRequest;
+            bool refresh = backgroundScanRefresh && ttl > 0 && !wifiManager.isScanCacheFresh() && elapsed >= ttl;
+            bool update = scanSubscribed && elapsed >= scanSubscriptionInterval;
+            // A scan would take the radio from a connect attempt
+            if (scanListSent && (refresh || update) && !wifiManager.isConnecting()) {
+                requestWiFiScan();
+            }
+            return;
+        }
+
+        case ScanTransfer::WAITING:
+            if (!wifiManager.isConnecting()) {
+                requestWiFiScan();
+            }
+            return;
+
+        case ScanTransfer::SCANNING:
+            switch (wifiManager.pollScan()) {
+                case ScanState::RUNNING:
+                    // Channel-sliced scans report networks as each channel completes
+                    if (!scanDeltaUpdate) {
+                        sendNextNetworks(wifiManager.getPartialScanResults());
+                    }
+                    return;
+                case ScanState::COMPLETE:
+                    if (scanDeltaUpdate) {
+                        clientNetworks.update(wifiManager.getScanResults(), deltaRssiThreshold, networkChanges);
+                        scanSendIndex = 0;
+                        scanTransfer = ScanTransfer::SENDING_CHANGES;
+                        return;
+                    }
+                    // The final list is ranked and trimmed, so it replaces any
+                    // partial list already streamed (List Start resets the client)
+                    if (scanSendIndex > 0) {
+                        scanSendIndex = 0;
+                        scanListStarted = false;
+                    }
+                    scanTransfer = ScanTransfer::SENDING;
+                    break;
+                case ScanState::FAILED:
+                    finishFailedScan();
+                    return;
+                default:
+                    scanTransfer = ScanTransfer::IDLE; // Cancelled (e.g. by a connect)
+                    return;
+            }
+            break;
+
+        case ScanTransfer::SENDING:
+            break;
+
+        case ScanTransfer::SENDING_CHANGES:
+            if (scanSubscribed && scanSendIndex < networkChanges.size()) {
+                size_t sent = bleService.sendWiFiNetworkChanges(networkChanges, scanSendIndex);
+                scanSendIndex += sent;
+                if (sent > 0) {
+                    return;
+                }
+            }
+            if (scanSendIndex < networkChanges.size()) {
+                // Cut short: the client's list no longer matches, resend it in full next time
+                clientNetworks.clear();
+            } else if (!networkChanges.empty()) {
+                Serial.printf("[SCAN] Sent %d network changes\n", networkChanges.size());
+            }
+            scanTransfer = ScanTransfer::IDLE;
+            return;
+    }
+
+    // One notification per loop() keeps status requests and user code responsive
+    const NetworkList& networks = wifiManager.getScanResults();
+    if (sendNextNetworks(networks) || !scanListStarted || scanSendIndex < networks.size()) {
+        return;
+    }
+
+    bleService.endWiFiNetworkList(networks.size());
+    Serial.printf("[SCAN] Sent %d networks\n", networks.size());
+    scanListSent = true;
+    scanTransfer = ScanTransfer::IDLE;
+    clientNetworks.setBaseline(networks);
+
+    // A stale cached list is followed by fresh results
+    if (scanRefreshPending) {
+        scanRefreshPending = false;
+        requestWiFiScan();
+    }
+}
+
+void WiFiSetESP32::updateScanSubscription(bool enabled, uint8_t rssiThreshold) {
+    scanSubscribed = enabled;
+    deltaRssiThreshold = rssiThreshold > 0 ? rssiThreshold : DEFAULT_DELTA_RSSI_THRESHOLD;
+}
+
+bool WiFiSetESP32::sendNextNetworks(const NetworkList& networks) {
+    // Notifications sent before the client subscribes are dropped
+    if (!scanListStarted) {
+        if (!bleService.isWiFiListSubscribed()) {
+            return false;
+        }
+        bleService.beginWiFiNetworkList();
+        scanListStarted = true;
+        return true;
+    }
+
+    if (scanSendIndex < networks.size()) {
+        scanSendIndex += bleService.sendWiFiNetworks(networks, scanSendIndex);
+        return true;
+    }
+
+    return false;
+}
+
+//
+// Public API - Scan Cache
+//
+
+void WiFiSetESP32::setScanCacheTTL(unsigned long ttlMs) {
+    wifiManager.setScanCacheTTL(ttlMs);
+}
+
+void WiFiSetESP32::setBackgroundScanRefresh(bool enabled) {
+    backgroundScanRefresh = enabled;
+}
+
+ScanCacheStats WiFiSetESP32::getScanCacheStats() {
+    return wifiManager.getScanCacheStats();
+}
+
+void WiFiSetESP32::setChannelSlicedScan(bool enabled) {
+    wifiManager.setChannelSlicedScan(enabled);
+}
+
+void WiFiSetESP32::setMaxScanResults(size_t count) {
+    wifiManager.setMaxScanResults(count);
+}
+
+void WiFiSetESP32::setScanConfig(const ScanConfig& config) {
+    wifiManager.setScanConfig(config);
+}
+
+void WiFiSetESP32::setScanSubscriptionInterval(unsigned long intervalMs) {
+    scanSubscriptionInterval = intervalMs;
 }
 
 void WiFiSetESP32::handleWiFiConnection(const String& ssid, const String& password) {
     // Save credentials to NVS
-    if (!nvsManager.saveCredentials(ssid, password)) {
-        bleService.sendError(ErrorCode::STORAGE_ERROR, nvsManager.getLastError());
+    Status saved = nvsManager.saveCredentials(ssid, password);
+    if (saved != Status::OK) {
+        bleService.sendError(saved);
         return;
     }
+    refreshSavedNetworks();
 
     // Mark that credentials are now configured (with SSID for status display)
     wifiManager.setCredentialsConfigured(true, ssid);
 
-    // Attempt to connect
+    // The client is waiting on this attempt; retries of the old network stop
+    reconnectSupervisor.cancel();
+    cancelBootConnect();
+
+    // Attempt to connect; progress is reported from loop() as WiFi events arrive
+    if (!wifiManager.beginConnect(ssid, password)) {
+        bleService.sendError(wifiManager.getLastError());
+        return;
+    }
+
+    clientConnectPending = true;
     lastConnectionState = ConnectionState::CONNECTING;
     sendCurrentStatus();
+}
 
-    WiFiConnectResult result = wifiManager.connect(ssid, password);
+void WiFiSetESP32::handleConnectionEvents(uint8_t events) {
+    if (events & ConnectEvent::LEASE_UPDATED) {
+        saveConnectedLease();
+    }
 
-    if (result == WiFiConnectResult::SUCCESS) {
-        lastConnectionState = ConnectionState::CONNECTED;
+    if ((events & ConnectEvent::LINK_LOST) && nvsManager.hasCredentials()) {
+        reconnectSupervisor.linkLost(millis());
+    }
+
+    // Report each link change as it happens
+    bool reported = false;
+    if (events & (ConnectEvent::STA_CONNECTED | ConnectEvent::GOT_IP | ConnectEvent::DISCONNECTED)) {
         sendCurrentStatus();
+        reported = true;
+    }
+
+    if (!(events & ConnectEvent::CONNECT_DONE)) {
+        return;
+    }
 
+    WiFiConnectResult result = wifiManager.getConnectResult();
+    bool success = result == WiFiConnectResult::SUCCESS;
+    nvsManager.recordConnectResult(wifiManager.getConnectSSID(), success);
+
+    // Found at boot in place of the current network: it becomes current
+    if (success && bootConnect == BootConnect::CONNECTING && bootAttemptNetwork >= 0) {
+        const StoredNetwork& network = bootNetworks[bootAttemptNetwork];
+        adoptConnectedNetwork(String(network.ssid), String(network.password));
+    }
+
+    if (success) {
+        reconnectSupervisor.linkRestored(millis());
+    } else if (reconnectSupervisor.isAttemptRunning()) {
+        // The AP may have moved to WPA3, which needs the passphrase
+        if (reconnectUsedPMK && (result == WiFiConnectResult::FAILED_WRONG_PASSWORD ||
+                                 result == WiFiConnectResult::FAILED_UNKNOWN)) {
+            nvsManager.clearPMK();
+        }
+        reconnectSupervisor.attemptFailed(millis());
+    }
+
+    // The location, PMK and lease kept in NVS follow the current network
+    StoredCredentials credentials;
+    if (success && nvsManager.loadCredentials(credentials) == Status::OK &&
+        credentials.ssid == wifiManager.getConnectSSID()) {
+        saveConnectedLocation();
+        saveConnectedPMK(credentials.ssid, credentials.password);
+    }
+
+    if (bootConnect == BootConnect::CONNECTING) {
+        continueBootConnect(result, reported);
+        return;
+    }
+
+    if (!clientConnectPending) {
+        return;
+    }
+    clientConnectPending = false;
+
+    if (success) {
+        lastConnectionState = ConnectionState::CONNECTED;
         if (wifiConnectedCallback) {
             wifiConnectedCallback(wifiManager.getIPAddress());
         }
-    } else {
-        // Credentials are saved but connection failed
-        lastConnectionState = ConnectionState::CONFIGURED_NOT_CONNECTED;
+        return;
+    }
+
+    // Credentials are saved but connection failed
+    lastConnectionState = ConnectionState::CONFIGURED_NOT_CONNECTED;
+    if (!reported) {
+        sendCurrentStatus(); // Timeout: no event to report
+    }
+
+    if (wifiConnectionFailedCallback) {
+        wifiConnectionFailedCallback();
+    }
+
+    // Send error to BLE client
+    bleService.sendError(wifiManager.getLastError());
+}
+
+void WiFiSetESP32::superviseReconnect() {
+    if (!reconnectSupervisor.isRetryDue(millis()) || wifiManager.isConnecting()) {
+        return;
+    }
+
+    // Let a scan the client is waiting for finish first
+    if (scanTransfer == ScanTransfer::WAITING || scanTransfer == ScanTransfer::SCANNING) {
+        return;
+    }
+
+    StoredCredentials credentials;
+    if (nvsManager.loadCredentials(credentials) != Status::OK) {
+        reconnectSupervisor.cancel();
+        return;
+    }
+
+    NetworkLocation location;
+    wifi_auth_mode_t authMode = WIFI_AUTH_MAX;
+    StoredLocation storedLocation;
+    if (nvsManager.loadLocation(storedLocation) == Status::OK) {
+        authMode = static_cast<wifi_auth_mode_t>(storedLocation.authMode);
+        if (reconnectSupervisor.getCurrentRetries() == 0) {
+            memcpy(location.bssid, storedLocation.bssid, sizeof(location.bssid));
+            location.channel = storedLocation.channel;
+            location.authMode = authMode;
+        }
+    }
+
+    String secret = storedConnectSecret(credentials, authMode, reconnectUsedPMK);
+    reconnectSupervisor.attemptStarted();
+    if (!wifiManager.beginConnect(credentials.ssid, secret, location)) {
+        reconnectSupervisor.attemptFailed(millis());
+    }
+}
+
+void WiFiSetESP32::startBootConnect() {
+    loadSavedNetworks(bootNetworks);
+    bootMatches.clear();
+    bootMatchIndex = 0;
+    bootCurrentStep = 0;
+    bootStart = millis();
+
+    // Several saved networks: find out which are in range first
+    if (bootNetworks.size() > 1 && wifiManager.startScan()) {
+        bootConnect = BootConnect::SCANNING;
+        return;
+    }
+
+    bootConnect = BootConnect::CONNECTING;
+    if (!startNextBootAttempt()) {
+        finishBootConnect(false, false);
+    }
+}
+
+void WiFiSetESP32::processBootScan() {
+    if (bootConnect != BootConnect::SCANNING) {
+        return;
+    }
+
+    ScanState state = wifiManager.pollScan();
+    if (state == ScanState::RUNNING) {
+        return;
+    }
+
+    // A client may be reading the same scan; connecting would cut it short
+    if (scanTransfer == ScanTransfer::SCANNING) {
+        return;
+    }
+
+    // If the scan failed, the current network is still worth a try
+    if (state == ScanState::COMPLETE) {
+        wifiManager.rankSavedNetworks(bootMatches);
+        for (size_t i = 0; i < bootMatches.size(); i++) {
+            Serial.printf("[WiFi] Saved network '%s' in range (%d dBm)\n",
+                          bootNetworks[bootMatches[i].index].ssid, bootMatches[i].rssi);
+        }
+    }
+
+    bootConnect = BootConnect::CONNECTING;
+    if (!startNextBootAttempt()) {
+        finishBootConnect(false, false);
+    }
+}
+
+bool WiFiSetESP32::startNextBootAttempt() {
+    StoredCredentials current;
+    nvsManager.loadCredentials(current);
+
+    while (bootMatchIndex < bootMatches.size()) {
+        const SavedNetworkMatch& match = bootMatches[bootMatchIndex];
+        const StoredNetwork& network = bootNetworks[match.index];
+        String ssid(network.ssid);
+
+        if (current.isValid && ssid == current.ssid) {
+            // Stays on this match until the current network's attempts run out
+            if (startCurrentBootAttempt(current)) {
+                return true;
+            }
+            bootMatchIndex++;
+            continue;
+        }
+
+        bootMatchIndex++;
+
+        // The scan found the channel, which spares the driver its own search
+        NetworkLocation location;
+        location.channel = match.channel;
+        bootAttemptNetwork = match.index;
+        bootUsedPMK = false;
+        if (wifiManager.beginConnect(ssid, String(network.password), location)) {
+            return true;
+        }
+    }
+
+    // A network that hides its SSID never shows up in the scan
+    return current.isValid && startCurrentBootAttempt(current);
+}
+
+bool WiFiSetESP32::startCurrentBootAttempt(const StoredCredentials& credentials) {
+    StoredLocation storedLocation;
+    bool located = nvsManager.loadLocation(storedLocation) == Status::OK;
+    wifi_auth_mode_t authMode = located ? static_cast<wifi_auth_mode_t>(storedLocation.authMode) : WIFI_AUTH_MAX;
+
+    // Go straight to the AP of the last connection if we know it, then probe
+    // for where it moved, then let the driver search
+    if (bootCurrentStep == 0 && !located) {
+        bootCurrentStep = 1;
+    }
+    if (bootCurrentStep == 1) {
+        bootCurrentStep++;
+        if (wifiManager.startProbe(credentials.ssid, located ? storedLocation.channel : 0)) {
+            bootConnect = BootConnect::PROBING;
+            return true;
+        }
+    }
+    if (bootCurrentStep > 2) {
+        return false;
+    }
+
+    NetworkLocation location;
+    if (bootCurrentStep == 0) {
+        memcpy(location.bssid, storedLocation.bssid, sizeof(location.bssid));
+        location.channel = storedLocation.channel;
+        location.authMode = authMode;
+    }
+    bootCurrentStep++;
+
+    bootAttemptNetwork = -1;
+    String secret = storedConnectSecret(credentials, authMode, bootUsedPMK);
+    return wifiManager.beginConnect(credentials.ssid, secret, location);
+}
+
+void WiFiSetESP32::processBootProbe() {
+    if (bootConnect != BootConnect::PROBING) {
+        return;
+    }
+
+    ScanState state = wifiManager.pollProbe();
+    if (state == ScanState::RUNNING) {
+        return;
+    }
+
+    // A client scan took the radio over; connecting would cut it short
+    if (scanTransfer == ScanTransfer::SCANNING) {
+        return;
+    }
+
+    bootConnect = BootConnect::CONNECTING;
+
+    StoredCredentials current;
+    if (state == ScanState::COMPLETE && nvsManager.loadCredentials(current) == Status::OK) {
+        const NetworkLocation& location = wifiManager.getProbeResult();
+        bootAttemptNetwork = -1;
+        String secret = storedConnectSecret(current, location.authMode, bootUsedPMK);
+        if (wifiManager.beginConnect(current.ssid, secret, location)) {
+            return;
+        }
+    }
+
+    // Not found on any channel: the driver's own search is the last try
+    if (!startNextBootAttempt()) {
+        finishBootConnect(false, false);
+    }
+}
+
+void WiFiSetESP32::continueBootConnect(WiFiConnectResult result, bool reported) {
+    if (result == WiFiConnectResult::SUCCESS) {
+        finishBootConnect(true, reported);
+        return;
+    }
+
+    // The AP may have moved to WPA3, which needs the passphrase: same AP again
+    if (bootUsedPMK && (result == WiFiConnectResult::FAILED_WRONG_PASSWORD ||
+                        result == WiFiConnectResult::FAILED_UNKNOWN)) {
+        Serial.println("[WiFi] Cached PMK rejected, retrying with the passphrase");
+        nvsManager.clearPMK();
+        bootCurrentStep--;
+    }
+
+    if (!startNextBootAttempt()) {
+        finishBootConnect(false, reported);
+    }
+}
+
+void WiFiSetESP32::finishBootConnect(bool connected, bool reported) {
+    bootConnect = BootConnect::IDLE;
+    Serial.printf("[WiFi] Boot connect %s after %lu ms\n", connected ? "succeeded" : "failed", millis() - bootStart);
+
+    if (connected) {
+        lastConnectionState = ConnectionState::CONNECTED;
+        if (wifiConnectedCallback) {
+            wifiConnectedCallback(wifiManager.getIPAddress());
+        }
+        return;
+    }
+
+    lastConnectionState = ConnectionState::CONFIGURED_NOT_CONNECTED;
+    if (!reported) {
+        sendCurrentStatus(); // Timeout: no event to report
+    }
+
+    if (wifiConnectionFailedCallback) {
+        wifiConnectionFailedCallback();
+    }
+
+    // The AP may just be slower to come back than we were
+    reconnectSupervisor.linkLost(millis());
+}
+
+void WiFiSetESP32::cancelBootConnect() {
+    if (bootConnect == BootConnect::PROBING) {
+        wifiManager.cancelProbe();
+    }
+    bootConnect = BootConnect::IDLE;
+}
+
+void WiFiSetESP32::adoptConnectedNetwork(const String& ssid, const String& password) {
+    Status saved = nvsManager.saveCredentials(ssid, password);
+    if (saved != Status::OK) {
+        Serial.printf("[WiFi] Could not make '%s' the current network: %s\n", ssid.c_str(), statusMessage(saved));
+        return;
+    }
+
+    wifiManager.setCredentialsConfigured(true, ssid);
+}
+
+void WiFiSetESP32::loadSavedNetworks(StoredNetworkList& networks) {
+    nvsManager.loadNetworks(networks);
+
+    SavedNetworkList saved;
+    for (size_t i = 0; i < networks.size(); i++) {
+        SavedNetworkInfo info;
+        info.setSSID(networks[i].ssid);
+        info.priority = networks[i].priority;
+        info.failureCount = networks[i].failureCount;
+        info.lastSuccess = networks[i].lastSuccess;
+        saved.push_back(info);
+    }
+    wifiManager.setSavedNetworks(saved);
+}
+
+void WiFiSetESP32::refreshSavedNetworks() {
+    StoredNetworkList networks;
+    loadSavedNetworks(networks);
+}
+
+void WiFiSetESP32::handleSavedNetworkRequest(const SavedNetworkRequest& request) {
+    if (request.type == MessageType::SAVED_NETWORK_LIST_REQUEST) {
+        bleService.sendSavedNetworkList(wifiManager.getSavedNetworks());
+        return;
+    }
+
+    bool wasConfigured = nvsManager.hasCredentials();
+    Status status;
+    switch (request.type) {
+        case MessageType::SAVED_NETWORK_ADD:
+            status = nvsManager.saveNetwork(request.ssid, request.password, request.priority);
+            break;
+        case MessageType::SAVED_NETWORK_REMOVE:
+            status = nvsManager.removeNetwork(request.ssid);
+            break;
+        default:
+            status = nvsManager.setNetworkPriority(request.ssid, request.priority);
+            break;
+    }
+
+    bleService.sendSavedNetworkAck(request.type, toSavedNetworkAckStatus(status));
+    if (status != Status::OK) {
+        return;
+    }
+    refreshSavedNetworks();
+
+    if (request.type == MessageType::SAVED_NETWORK_ADD && !wasConfigured) {
+        // The first network works like a Credential Write: it becomes current and is joined now
+        bleService.flushNotifications();
+        handleWiFiConnection(request.ssid, request.password);
+    } else if (request.type == MessageType::SAVED_NETWORK_REMOVE && !nvsManager.hasCredentials()) {
+        wifiManager.setCredentialsConfigured(false);
+        reconnectSupervisor.cancel();
+        cancelBootConnect();
         sendCurrentStatus();
+    } else if (request.type == MessageType::SAVED_NETWORK_REMOVE) {
+        // Removing the current network made another one current
+        StoredCredentials current;
+        if (nvsManager.loadCredentials(current) == Status::OK) {
+            wifiManager.setCredentialsConfigured(true, current.ssid);
+        }
 
-        if (wifiConnectionFailedCallback) {
-            wifiConnectionFailedCallback();
+        if (bootConnect != BootConnect::IDLE) {
+            // The boot candidates may include it: retry the current network instead
+            cancelBootConnect();
+            reconnectSupervisor.linkLost(millis());
         }
+    }
+}
+
+void WiFiSetESP32::saveConnectedLocation() {
+    const NetworkLocation& location = wifiManager.getLastLocation();
+    if (!location.isKnown()) {
+        return;
+    }
+
+    StoredLocation stored;
+    memcpy(stored.bssid, location.bssid, sizeof(stored.bssid));
+    stored.channel = location.channel;
+    stored.authMode = static_cast<uint8_t>(location.authMode);
+    stored.isValid = true;
 
-        // Send error to BLE client
-        String errorMsg = "Connection failed: " + wifiManager.getLastError();
-        bleService.sendError(ErrorCode::CONNECTION_TIMEOUT, errorMsg);
+    Status saved = nvsManager.saveLocation(stored);
+    if (saved != Status::OK) {
+        Serial.printf("[WiFi] Could not save AP location: %s\n", statusMessage(saved));
     }
 }
 
+void WiFiSetESP32::saveConnectedPMK(const String& ssid, const String& password) {
+    // Only for the network just connected to, and only if the AP takes a PMK
+    if (wifiManager.getLastLocationSSID() != ssid ||
+        !PairwiseMasterKey::usedBy(wifiManager.getLastLocation().authMode)) {
+        return;
+    }
+
+    // Cleared by NVSManager whenever the credentials change
+    StoredPMK stored;
+    if (nvsManager.loadPMK(stored) == Status::OK) {
+        return;
+    }
+
+    PairwiseMasterKey pmk;
+    if (!pmk.derive(ssid, password)) {
+        return; // Hex PSK or not a valid passphrase
+    }
+
+    memcpy(stored.key, pmk.key, sizeof(stored.key));
+    stored.isValid = true;
+
+    Status saved = nvsManager.savePMK(stored);
+    if (saved != Status::OK) {
+        Serial.printf("[WiFi] Could not save PMK: %s\n", statusMessage(saved));
+    }
+}
+
+void WiFiSetESP32::saveConnectedLease() {
+    // Only the stored network's lease is worth keeping
+    StoredCredentials credentials;
+    if (nvsManager.loadCredentials(credentials) != Status::OK || credentials.ssid != wifiManager.getLeaseSSID()) {
+        return;
+    }
+
+    const DhcpLease& lease = wifiManager.getLease();
+    StoredLease stored;
+    stored.address = lease.address;
+    stored.subnet = lease.subnet;
+    stored.gateway = lease.gateway;
+    stored.dns1 = lease.dns1;
+    stored.dns2 = lease.dns2;
+    stored.obtainedAt = lease.obtainedAt;
+    stored.renewAt = lease.renewAt;
+    stored.isValid = true;
+
+    Status saved = nvsManager.saveLease(stored);
+    if (saved != Status::OK) {
+        Serial.printf("[WiFi] Could not save DHCP lease: %s\n", statusMessage(saved));
+    }
+}
+
+void WiFiSetESP32::loadAddressSettings(const String& ssid) {
+    StoredIPConfig storedConfig;
+    if (nvsManager.loadIPConfig(storedConfig) == Status::OK) {
+        IPConfig config;
+        config.isStatic = storedConfig.isStatic;
+        config.address = storedConfig.address;
+        config.subnet = storedConfig.subnet;
+        config.gateway = storedConfig.gateway;
+        config.dns1 = storedConfig.dns1;
+        config.dns2 = storedConfig.dns2;
+        wifiManager.setIPConfig(config);
+    }
+
+    StoredLease storedLease;
+    if (ssid.length() > 0 && nvsManager.loadLease(storedLease) == Status::OK) {
+        DhcpLease lease;
+        lease.address = storedLease.address;
+        lease.subnet = storedLease.subnet;
+        lease.gateway = storedLease.gateway;
+        lease.dns1 = storedLease.dns1;
+        lease.dns2 = storedLease.dns2;
+        lease.obtainedAt = storedLease.obtainedAt;
+        lease.renewAt = storedLease.renewAt;
+        wifiManager.setCachedLease(ssid, lease);
+    }
+}
+
+void WiFiSetESP32::handleIPConfig(const IPConfigData& config) {
+    StoredIPConfig stored;
+    stored.isStatic = config.mode == IPMode::STATIC;
+    stored.address = config.address;
+    stored.subnet = config.subnet;
+    stored.gateway = config.gateway;
+    stored.dns1 = config.dns1;
+    stored.dns2 = config.dns2;
+    stored.isValid = true;
+
+    Status saved = nvsManager.saveIPConfig(stored);
+    bleService.sendIPConfigAck(toIPConfigAckStatus(saved));
+    if (saved != Status::OK) {
+        bleService.sendError(saved);
+        return;
+    }
+
+    IPConfig applied;
+    applied.isStatic = stored.isStatic;
+    applied.address = stored.address;
+    applied.subnet = stored.subnet;
+    applied.gateway = stored.gateway;
+    applied.dns1 = stored.dns1;
+    applied.dns2 = stored.dns2;
+    wifiManager.setIPConfig(applied);
+
+    // A boot connect still running picks it up from its next attempt
+    if (bootConnect != BootConnect::IDLE) {
+        return;
+    }
+
+    // Reconnect so the client sees the new address in the Status Response
+    StoredCredentials credentials;
+    if (nvsManager.loadCredentials(credentials) != Status::OK) {
+        return;
+    }
+
+    // Let the ACK reach the client before WiFi takes the radio
+    bleService.flushNotifications();
+    if (!wifiManager.beginConnect(credentials.ssid, credentials.password)) {
+        bleService.sendError(wifiManager.getLastError());
+        return;
+    }
+
+    clientConnectPending = true;
+    lastConnectionState = ConnectionState::CONNECTING;
+    sendCurrentStatus();
+}
+
+String WiFiSetESP32::storedConnectSecret(const StoredCredentials& credentials, wifi_auth_mode_t authMode,
+                                         bool& usedPMK) {
+    usedPMK = false;
+
+    // Without a known WPA/WPA2-Personal AP the passphrase is the safe choice
+    if (!PairwiseMasterKey::usedBy(authMode)) {
+        return credentials.password;
+    }
+
+    StoredPMK stored;
+    if (nvsManager.loadPMK(stored) != Status::OK) {
+        return credentials.password;
+    }
+
+    PairwiseMasterKey pmk;
+    pmk.set(stored.key);
+    usedPMK = true;
+    return pmk.toPSK();
+}
+
 //
 // BLEServiceCallbacks implementation
 //
@@ -243,8 +1057,39 @@ void WiFiSetESP32::onClientDisconnected() {
 }
 
 void WiFiSetESP32::onStatusRequest() {
-    // Send current status
-    sendCurrentStatus();
+    // Just set flag - status sent from loop()
+    pendingStatusRequest = true;
+}
+
+void WiFiSetESP32::onScanSubscription(bool enabled, uint8_t rssiThreshold) {
+    // Just set flag - applied in loop()
+    pendingSubscribeEnabled = enabled;
+    pendingSubscribeThreshold = rssiThreshold;
+    pendingScanSubscription = true;
+}
+
+void WiFiSetESP32::onIPConfigReceived(const IPConfigData& config) {
+    // The stored configuration is still in use until loop() clears the flag
+    if (pendingIPConfig) {
+        bleService.sendIPConfigAck(IPConfigAckStatus::BUSY);
+        return;
+    }
+
+    // Just set flag and store the configuration - saved, applied and answered in loop()
+    pendingIPConfigData = config;
+    pendingIPConfig = true;
+}
+
+void WiFiSetESP32::onSavedNetworkRequest(const SavedNetworkRequest& request) {
+    // The stored request is still in use until loop() clears the flag
+    if (pendingSavedNetworkRequest) {
+        bleService.sendSavedNetworkAck(request.type, SavedNetworkAckStatus::BUSY);
+        return;
+    }
+
+    // Just set flag and store the request - applied and answered in loop()
+    pendingSavedNetworkData = request;
+    pendingSavedNetworkRequest = true;
 }
 
 //
@@ -281,7 +1126,8 @@ void WiFiSetESP32::onBLEClientDisconnected(std::function<void()> callback) {
 
 WiFiSetCredentials WiFiSetESP32::getSavedCredentials() {
     WiFiSetCredentials result;
-    StoredCredentials stored = nvsManager.loadCredentials();
+    StoredCredentials stored;
+    nvsManager.loadCredentials(stored);
 
     result.ssid = stored.ssid;
     result.password = stored.password;
@@ -291,32 +1137,104 @@ WiFiSetCredentials WiFiSetESP32::getSavedCredentials() {
 }
 
 bool WiFiSetESP32::clearCredentials() {
-    bool result = nvsManager.clearCredentials();
+    bool result = nvsManager.clearCredentials() == Status::OK;
     if (result) {
         wifiManager.setCredentialsConfigured(false);
+        refreshSavedNetworks();
+        reconnectSupervisor.cancel();
+        cancelBootConnect();
     }
     return result;
 }
 
+bool WiFiSetESP32::addNetwork(const String& ssid, const String& password, uint8_t priority) {
+    if (nvsManager.saveNetwork(ssid, password, priority) != Status::OK) {
+        return false;
+    }
+    refreshSavedNetworks();
+    return true;
+}
+
+bool WiFiSetESP32::removeNetwork(const String& ssid) {
+    if (nvsManager.removeNetwork(ssid) != Status::OK) {
+        return false;
+    }
+    refreshSavedNetworks();
+    if (!nvsManager.hasCredentials()) {
+        wifiManager.setCredentialsConfigured(false);
+        reconnectSupervisor.cancel();
+        cancelBootConnect();
+        return true;
+    }
+
+    // Removing the current network made another one current
+    StoredCredentials current;
+    if (nvsManager.loadCredentials(current) == Status::OK) {
+        wifiManager.setCredentialsConfigured(true, current.ssid);
+    }
+    if (bootConnect != BootConnect::IDLE) {
+        // The boot candidates may include it: retry the current network instead
+        cancelBootConnect();
+        reconnectSupervisor.linkLost(millis());
+    }
+    return true;
+}
+
+bool WiFiSetESP32::setNetworkPriority(const String& ssid, uint8_t priority) {
+    if (nvsManager.setNetworkPriority(ssid, priority) != Status::OK) {
+        return false;
+    }
+    refreshSavedNetworks();
+    return true;
+}
+
+SavedNetworkList WiFiSetESP32::getSavedNetworks() {
+    return wifiManager.getSavedNetworks();
+}
+
+
 //
 // Public API - WiFi Control
 //
 
 bool WiFiSetESP32::connectWiFi(const String& ssid, const String& password, bool save) {
+    cancelBootConnect();
+
     if (save) {
-        if (!nvsManager.saveCredentials(ssid, password)) {
+        if (nvsManager.saveCredentials(ssid, password) != Status::OK) {
             return false;
         }
+        refreshSavedNetworks();
     }
 
     WiFiConnectResult result = wifiManager.connect(ssid, password);
+    if (save) {
+        nvsManager.recordConnectResult(ssid, result == WiFiConnectResult::SUCCESS);
+    }
+    if (result == WiFiConnectResult::SUCCESS) {
+        reconnectSupervisor.linkRestored(millis());
+    }
+    if (result == WiFiConnectResult::SUCCESS && save) {
+        saveConnectedLocation();
+        saveConnectedPMK(ssid, password);
+    }
     return (result == WiFiConnectResult::SUCCESS);
 }
 
 void WiFiSetESP32::disconnectWiFi() {
+    reconnectSupervisor.cancel();
+    cancelBootConnect();
     wifiManager.disconnect();
 }
 
+void WiFiSetESP32::setReconnectConfig(const ReconnectConfig& config) {
+    reconnectSupervisor.setConfig(config);
+}
+
+ReconnectStats WiFiSetESP32::getReconnectStats() {
+    return reconnectSupervisor.getStats(millis());
+}
+
 //
 // Public API - Status
 //
@@ -356,3 +1274,7 @@ void WiFiSetESP32::stopBLE() {
 bool WiFiSetESP32::isBLERunning() {
     return bleService.isRunning();
 }
+
+void WiFiSetESP32::setBatchedNetworkList(bool enabled) {
+    bleService.setBatchedNetworkList(enabled);
+}
@@ -6,6 +6,9 @@
 #include <WiFi.h>
 #include "BLEService/BLEService.h"
 #include "WiFiManager/WiFiManager.h"
+#include "WiFiManager/NetworkDeltaTracker.h"
+#include "WiFiManager/PairwiseMasterKey.h"
+#include "WiFiManager/ReconnectSupervisor.h"
 #include "Storage/NVSManager.h"
 
 namespace WiFiSet {
@@ -64,11 +67,16 @@ public:
 
     /**
      * Initialize the library
-     * - Initializes BLE service
      * - Initializes WiFi manager
      * - Loads saved credentials
-     * - Attempts to connect if credentials exist
-     * - Starts BLE advertising if not connected
+     * - Starts connecting if credentials exist (the saved AP first)
+     * - With several saved networks, scans and tries those in range, best first
+     * - If that fails, keeps retrying from loop() with backoff (see setReconnectConfig())
+     * - Initializes BLE service and starts advertising
+     *
+     * Returns without waiting for WiFi: BLE is advertising on return while
+     * the connect runs on from loop(). The outcome is reported through
+     * onWiFiConnected() or onWiFiConnectionFailed().
      *
      * Must be called from setup()
      */
@@ -76,7 +84,9 @@ public:
 
     /**
      * Main loop processing
+     * - Drives the connect started by begin()
      * - Monitors WiFi connection status
+     * - Retries a lost WiFi link when its backoff delay is up
      * - Sends status updates to connected BLE clients
      *
      * Must be called from loop()
@@ -131,11 +141,42 @@ public:
 
     /**
      * Clear saved credentials from NVS
-     * Does not disconnect from current WiFi
+     * Removes every saved network. Does not disconnect from current WiFi
      * @return true if successful
      */
     bool clearCredentials();
 
+    /**
+     * Save a network to try at boot alongside the current one
+     * At boot the device scans and joins the best saved network in range:
+     * usable signal first, then networks that haven't kept failing, then
+     * higher priority, stronger signal and most recent success.
+     * Updates the password and priority of a network that is already saved.
+     * @param priority Higher is preferred (default: 0)
+     * @return false if the credentials are invalid, the table is full
+     *         (WiFiSet::MAX_STORED_NETWORKS) or NVS failed
+     */
+    bool addNetwork(const String& ssid, const String& password, uint8_t priority = 0);
+
+    /**
+     * Forget a saved network
+     * Removing the current network does not disconnect from it; the most
+     * preferred remaining network becomes current.
+     * @return false if the network isn't saved or NVS failed
+     */
+    bool removeNetwork(const String& ssid);
+
+    /**
+     * Change the priority of a saved network
+     * @return false if the network isn't saved or NVS failed
+     */
+    bool setNetworkPriority(const String& ssid, uint8_t priority);
+
+    /**
+     * Saved networks (without passwords), highest priority first
+     */
+    WiFiSet::SavedNetworkList getSavedNetworks();
+
     // ==================== WiFi Control ====================
 
     /**
@@ -149,9 +190,25 @@ public:
 
     /**
      * Disconnect from WiFi
+     * Stops reconnect retries until the next connect.
      */
     void disconnectWiFi();
 
+    /**
+     * Set how a lost WiFi link is retried
+     * The delay before each retry doubles from initialDelayMs up to
+     * maxDelayMs and is shortened by a random share of up to jitterPercent,
+     * so devices that lose the same AP don't all retry at once. Retries only
+     * run from loop() and never block.
+     * @param config Backoff settings (default: 2 s doubling to 5 min, 50% jitter)
+     */
+    void setReconnectConfig(const WiFiSet::ReconnectConfig& config);
+
+    /**
+     * Get reconnect counters and times to recovery
+     */
+    WiFiSet::ReconnectStats getReconnectStats();
+
     // ==================== Status ====================
 
     /**
@@ -204,6 +261,72 @@ public:
      */
     bool isBLERunning();
 
+    /**
+     * Enable batched WiFi network list transfer
+     * Packs multiple networks into each BLE notification (up to the MTU).
+     * Clients that negotiate the feature via HELLO get batches regardless;
+     * this forces batching for clients that understand 0x04 but never send HELLO.
+     * @param enabled true to send batches (default: false)
+     */
+    void setBatchedNetworkList(bool enabled);
+
+    // ==================== Scan Cache ====================
+
+    /**
+     * Set how long scan results are reused for connecting clients
+     * A client connecting within the TTL of the last scan gets the cached
+     * list immediately instead of waiting for a new scan.
+     * @param ttlMs Cache lifetime in milliseconds (default 30000, 0 = always scan)
+     */
+    void setScanCacheTTL(unsigned long ttlMs);
+
+    /**
+     * Enable background refresh of stale scan results
+     * When enabled, a client connecting after the TTL gets the stale list
+     * immediately followed by fresh results, and a connected client's list
+     * is refreshed each time the TTL expires.
+     * When disabled, a stale cache is ignored and the client waits for a scan.
+     * @param enabled true to refresh in the background (default: true)
+     */
+    void setBackgroundScanRefresh(bool enabled);
+
+    /**
+     * Get scan cache hit/miss counters and the age of the cached results
+     */
+    WiFiSet::ScanCacheStats getScanCacheStats();
+
+    /**
+     * Scan one WiFi channel at a time
+     * The radio goes back to BLE between channels, keeping the BLE link
+     * responsive during a scan, and networks are sent to the client as each
+     * channel completes instead of after the whole scan.
+     * @param enabled true for channel-sliced scans (default: true)
+     */
+    void setChannelSlicedScan(bool enabled);
+
+    /**
+     * Set how many networks are sent to the client per scan
+     * APs sharing an SSID are merged into one entry (strongest AP wins),
+     * then the strongest networks are kept, strongest first.
+     * @param count Maximum networks per list (1-64, default 20)
+     */
+    void setMaxScanResults(size_t count);
+
+    /**
+     * Set scan parameters (active/passive, dwell per channel, channel mask,
+     * hidden networks, band)
+     * Takes effect from the next scan.
+     */
+    void setScanConfig(const WiFiSet::ScanConfig& config);
+
+    /**
+     * Set how often a subscribed client's network list is refreshed
+     * Clients that send Scan Subscribe get only the networks that were
+     * added, removed or changed since the last update.
+     * @param intervalMs Time between scans in milliseconds (default 10000)
+     */
+    void setScanSubscriptionInterval(unsigned long intervalMs);
+
 private:
     WiFiSet::WiFiSetBLEService bleService;
     WiFiSet::WiFiManager wifiManager;
@@ -211,14 +334,66 @@ private:
 
     String deviceName;
     WiFiSet::ConnectionState lastConnectionState;
+    WiFiSet::ConnectionState lastSentState;     // State in the last Status Response
     unsigned long lastStatusUpdate;
+    bool clientConnectPending;                  // Connect attempt started by a Credential Write
+    WiFiSet::ReconnectSupervisor reconnectSupervisor;
+    bool reconnectUsedPMK;                      // Running retry was sent the cached PMK
+
+    // Connect to the saved networks started by begin(), driven from loop()
+    enum class BootConnect : uint8_t {
+        IDLE,       // Not running (done, cancelled or nothing saved)
+        SCANNING,   // Looking for saved networks in range
+        PROBING,    // Looking for the channel the current network moved to
+        CONNECTING  // Trying the candidates, best first
+    };
+    BootConnect bootConnect;
+    WiFiSet::StoredNetworkList bootNetworks;        // Saved networks, in the order bootMatches indexes
+    WiFiSet::SavedNetworkMatchList bootMatches;     // Saved networks found by the scan, best first
+    size_t bootMatchIndex;                          // Next match to try
+    int bootAttemptNetwork;                         // bootNetworks index of the running attempt (-1: current network)
+    uint8_t bootCurrentStep;                        // Attempts made on the current network
+    bool bootUsedPMK;                               // Running attempt was sent the cached PMK
+    unsigned long bootStart;
 
     // Deferred action flags (work done in loop, not callbacks)
     volatile bool pendingClientConnect;
     volatile bool pendingClientDisconnect;
     volatile bool pendingCredentials;
+    volatile bool pendingStatusRequest;
+    volatile bool pendingScanSubscription;
+    bool pendingSubscribeEnabled;
+    uint8_t pendingSubscribeThreshold;
     String pendingSSID;
     String pendingPassword;
+    volatile bool pendingIPConfig;
+    WiFiSet::IPConfigData pendingIPConfigData;
+    volatile bool pendingSavedNetworkRequest;
+    WiFiSet::SavedNetworkRequest pendingSavedNetworkData;
+
+    // Network list transfer driven from loop()
+    enum class ScanTransfer : uint8_t {
+        IDLE,       // Nothing to send
+        WAITING,    // Scan held back until the running connect attempt ends
+        SCANNING,   // Scan running; partial results streamed as they arrive
+        SENDING,    // Streaming the remaining results, one notification per loop()
+        SENDING_CHANGES // Streaming changes to a subscribed client, one notification per loop()
+    };
+    ScanTransfer scanTransfer;
+    size_t scanSendIndex;
+    bool scanListStarted;       // List Start sent for the current transfer
+    bool scanListSent;          // Client has received a complete list this connection
+    bool scanRefreshPending;    // Rescan after sending a stale cached list
+    bool backgroundScanRefresh;
+    unsigned long lastScanRequest;
+
+    // Live network list updates (Scan Subscribe)
+    bool scanSubscribed;
+    bool scanDeltaUpdate;       // Current scan is sent as changes, not a full list
+    uint8_t deltaRssiThreshold;
+    unsigned long scanSubscriptionInterval;
+    WiFiSet::NetworkDeltaTracker clientNetworks;    // What the client's list holds
+    WiFiSet::NetworkChangeList networkChanges;
 
     // User callbacks
     std::function<void(const String&, const String&)> credentialsReceivedCallback;
@@ -235,6 +410,9 @@ private:
     void onClientConnected() override;
     void onClientDisconnected() override;
     void onStatusRequest() override;
+    void onScanSubscription(bool enabled, uint8_t rssiThreshold) override;
+    void onIPConfigReceived(const WiFiSet::IPConfigData& config) override;
+    void onSavedNetworkRequest(const WiFiSet::SavedNetworkRequest& request) override;
 
     /**
      * Convert internal ConnectionState to user-facing WiFiSetConnectionStatus
@@ -242,10 +420,127 @@ private:
     static WiFiSet::WiFiSetConnectionStatus convertConnectionState(WiFiSet::ConnectionState state);
 
     /**
-     * Handle WiFi connection with received credentials
+     * Save received credentials and start connecting (progress is reported from loop())
      */
     void handleWiFiConnection(const String& ssid, const String& password);
 
+    /**
+     * Start joining the best saved network in range (non-blocking, used at boot)
+     * A single saved network is joined without scanning. If no saved
+     * network shows up in the scan, the current network is still tried:
+     * it may hide its SSID.
+     */
+    void startBootConnect();
+
+    /**
+     * Pick the candidates once the boot scan completes (called from loop)
+     */
+    void processBootScan();
+
+    /**
+     * Connect to where the probe found the current network once it completes (called from loop)
+     */
+    void processBootProbe();
+
+    /**
+     * Start the next boot attempt
+     * @return false once every candidate has been tried
+     */
+    bool startNextBootAttempt();
+
+    /**
+     * Start the next attempt on the current network: its saved AP first,
+     * then a probe for where it moved (saved channel first) and the AP it
+     * finds, then any AP, each with the cached PMK if the AP takes one
+     * @return false once all have been tried
+     */
+    bool startCurrentBootAttempt(const WiFiSet::StoredCredentials& credentials);
+
+    /**
+     * Move on from a finished boot attempt
+     * @param reported A Status Response already went out for the attempt's events
+     */
+    void continueBootConnect(WiFiSet::WiFiConnectResult result, bool reported);
+
+    /**
+     * Report the outcome of the boot connect
+     */
+    void finishBootConnect(bool connected, bool reported);
+
+    /**
+     * Stop trying saved networks (an attempt already running is left to finish)
+     */
+    void cancelBootConnect();
+
+    /**
+     * Make a network just connected to the current one
+     * Its AP and PMK are saved afterwards like those of any stored network.
+     */
+    void adoptConnectedNetwork(const String& ssid, const String& password);
+
+    /**
+     * Load the saved network table and hand it to WiFiManager for scan matching
+     * @param networks Filled in the order WiFiManager::getSavedNetworks() reports them
+     */
+    void loadSavedNetworks(WiFiSet::StoredNetworkList& networks);
+
+    /**
+     * Reload the saved networks after the table changed
+     */
+    void refreshSavedNetworks();
+
+    /**
+     * Apply a Saved Network request from the client and answer it
+     */
+    void handleSavedNetworkRequest(const WiFiSet::SavedNetworkRequest& request);
+
+    /**
+     * Persist the AP of the connection that just succeeded (for the next boot)
+     */
+    void saveConnectedLocation();
+
+    /**
+     * Derive and persist the PMK of the connection that just succeeded
+     * Runs once per credential set, and only for WPA/WPA2-Personal APs.
+     */
+    void saveConnectedPMK(const String& ssid, const String& password);
+
+    /**
+     * Password for connecting to the stored network: its cached PMK if the AP
+     * takes one, otherwise the passphrase
+     * @param usedPMK Set to true if the PMK was returned
+     */
+    String storedConnectSecret(const WiFiSet::StoredCredentials& credentials, wifi_auth_mode_t authMode,
+                               bool& usedPMK);
+
+    /**
+     * Persist the DHCP lease just granted on the stored network (for the next boot)
+     */
+    void saveConnectedLease();
+
+    /**
+     * Save an IP configuration from the client and reconnect with it
+     */
+    void handleIPConfig(const WiFiSet::IPConfigData& config);
+
+    /**
+     * Pass the stored IP configuration and the stored network's DHCP lease to WiFiManager
+     */
+    void loadAddressSettings(const String& ssid);
+
+    /**
+     * Start a reconnect retry on the current network once its backoff delay is up
+     * The first retry of an outage goes straight to the last AP; later ones
+     * let the driver search every channel in case the AP moved.
+     */
+    void superviseReconnect();
+
+    /**
+     * Report WiFi events from WiFiManager::pollConnection() to the client
+     * @param events ConnectEvent bits
+     */
+    void handleConnectionEvents(uint8_t events);
+
     /**
      * Send current status to BLE client
      */
@@ -257,9 +552,41 @@ private:
     void monitorConnection();
 
     /**
-     * Trigger WiFi scan and send results to BLE client
+     * Serve the network list to a newly connected BLE client
+     * (from the scan cache when possible, otherwise from a new scan)
+     */
+    void startWiFiScan();
+
+    /**
+     * Start an asynchronous scan whose results will be sent to the client
+     */
+    void requestWiFiScan();
+
+    /**
+     * Handle a scan that could not start or failed
+     */
+    void finishFailedScan();
+
+    /**
+     * Start streaming the current scan results to the client
+     */
+    void beginNetworkListTransfer();
+
+    /**
+     * Advance the scan / network list transfer (non-blocking, called from loop)
+     */
+    void processWiFiScan();
+
+    /**
+     * Apply a client's Scan Subscribe request
+     */
+    void updateScanSubscription(bool enabled, uint8_t rssiThreshold);
+
+    /**
+     * Send List Start or the next unsent networks (one notification)
+     * @return true if a notification was sent
      */
-    void performWiFiScanAndSend();
+    bool sendNextNetworks(const WiFiSet::NetworkList& networks);
 };
 
 #endif // WIFISET_ESP32_H
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <ControllerQueueModel.h>
+#include <BLEService/NotificationFlowControl.h>
+
+using namespace WiFiSet;
+
+/**
+ * Notification pacing against the controller queue model
+ *
+ * Wall time is the cost of the pacing logic itself. The counters report
+ * the simulated link: "link_ms" to get a 64-notification list on air,
+ * "notify_per_s" in link time, and "overflowed" notifications the
+ * controller had to refuse.
+ */
+namespace {
+
+const uint32_t LIST_NOTIFICATIONS = 64;
+const uint32_t LEGACY_DELAY_US = 100000;     // delay(100) between notifications
+
+LinkProfile profile(int64_t index) {
+    switch (index) {
+        case 0:
+            return LinkProfile::fast();
+        case 1:
+            return LinkProfile::typical();
+        default:
+            return LinkProfile::slow();
+    }
+}
+
+/**
+ * Send a list with credit pacing (delayUs == 0) or fixed pacing; the model is deterministic
+ */
+void sendList(benchmark::State& state, uint32_t delayUs) {
+    uint64_t linkUs = 0;
+    uint32_t overflowed = 0;
+    for (auto _ : state) {
+        NotificationFlowControl flow;
+        ControllerQueueModel link(flow, profile(state.range(0)));
+        for (uint32_t i = 0; i < LIST_NOTIFICATIONS; i++) {
+            if (delayUs == 0) {
+                link.send();
+            } else {
+                link.sendPaced(delayUs);
+            }
+        }
+        link.drain();
+        linkUs = link.nowUs();
+        overflowed = link.stats().overflowed;
+    }
+
+    state.counters["link_ms"] = static_cast<double>(linkUs) / 1000.0;
+    state.counters["notify_per_s"] = LIST_NOTIFICATIONS * 1e6 / static_cast<double>(linkUs);
+    state.counters["overflowed"] = overflowed;
+}
+
+} // namespace
+
+// Arg: 0 = fast, 1 = typical, 2 = slow link
+static void BM_CreditPacing(benchmark::State& state) {
+    sendList(state, 0);
+}
+BENCHMARK(BM_CreditPacing)->DenseRange(0, 2);
+
+static void BM_FixedDelayPacing(benchmark::State& state) {
+    sendList(state, LEGACY_DELAY_US);
+}
+BENCHMARK(BM_FixedDelayPacing)->DenseRange(0, 2);
+
+// Arg: credits
+static void BM_CreditCycle(benchmark::State& state) {
+    NotificationFlowControl flow(static_cast<uint8_t>(state.range(0)));
+    for (auto _ : state) {
+        while (flow.canSend()) {
+            flow.onSent();
+        }
+        while (flow.getInFlight() > 0) {
+            flow.onComplete();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreditCycle)->Arg(1)->Arg(8)->Arg(32);
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include <AllocationCounter.h>
+#include <SyntheticScan.h>
+#include <WiFiManager/NetworkSelector.h>
+#include <algorithm>
+
+using namespace WiFiSet;
+
+/**
+ * SSID merge and top-K selection over synthetic 200-AP scans
+ *
+ * Arg 0: scene (0 = 200 distinct SSIDs, 1 = 40 mesh networks of 5 APs,
+ *        2 = 60 SSIDs with 10% hidden APs); Arg 1: K.
+ * "allocs" is heap allocations per scan (expected 0).
+ */
+namespace {
+
+const size_t SCAN_APS = 200;
+
+SyntheticScan scene(int64_t index) {
+    switch (index) {
+        case 0:
+            return SyntheticScan(SCAN_APS, SCAN_APS);
+        case 1:
+            return SyntheticScan(SCAN_APS, 40);
+        default:
+            return SyntheticScan(SCAN_APS, 60, 10);
+    }
+}
+
+void sceneArgs(benchmark::internal::Benchmark* benchmark) {
+    for (int scene = 0; scene <= 2; scene++) {
+        for (int k : {10, 20, 64}) {
+            benchmark->Args({scene, k});
+        }
+    }
+}
+
+} // namespace
+
+static void BM_SelectTopK(benchmark::State& state) {
+    std::vector<WiFiNetworkInfo> scan = scene(state.range(0)).generate();
+    size_t k = static_cast<size_t>(state.range(1));
+    NetworkSelector selector;
+    NetworkList results;
+
+    AllocationCounter::Scope scope;
+    for (auto _ : state) {
+        selector.clear();
+        for (const WiFiNetworkInfo& ap : scan) {
+            selector.add(ap);
+        }
+        selector.selectTop(k, results);
+        benchmark::DoNotOptimize(results);
+    }
+
+    state.counters["allocs"] = static_cast<double>(scope.allocations()) / static_cast<double>(state.iterations());
+    state.counters["merged"] = static_cast<double>(selector.size());
+    state.counters["kept"] = static_cast<double>(results.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * scan.size()));
+}
+BENCHMARK(BM_SelectTopK)->Apply(sceneArgs);
+
+// Reference: merge then fully sort the candidates (what selectTop's heap avoids)
+static void BM_SelectBySort(benchmark::State& state) {
+    std::vector<WiFiNetworkInfo> scan = scene(state.range(0)).generate();
+    size_t k = static_cast<size_t>(state.range(1));
+    NetworkSelector selector;
+    NetworkList results;
+
+    for (auto _ : state) {
+        selector.clear();
+        for (const WiFiNetworkInfo& ap : scan) {
+            selector.add(ap);
+        }
+        results = selector.getCandidates();
+        std::sort(results.begin(), results.end(),
+                  [](const WiFiNetworkInfo& a, const WiFiNetworkInfo& b) { return a.rssi > b.rssi; });
+        while (results.size() > k) {
+            results.pop_back();
+        }
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * scan.size()));
+}
+BENCHMARK(BM_SelectBySort)->Apply(sceneArgs);
+
+// Selection alone, on an already merged scan
+static void BM_SelectOnly(benchmark::State& state) {
+    std::vector<WiFiNetworkInfo> scan = scene(state.range(0)).generate();
+    size_t k = static_cast<size_t>(state.range(1));
+    NetworkSelector selector;
+    for (const WiFiNetworkInfo& ap : scan) {
+        selector.add(ap);
+    }
+    NetworkList results;
+
+    for (auto _ : state) {
+        selector.selectTop(k, results);
+        benchmark::DoNotOptimize(results);
+    }
+}
+BENCHMARK(BM_SelectOnly)->Apply(sceneArgs);
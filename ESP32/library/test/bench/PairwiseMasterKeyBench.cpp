@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <WiFiManager/PairwiseMasterKey.h>
+
+using namespace WiFiSet;
+
+/**
+ * The connect-time cost a cached PMK removes
+ *
+ * BM_DerivePMK is the PBKDF2-HMAC-SHA1 derivation (4096 iterations) the
+ * supplicant repeats on every connect given a passphrase; Arg 0 is the
+ * passphrase length. BM_UseStoredPMK is what a connect pays instead: adopt
+ * the stored key and format it for WiFi.begin(). The host build runs
+ * PBKDF2 on OpenSSL; on the device mbedTLS takes far longer, so compare
+ * the two rows rather than the absolute times.
+ */
+namespace {
+
+void BM_DerivePMK(benchmark::State& state) {
+    String ssid("ThisIsASSID");
+    String passphrase(std::string(static_cast<size_t>(state.range(0)), 'p').c_str());
+    PairwiseMasterKey pmk;
+
+    for (auto _ : state) {
+        bool derived = pmk.derive(ssid, passphrase);
+        benchmark::DoNotOptimize(derived);
+        benchmark::DoNotOptimize(pmk.key);
+    }
+}
+BENCHMARK(BM_DerivePMK)->Arg(MIN_PASSPHRASE_LENGTH)->Arg(32)->Arg(MAX_PASSPHRASE_LENGTH)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_UseStoredPMK(benchmark::State& state) {
+    PairwiseMasterKey derived;
+    derived.derive("ThisIsASSID", "ThisIsAPassword");
+
+    for (auto _ : state) {
+        PairwiseMasterKey pmk;
+        pmk.set(derived.key);
+        String psk = pmk.toPSK();
+        benchmark::DoNotOptimize(psk.c_str());
+    }
+}
+BENCHMARK(BM_UseStoredPMK);
+
+} // namespace
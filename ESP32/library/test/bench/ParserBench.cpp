@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <Protocol/ProtocolHandler.h>
+
+using namespace WiFiSet;
+
+/**
+ * Streaming parser throughput (bytes_per_second, reported as MB/s)
+ *
+ * A capture of mixed client requests is fed to ProtocolHandler::feed() in
+ * chunks of a given size, as BLE writes (MTU - 3), serial reads or a
+ * replayed capture would deliver it. Each byte is parsed once.
+ */
+namespace {
+
+const size_t CAPTURE_MESSAGES = 1024;
+
+/**
+ * Back-to-back requests in the mix a provisioning session sends
+ */
+std::vector<uint8_t> makeCapture() {
+    std::vector<uint8_t> capture;
+    uint8_t buffer[128];
+    uint8_t sequence = 0;
+
+    for (size_t i = 0; i < CAPTURE_MESSAGES; i++) {
+        size_t length;
+        switch (i % 6) {
+            case 0:
+                length = HelloSchema::encode(buffer, sizeof(buffer), sequence++, 1, 5, 0x0073, 517);
+                break;
+            case 1:
+                length = CredentialWriteSchema::encode(buffer, sizeof(buffer), sequence++,
+                                                       Schema::StringRef("Home-Network-5G"),
+                                                       Schema::StringRef("correct horse battery staple"));
+                break;
+            case 2:
+                length = StatusRequestSchema::encode(buffer, sizeof(buffer), sequence++);
+                break;
+            case 3:
+                length = IPConfigWriteSchema::encode(buffer, sizeof(buffer), sequence++, IPMode::STATIC,
+                                                     IPAddress(192, 168, 1, 50), IPAddress(255, 255, 255, 0),
+                                                     IPAddress(192, 168, 1, 1), IPAddress(1, 1, 1, 1),
+                                                     IPAddress(8, 8, 8, 8));
+                break;
+            case 4:
+                length = SavedNetworkAddSchema::encode(buffer, sizeof(buffer), sequence++,
+                                                       Schema::StringRef("Office"), Schema::StringRef("hunter22"), 3);
+                break;
+            default:
+                length = ScanSubscribeSchema::encode(buffer, sizeof(buffer), sequence++, 1, 5);
+                break;
+        }
+        capture.insert(capture.end(), buffer, buffer + length);
+    }
+    return capture;
+}
+
+} // namespace
+
+// Arg: chunk size in bytes (1 = byte at a time, 20/182/514 = MTU 23/185/517 writes, 0 = whole capture)
+static void BM_ParseStream(benchmark::State& state) {
+    std::vector<uint8_t> capture = makeCapture();
+    size_t chunkSize = state.range(0) > 0 ? static_cast<size_t>(state.range(0)) : capture.size();
+    ProtocolHandler handler;
+    size_t messages = 0;
+
+    for (auto _ : state) {
+        messages = 0;
+        for (size_t chunk = 0; chunk < capture.size(); chunk += chunkSize) {
+            size_t end = chunk + chunkSize < capture.size() ? chunk + chunkSize : capture.size();
+            size_t offset = chunk;
+            while (offset < end) {
+                size_t consumed = 0;
+                if (handler.feed(capture.data() + offset, end - offset, consumed) == ParseResult::MESSAGE_READY) {
+                    messages++;
+                    benchmark::DoNotOptimize(handler.getMessage());
+                }
+                offset += consumed;
+            }
+        }
+    }
+
+    if (messages != CAPTURE_MESSAGES) {
+        state.SkipWithError("capture did not parse");
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * capture.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * CAPTURE_MESSAGES));
+}
+BENCHMARK(BM_ParseStream)->Arg(1)->Arg(20)->Arg(182)->Arg(514)->Arg(0);
+
+// One-shot parse of a complete buffer (the pre-streaming API, now a wrapper over feed())
+static void BM_ParseCredentialWrite(benchmark::State& state) {
+    uint8_t buffer[CredentialWriteSchema::maxSize];
+    size_t length = CredentialWriteSchema::encode(buffer, sizeof(buffer), 1, Schema::StringRef("Home-Network-5G"),
+                                                  Schema::StringRef("correct horse battery staple"));
+    ProtocolHandler handler;
+
+    for (auto _ : state) {
+        CredentialData credentials = handler.parseCredentialWrite(buffer, length);
+        benchmark::DoNotOptimize(credentials);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * length));
+}
+BENCHMARK(BM_ParseCredentialWrite);
@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+#include <AllocationCounter.h>
+#include <Protocol/MessageBuilder.h>
+#include <Protocol/ProtocolHandler.h>
+
+using namespace WiFiSet;
+
+/**
+ * Encode and decode latency per message type
+ *
+ * Every benchmark reports "allocs" and "bytes": heap allocations (and the
+ * bytes they asked for) per iteration. The encode*() and feed() paths are
+ * expected to stay at zero; the build*() variants show what the vector API
+ * costs for comparison.
+ */
+namespace {
+
+/**
+ * Run the timed loop with allocation counting and report per-iteration counts
+ */
+template <typename Body>
+void measure(benchmark::State& state, Body body) {
+    AllocationCounter::Scope scope;
+    for (auto _ : state) {
+        body();
+    }
+    double iterations = static_cast<double>(state.iterations());
+    state.counters["allocs"] = static_cast<double>(scope.allocations()) / iterations;
+    state.counters["bytes"] = static_cast<double>(scope.bytes()) / iterations;
+}
+
+WiFiNetworkInfo makeNetwork(size_t index) {
+    WiFiNetworkInfo network = WiFiNetworkInfo();
+    char ssid[MAX_SSID_LENGTH + 1];
+    snprintf(ssid, sizeof(ssid), "Network-%02u-Neighbourhood", static_cast<unsigned>(index));
+    network.setSSID(ssid);
+    network.rssi = static_cast<int8_t>(-40 - static_cast<int>(index % 50));
+    network.securityType = SecurityType::WPA_PSK;
+    network.channel = static_cast<uint8_t>(1 + index % 13);
+    return network;
+}
+
+NetworkList makeNetworks(size_t count) {
+    NetworkList networks;
+    for (size_t i = 0; i < count; i++) {
+        networks.push_back(makeNetwork(i));
+    }
+    return networks;
+}
+
+/**
+ * Feed a complete message and require MESSAGE_READY
+ */
+void decode(benchmark::State& state, const uint8_t* data, size_t length) {
+    ProtocolHandler handler;
+    measure(state, [&] {
+        size_t consumed = 0;
+        ParseResult result = handler.feed(data, length, consumed);
+        if (result != ParseResult::MESSAGE_READY) {
+            state.SkipWithError("message rejected");
+        }
+        benchmark::DoNotOptimize(handler.getMessage());
+    });
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * length));
+}
+
+} // namespace
+
+// ==================== Encode ====================
+
+static void BM_EncodeNetworkEntry(benchmark::State& state) {
+    MessageBuilder builder;
+    WiFiNetworkInfo network = makeNetwork(7);
+    uint8_t buffer[MAX_NETWORK_ENTRY_SIZE];
+    measure(state, [&] {
+        benchmark::DoNotOptimize(builder.encodeWiFiNetworkEntry(network, buffer, sizeof(buffer)));
+    });
+}
+BENCHMARK(BM_EncodeNetworkEntry);
+
+static void BM_BuildNetworkEntry(benchmark::State& state) {
+    MessageBuilder builder;
+    WiFiNetworkInfo network = makeNetwork(7);
+    measure(state, [&] {
+        benchmark::DoNotOptimize(builder.buildWiFiNetworkEntry(network));
+    });
+}
+BENCHMARK(BM_BuildNetworkEntry);
+
+// Arg: ATT payload capacity (MTU - 3) for MTU 185, 247 and 512
+static void BM_EncodeNetworkBatch(benchmark::State& state) {
+    MessageBuilder builder;
+    NetworkList networks = makeNetworks(MAX_NETWORK_LIST_SIZE);
+    size_t capacity = static_cast<size_t>(state.range(0));
+    uint8_t buffer[512];
+    measure(state, [&] {
+        size_t index = 0;
+        while (index < networks.size()) {
+            size_t count = 0;
+            benchmark::DoNotOptimize(builder.encodeWiFiNetworkBatch(networks, index, buffer, capacity, count));
+            if (count == 0) {
+                state.SkipWithError("entry does not fit");
+                return;
+            }
+            index += count;
+        }
+    });
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * networks.size()));
+}
+BENCHMARK(BM_EncodeNetworkBatch)->Arg(182)->Arg(244)->Arg(509);
+
+static void BM_EncodeStatusResponse(benchmark::State& state) {
+    MessageBuilder builder;
+    String ssid("HomeNetwork");
+    IPAddress ip(192, 168, 1, 42);
+    uint8_t buffer[MAX_STATUS_RESPONSE_SIZE];
+    measure(state, [&] {
+        benchmark::DoNotOptimize(
+            builder.encodeStatusResponse(ConnectionState::CONNECTED, -52, ip, ssid, 0, buffer, sizeof(buffer)));
+    });
+}
+BENCHMARK(BM_EncodeStatusResponse);
+
+static void BM_EncodeCredentialWriteAck(benchmark::State& state) {
+    MessageBuilder builder;
+    uint8_t buffer[MAX_CREDENTIAL_ACK_SIZE];
+    measure(state, [&] {
+        benchmark::DoNotOptimize(builder.encodeCredentialWriteAck(0, buffer, sizeof(buffer)));
+    });
+}
+BENCHMARK(BM_EncodeCredentialWriteAck);
+
+static void BM_EncodeError(benchmark::State& state) {
+    MessageBuilder builder;
+    uint8_t buffer[MAX_ERROR_SIZE];
+    measure(state, [&] {
+        benchmark::DoNotOptimize(
+            builder.encodeError(ErrorCode::INVALID_MESSAGE_FORMAT, "Malformed message", buffer, sizeof(buffer)));
+    });
+}
+BENCHMARK(BM_EncodeError);
+
+// ==================== Decode ====================
+
+static void BM_DecodeCredentialWrite(benchmark::State& state) {
+    uint8_t buffer[CredentialWriteSchema::maxSize];
+    size_t length = CredentialWriteSchema::encode(buffer, sizeof(buffer), 1, Schema::StringRef("HomeNetwork"),
+                                                  Schema::StringRef("correct horse battery staple"));
+    decode(state, buffer, length);
+}
+BENCHMARK(BM_DecodeCredentialWrite);
+
+static void BM_DecodeStatusRequest(benchmark::State& state) {
+    uint8_t buffer[StatusRequestSchema::maxSize];
+    size_t length = StatusRequestSchema::encode(buffer, sizeof(buffer), 1);
+    decode(state, buffer, length);
+}
+BENCHMARK(BM_DecodeStatusRequest);
+
+static void BM_DecodeIPConfigWrite(benchmark::State& state) {
+    uint8_t buffer[IPConfigWriteSchema::maxSize];
+    size_t length = IPConfigWriteSchema::encode(buffer, sizeof(buffer), 1, IPMode::STATIC,
+                                                IPAddress(192, 168, 1, 50), IPAddress(255, 255, 255, 0),
+                                                IPAddress(192, 168, 1, 1), IPAddress(1, 1, 1, 1), IPAddress());
+    decode(state, buffer, length);
+}
+BENCHMARK(BM_DecodeIPConfigWrite);
+
+static void BM_DecodeSavedNetworkAdd(benchmark::State& state) {
+    uint8_t buffer[SavedNetworkAddSchema::maxSize];
+    size_t length = SavedNetworkAddSchema::encode(buffer, sizeof(buffer), 1, Schema::StringRef("Office"),
+                                                  Schema::StringRef("password123"), 5);
+    decode(state, buffer, length);
+}
+BENCHMARK(BM_DecodeSavedNetworkAdd);
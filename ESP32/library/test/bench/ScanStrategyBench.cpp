@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <HostControl.h>
+#include <RadioScene.h>
+#include <memory>
+
+using namespace WiFiSet;
+
+/**
+ * Scan latency against networks found, per scene and ScanConfig
+ *
+ * Arg 0: RadioScene (home, office, hidden, sensors); Arg 1: ScanStrategy.
+ * The reported time is the simulated radio's virtual scan latency, not
+ * host time. "found" counts named networks, "complete" is found over what
+ * the scene offers, "hidden" counts nameless entries, "radio_ms" the time
+ * the radio itself spent scanning (less than the latency when sliced).
+ */
+namespace {
+
+void sceneArgs(benchmark::internal::Benchmark* benchmark) {
+    for (int scene = 0; scene < RadioScene::COUNT; scene++) {
+        for (int strategy = 0; strategy < ScanStrategy::COUNT; strategy++) {
+            benchmark->Args({scene, strategy});
+        }
+    }
+}
+
+void BM_ScanStrategy(benchmark::State& state) {
+    RadioScene scene = RadioScene::get(static_cast<int>(state.range(0)));
+    ScanStrategy strategy = ScanStrategy::get(static_cast<int>(state.range(1)));
+
+    Host::reset();
+    scene.install();
+    std::unique_ptr<WiFiManager> manager(new WiFiManager());
+    manager->begin();
+
+    ScanOutcome outcome = ScanOutcome();
+    for (auto _ : state) {
+        outcome = ScanOutcome::run(*manager, strategy);
+        state.SetIterationTime(outcome.latencyMs / 1000.0);
+    }
+
+    state.SetLabel(std::string(scene.name) + "/" + strategy.name);
+    state.counters["found"] = static_cast<double>(outcome.found);
+    state.counters["complete"] = static_cast<double>(outcome.found) / static_cast<double>(scene.networks);
+    state.counters["hidden"] = static_cast<double>(outcome.hidden);
+    state.counters["radio_ms"] = outcome.radioMs;
+
+    manager.reset();
+    Host::reset();
+}
+BENCHMARK(BM_ScanStrategy)->Apply(sceneArgs)->UseManualTime()->Unit(benchmark::kMillisecond)->Iterations(3);
+
+} // namespace
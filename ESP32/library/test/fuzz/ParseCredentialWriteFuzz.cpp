@@ -0,0 +1,49 @@
+// Fuzz target for ProtocolHandler::parseCredentialWrite and the streaming parser behind it
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "Protocol/ProtocolHandler.h"
+
+using namespace WiFiSet;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    ProtocolHandler handler;
+    CredentialData credentials = handler.parseCredentialWrite(data, size);
+    if (!credentials.isValid) {
+        return 0;
+    }
+
+    // Accepted credentials are the message's strings, cut at the first NUL (they are stored as C strings)
+    Schema::StringRef ssid;
+    Schema::StringRef password;
+    if (size < MESSAGE_HEADER_SIZE ||
+        !CredentialWriteSchema::decode(data + MESSAGE_HEADER_SIZE, size - MESSAGE_HEADER_SIZE, ssid, password)) {
+        abort();
+    }
+    if (ssid.length == 0 || ssid.length > MAX_SSID_LENGTH || password.length > MAX_PASSWORD_LENGTH) {
+        abort();
+    }
+    if (credentials.ssid.length() != strnlen(ssid.data, ssid.length) ||
+        memcmp(credentials.ssid.c_str(), ssid.data, credentials.ssid.length()) != 0 ||
+        credentials.password.length() != strnlen(password.data, password.length) ||
+        memcmp(credentials.password.c_str(), password.data, credentials.password.length()) != 0) {
+        abort();
+    }
+
+    // The streaming parser reaches the same result one byte at a time
+    ProtocolHandler streaming;
+    ParseResult result = ParseResult::NEED_MORE;
+    for (size_t i = 0; i < size; i++) {
+        size_t consumed = 0;
+        result = streaming.feed(data + i, 1, consumed);
+        if (consumed != 1 || (result != ParseResult::NEED_MORE && i + 1 != size)) {
+            abort();
+        }
+    }
+    const CredentialData& streamed = streaming.getMessage().credentials;
+    if (result != ParseResult::MESSAGE_READY || streamed.ssid != credentials.ssid ||
+        streamed.password != credentials.password) {
+        abort();
+    }
+    return 0;
+}
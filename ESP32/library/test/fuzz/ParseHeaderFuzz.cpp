@@ -0,0 +1,27 @@
+// Fuzz target for ProtocolHandler::parseHeader and validateMessage
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "Protocol/ProtocolHandler.h"
+
+using namespace WiFiSet;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    ProtocolHandler handler;
+    MessageHeader header = handler.parseHeader(data, size);
+
+    // A header is valid exactly when the 4 header bytes are there
+    if (header.isValid != (size >= MESSAGE_HEADER_SIZE)) {
+        abort();
+    }
+    if (header.isValid && header.payloadLength != (data[2] | (data[3] << 8))) {
+        abort();
+    }
+
+    // A valid message is a valid header followed by exactly its payload
+    if (handler.validateMessage(data, size) &&
+        (!header.isValid || size != MESSAGE_HEADER_SIZE + header.payloadLength)) {
+        abort();
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Stand-in for libFuzzer's driver when the compiler has none (GCC): runs the
+// target once on every file named on the command line or found in a named
+// directory, so the corpus doubles as a regression suite under ctest.
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+bool runFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "Cannot read %s\n", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t runs = 0;
+    for (int i = 1; i < argc; i++) {
+        std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path)) {
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.is_regular_file()) {
+                    if (!runFile(entry.path())) {
+                        return 1;
+                    }
+                    runs++;
+                }
+            }
+        } else {
+            if (!runFile(path)) {
+                return 1;
+            }
+            runs++;
+        }
+    }
+
+    printf("Replayed %zu inputs\n", runs);
+    return runs > 0 ? 0 : 1;
+}
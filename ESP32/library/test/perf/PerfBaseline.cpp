@@ -0,0 +1,331 @@
+#include <AllocationCounter.h>
+#include <Protocol/MessageBuilder.h>
+#include <Protocol/ProtocolHandler.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace WiFiSet;
+
+/**
+ * Encode/decode regression check against a checked-in baseline
+ *
+ *   wifiset_perf baseline.txt             Check: fail on more allocations or slower messages
+ *   wifiset_perf --no-timing baseline.txt Check allocations only (debug and sanitizer builds)
+ *   wifiset_perf --update baseline.txt    Record a new baseline
+ *
+ * Every message type is measured: encode*() for messages the ESP32 sends,
+ * feed() for messages it receives. Times are the fastest of several
+ * samples and are scaled by a calibration loop run alongside, so a baseline
+ * recorded on one machine still applies on a faster or slower one. A
+ * message fails if it allocates more than its baseline or takes longer than
+ * the scaled baseline times WIFISET_PERF_TOLERANCE (default 1.5).
+ */
+namespace {
+
+const int SAMPLES = 15;
+const int ITERATIONS = 20000;
+const double DEFAULT_TOLERANCE = 1.5;
+const double SLACK_NS = 2.0;    // Timer noise on the fastest messages
+
+struct Result {
+    uint64_t allocations;
+    double ns;
+};
+
+struct Case {
+    std::string name;
+    std::function<void()> run;
+};
+
+volatile uint32_t sink;
+
+/**
+ * Fixed CPU workload the message times are scaled by
+ */
+void calibrate() {
+    static uint8_t data[256];
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        hash = (hash ^ static_cast<uint8_t>(data[i] + i)) * 16777619u;
+    }
+    sink = hash;
+}
+
+uint64_t countAllocations(const std::function<void()>& run) {
+    run();  // Warm up (first-use allocations are not per message)
+    AllocationCounter::Scope scope;
+    run();
+    return scope.allocations();
+}
+
+double timeOnce(const std::function<void()>& run) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        run();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+/**
+ * Fastest time of each case over SAMPLES rounds
+ * Rounds run every case in turn, so a burst of load on the machine
+ * lands on one sample of many cases rather than all samples of one.
+ */
+std::vector<double> timeAll(const std::vector<Case>& cases) {
+    std::vector<double> best(cases.size(), 1e30);
+    for (int sample = 0; sample < SAMPLES; sample++) {
+        for (size_t i = 0; i < cases.size(); i++) {
+            best[i] = std::min(best[i], timeOnce(cases[i].run));
+        }
+    }
+    return best;
+}
+
+WiFiNetworkInfo makeNetwork(size_t index) {
+    WiFiNetworkInfo network = WiFiNetworkInfo();
+    char ssid[MAX_SSID_LENGTH + 1];
+    snprintf(ssid, sizeof(ssid), "Neighbour-Network-%02u", static_cast<unsigned>(index));
+    network.setSSID(ssid);
+    network.rssi = static_cast<int8_t>(-40 - static_cast<int>(index));
+    network.securityType = SecurityType::WPA_PSK;
+    network.channel = static_cast<uint8_t>(1 + index % 13);
+    return network;
+}
+
+std::vector<uint8_t> encoded(size_t (*encode)(uint8_t*, size_t)) {
+    uint8_t buffer[128];
+    return std::vector<uint8_t>(buffer, buffer + encode(buffer, sizeof(buffer)));
+}
+
+/**
+ * Feed one complete message
+ */
+std::function<void()> decode(const std::vector<uint8_t>& message) {
+    std::shared_ptr<ProtocolHandler> handler = std::make_shared<ProtocolHandler>();
+    return [handler, message] {
+        size_t consumed = 0;
+        if (handler->feed(message.data(), message.size(), consumed) != ParseResult::MESSAGE_READY) {
+            abort();
+        }
+    };
+}
+
+std::vector<Case> cases() {
+    static MessageBuilder builder;
+    static uint8_t buffer[600];
+    static NetworkList networks;
+    static NetworkChangeList changes;
+    static SavedNetworkList saved;
+    static String ssid("HomeNetwork-5G");
+    static String errorMessage("Credential write failed: storage unavailable");
+
+    for (size_t i = 0; networks.size() < 16; i++) {
+        networks.push_back(makeNetwork(i));
+        changes.push_back(NetworkChange(i % 3 == 0 ? NetworkChangeType::REMOVED : NetworkChangeType::UPDATED,
+                                        makeNetwork(i)));
+    }
+    for (size_t i = 0; saved.size() < MAX_SAVED_NETWORKS; i++) {
+        SavedNetworkInfo info = SavedNetworkInfo();
+        info.setSSID(makeNetwork(i).ssid);
+        info.priority = static_cast<uint8_t>(i);
+        saved.push_back(info);
+    }
+
+    std::vector<Case> list;
+    list.push_back({"calibration", calibrate});
+
+    // ESP32 -> client
+    list.push_back({"encode.list_start", [] { sink = builder.encodeWiFiListStart(buffer, sizeof(buffer)); }});
+    list.push_back({"encode.network_entry",
+                    [] { sink = builder.encodeWiFiNetworkEntry(networks[0], buffer, sizeof(buffer)); }});
+    list.push_back({"encode.network_batch", [] {
+                        size_t count = 0;
+                        sink = builder.encodeWiFiNetworkBatch(networks, 0, buffer, 514, count);
+                    }});
+    list.push_back({"encode.list_end", [] { sink = builder.encodeWiFiListEnd(16, buffer, sizeof(buffer)); }});
+    list.push_back({"encode.network_delta", [] {
+                        size_t count = 0;
+                        sink = builder.encodeWiFiNetworkDelta(changes, 0, buffer, 514, count);
+                    }});
+    list.push_back({"encode.credential_ack", [] { sink = builder.encodeCredentialWriteAck(0, buffer, sizeof(buffer)); }});
+    list.push_back({"encode.ip_config_ack", [] { sink = builder.encodeIPConfigAck(0, buffer, sizeof(buffer)); }});
+    list.push_back({"encode.saved_network_list",
+                    [] { sink = builder.encodeSavedNetworkList(saved, buffer, sizeof(buffer)); }});
+    list.push_back({"encode.saved_network_ack", [] {
+                        sink = builder.encodeSavedNetworkAck(MessageType::SAVED_NETWORK_ADD, 0, buffer, sizeof(buffer));
+                    }});
+    list.push_back({"encode.status_response", [] {
+                        sink = builder.encodeStatusResponse(ConnectionState::CONNECTED, -52, IPAddress(192, 168, 1, 42),
+                                                            ssid, 0, buffer, sizeof(buffer));
+                    }});
+    list.push_back({"encode.capabilities", [] {
+                        sink = builder.encodeCapabilities(SUPPORTED_FEATURES, 517, SUPPORTED_FEATURES, buffer, sizeof(buffer));
+                    }});
+    list.push_back({"encode.error", [] {
+                        sink = builder.encodeError(ErrorCode::CREDENTIAL_WRITE_FAILED, errorMessage, buffer,
+                                                   sizeof(buffer));
+                    }});
+
+    // Client -> ESP32
+    list.push_back({"decode.scan_subscribe", decode(encoded([](uint8_t* b, size_t c) {
+                        return ScanSubscribeSchema::encode(b, c, 0, 1, 5);
+                    }))});
+    list.push_back({"decode.credential_write", decode(encoded([](uint8_t* b, size_t c) {
+                        return CredentialWriteSchema::encode(b, c, 0, Schema::StringRef("HomeNetwork-5G"),
+                                                             Schema::StringRef("correct horse battery"));
+                    }))});
+    list.push_back({"decode.ip_config_write", decode(encoded([](uint8_t* b, size_t c) {
+                        return IPConfigWriteSchema::encode(b, c, 0, IPMode::STATIC, IPAddress(192, 168, 1, 50),
+                                                           IPAddress(255, 255, 255, 0), IPAddress(192, 168, 1, 1),
+                                                           IPAddress(), IPAddress());
+                    }))});
+    list.push_back({"decode.saved_network_add", decode(encoded([](uint8_t* b, size_t c) {
+                        return SavedNetworkAddSchema::encode(b, c, 0, Schema::StringRef("Office"),
+                                                             Schema::StringRef("secret1"), 10);
+                    }))});
+    list.push_back({"decode.saved_network_remove", decode(encoded([](uint8_t* b, size_t c) {
+                        return SavedNetworkRemoveSchema::encode(b, c, 0, Schema::StringRef("Office"));
+                    }))});
+    list.push_back({"decode.saved_network_priority", decode(encoded([](uint8_t* b, size_t c) {
+                        return SavedNetworkPrioritySchema::encode(b, c, 0, Schema::StringRef("Office"), 3);
+                    }))});
+    list.push_back({"decode.saved_network_list_request", decode(encoded([](uint8_t* b, size_t c) {
+                        return SavedNetworkListRequestSchema::encode(b, c, 0);
+                    }))});
+    list.push_back({"decode.status_request", decode(encoded([](uint8_t* b, size_t c) {
+                        return StatusRequestSchema::encode(b, c, 0);
+                    }))});
+    list.push_back({"decode.hello", decode(encoded([](uint8_t* b, size_t c) {
+                        return HelloSchema::encode(b, c, 0, 1, 5, 0x0073, 185);
+                    }))});
+    return list;
+}
+
+bool readBaseline(const char* path, std::map<std::string, Result>& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string name;
+        Result result;
+        if (fields >> name >> result.allocations >> result.ns) {
+            out[name] = result;
+        }
+    }
+    return true;
+}
+
+bool writeBaseline(const char* path, const std::vector<std::pair<std::string, Result>>& results) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "# Encode/decode baseline checked by wifiset_perf (see test/perf/PerfBaseline.cpp)\n"
+         << "# Regenerate with: wifiset_perf --update <this file> (release build, idle machine)\n"
+         << "# <name> <allocations per message> <ns per message>\n";
+    for (const auto& entry : results) {
+        char ns[32];
+        snprintf(ns, sizeof(ns), "%.1f", entry.second.ns);
+        file << entry.first << ' ' << entry.second.allocations << ' ' << ns << '\n';
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool update = false;
+    bool timing = true;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--update") {
+            update = true;
+        } else if (arg == "--no-timing") {
+            timing = false;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        fprintf(stderr, "usage: %s [--update] [--no-timing] baseline.txt\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Case> all = cases();
+    std::vector<double> times = timeAll(all);
+    std::vector<std::pair<std::string, Result>> results;
+    for (size_t i = 0; i < all.size(); i++) {
+        Result result;
+        result.allocations = countAllocations(all[i].run);
+        result.ns = times[i];
+        results.emplace_back(all[i].name, result);
+    }
+
+    if (update) {
+        if (!writeBaseline(path, results)) {
+            fprintf(stderr, "Cannot write %s\n", path);
+            return 2;
+        }
+        printf("Wrote %zu entries to %s\n", results.size(), path);
+        return 0;
+    }
+
+    std::map<std::string, Result> baseline;
+    if (!readBaseline(path, baseline) || baseline.count("calibration") == 0) {
+        fprintf(stderr, "Cannot read a baseline from %s\n", path);
+        return 2;
+    }
+
+    const char* toleranceEnv = getenv("WIFISET_PERF_TOLERANCE");
+    double tolerance = toleranceEnv != nullptr ? atof(toleranceEnv) : DEFAULT_TOLERANCE;
+    double scale = results[0].second.ns / baseline["calibration"].ns;
+    printf("Machine speed vs baseline: %.2fx time, tolerance %.2fx%s\n", scale, tolerance,
+           timing ? "" : " (timing not checked)");
+    printf("%-36s %7s %7s %9s %9s\n", "message", "allocs", "base", "ns", "limit");
+
+    int failures = 0;
+    for (const auto& entry : results) {
+        if (entry.first == "calibration") {
+            continue;
+        }
+        auto found = baseline.find(entry.first);
+        if (found == baseline.end()) {
+            printf("%-36s missing from the baseline (run with --update)\n", entry.first.c_str());
+            failures++;
+            continue;
+        }
+
+        const Result& now = entry.second;
+        const Result& base = found->second;
+        double limit = base.ns * scale * tolerance + SLACK_NS;
+        bool moreAllocations = now.allocations > base.allocations;
+        bool slower = timing && now.ns > limit;
+        printf("%-36s %7llu %7llu %9.1f %9.1f%s%s\n", entry.first.c_str(),
+               static_cast<unsigned long long>(now.allocations), static_cast<unsigned long long>(base.allocations),
+               now.ns, limit, moreAllocations ? "  MORE ALLOCATIONS" : "", slower ? "  SLOWER" : "");
+        if (moreAllocations || slower) {
+            failures++;
+        }
+    }
+
+    if (failures > 0) {
+        printf("%d message(s) regressed\n", failures);
+        return 1;
+    }
+    return 0;
+}
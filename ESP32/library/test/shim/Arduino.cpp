@@ -0,0 +1,114 @@
+#include <Arduino.h>
+#include <stdarg.h>
+#include "HostControl.h"
+#include "HostInternal.h"
+
+HardwareSerial Serial;
+
+namespace {
+
+unsigned long clockMs = 0;
+bool serialEnabled = getenv("WIFISET_HOST_SERIAL") != nullptr;
+uint32_t randomState = 0x2545F491;
+esp_reset_reason_t resetReason = ESP_RST_POWERON;
+
+} // namespace
+
+size_t HardwareSerial::print(const char* text) {
+    if (!serialEnabled) {
+        return 0;
+    }
+    return fputs(text, stdout) >= 0 ? strlen(text) : 0;
+}
+
+size_t HardwareSerial::println(const char* text) {
+    size_t written = print(text);
+    return written + print("\n");
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+    if (!serialEnabled) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written > 0 ? static_cast<size_t>(written) : 0;
+}
+
+unsigned long millis() {
+    return clockMs;
+}
+
+unsigned long micros() {
+    return clockMs * 1000;
+}
+
+void delay(unsigned long ms) {
+    Host::advanceMillis(ms);
+}
+
+void yield() {
+    Host::advanceMillis(0);
+}
+
+long random(long max) {
+    return max > 0 ? static_cast<long>(esp_random() % static_cast<uint32_t>(max)) : 0;
+}
+
+long random(long min, long max) {
+    return max > min ? min + random(max - min) : min;
+}
+
+uint32_t esp_random(void) {
+    // xorshift32: deterministic, so backoff jitter repeats from run to run
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+esp_reset_reason_t esp_reset_reason(void) {
+    return resetReason;
+}
+
+namespace Host {
+
+void reset() {
+    clockMs = 0;
+    randomState = 0x2545F491;
+    resetReason = ESP_RST_POWERON;
+    clearNVS();
+    detail::resetRadio();
+}
+
+void setMillis(unsigned long ms) {
+    clockMs = ms;
+}
+
+void advanceMillis(unsigned long ms) {
+    unsigned long target = clockMs + ms;
+    unsigned long at;
+    while (detail::nextRadioEvent(at) && at <= target) {
+        if (at > clockMs) {
+            clockMs = at;
+        }
+        detail::deliverRadioEvents(clockMs);
+    }
+    clockMs = target;
+}
+
+void setSerialEnabled(bool enabled) {
+    serialEnabled = enabled;
+}
+
+void seedRandom(uint32_t seed) {
+    randomState = seed != 0 ? seed : 1;
+}
+
+void setResetReason(esp_reset_reason_t reason) {
+    resetReason = reason;
+}
+
+} // namespace Host
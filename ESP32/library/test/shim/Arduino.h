@@ -0,0 +1,55 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+/**
+ * Host stand-in for the ESP32 Arduino core (3.x)
+ *
+ * Just enough of the core for the library's portable units to build with a
+ * plain C++ compiler: String, IPAddress, Serial, and a virtual clock behind
+ * millis() and delay() that tests advance explicitly (see HostControl.h).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "WString.h"
+#include "IPAddress.h"
+#include "esp_system.h"
+
+#define ESP_ARDUINO_VERSION_MAJOR 3
+#define ESP_ARDUINO_VERSION_MINOR 0
+#define ESP_ARDUINO_VERSION_PATCH 0
+
+/**
+ * Serial console: silent unless Host::setSerialEnabled(true) or WIFISET_HOST_SERIAL=1
+ */
+class HardwareSerial {
+public:
+    size_t print(const char* text);
+    size_t print(const String& text) { return print(text.c_str()); }
+    size_t println(const char* text = "");
+    size_t println(const String& text) { return println(text.c_str()); }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * Virtual time since start (advanced only by delay() and Host::advanceMillis())
+ */
+unsigned long millis();
+unsigned long micros();
+
+/**
+ * Advance the virtual clock, delivering WiFi events that fall due
+ */
+void delay(unsigned long ms);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+
+#endif // ARDUINO_H
@@ -0,0 +1,114 @@
+#ifndef HOST_CONTROL_H
+#define HOST_CONTROL_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+/**
+ * Controls for the simulated device behind the host shims
+ *
+ * Tests and benchmarks use these to set the clock, the contents of NVS and
+ * the radio environment. Host::reset() returns everything to power-on
+ * state: clock at 0, NVS empty, no access points.
+ *
+ * Radio timing model (per scanned channel):
+ *   passive scan  maxMsPerChannel; finds APs whose beacon interval fits in it
+ *   active scan   the active minimum dwell (setScanActiveMinTime, 100 ms by
+ *                 default) if nothing answers a probe, else maxMsPerChannel;
+ *                 finds APs that answer probes, plus beacon-only APs whose
+ *                 beacon interval fits in the dwell
+ * An AP stronger than STRONG_NEIGHBOUR_RSSI is also heard on the adjacent
+ * channels (and reported with its own channel). A directed scan (ssid set)
+ * reports only that network, hidden or not.
+ */
+namespace Host {
+
+/**
+ * Reset the clock, NVS, radio and reset reason
+ * Also forgets WiFi.onEvent() handlers: create the objects under test after it.
+ */
+void reset();
+
+// -- Clock --------------------------------------------------------------
+
+void setMillis(unsigned long ms);
+
+/**
+ * Move the clock forward, delivering WiFi events that fall due in order
+ */
+void advanceMillis(unsigned long ms);
+
+// -- Console, randomness, reset reason ----------------------------------
+
+void setSerialEnabled(bool enabled);
+void seedRandom(uint32_t seed);
+void setResetReason(esp_reset_reason_t reason);
+
+// -- NVS ----------------------------------------------------------------
+
+void clearNVS();
+
+/**
+ * Writes that reached the store since the last clearNVS() (puts, removes and clears)
+ */
+uint32_t nvsWriteCount();
+
+// -- Radio --------------------------------------------------------------
+
+static const int8_t STRONG_NEIGHBOUR_RSSI = -50;
+static const uint32_t DEFAULT_BEACON_INTERVAL_MS = 102;
+static const uint32_t DEFAULT_ACTIVE_MIN_DWELL_MS = 100;
+
+struct AccessPoint {
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+    int8_t rssi;
+    wifi_auth_mode_t authMode;
+    char password[64];
+    bool hidden;                // Beacons without the SSID; answers directed probes only
+    bool answersProbes;         // false: found by beacons only
+    uint32_t beaconIntervalMs;
+
+    AccessPoint(const char* ssid, uint8_t channel, int8_t rssi, wifi_auth_mode_t authMode = WIFI_AUTH_WPA2_PSK,
+                const char* password = "password");
+};
+
+/**
+ * Add an AP (its BSSID is derived from the order of the calls unless set)
+ */
+void addAccessPoint(const AccessPoint& ap);
+void clearAccessPoints();
+size_t accessPointCount();
+
+/**
+ * Drop the current link as the AP would (DISCONNECTED with reason)
+ */
+void dropLink(uint8_t reason = WIFI_REASON_BEACON_TIMEOUT);
+
+// Virtual time a connect spends per step
+static const uint32_t ASSOCIATE_MS = 60;
+static const uint32_t DHCP_MS = 250;
+static const uint32_t SEARCH_MS_PER_CHANNEL = 120;      // Driver's own search when no channel is given
+static const uint32_t WRONG_PASSWORD_MS = 1500;
+
+/**
+ * T1 (renewal time) the simulated DHCP server hands out
+ */
+void setDhcpRenewSeconds(uint32_t seconds);
+
+struct RadioStats {
+    uint32_t scans;             // Scans started
+    uint32_t channelsScanned;
+    uint32_t scanTimeMs;        // Virtual time spent scanning
+    uint32_t connects;          // WiFi.begin() calls
+
+    RadioStats() : scans(0), channelsScanned(0), scanTimeMs(0), connects(0) {}
+};
+
+const RadioStats& radioStats();
+void resetRadioStats();
+
+} // namespace Host
+
+#endif // HOST_CONTROL_H
@@ -0,0 +1,23 @@
+#ifndef HOST_INTERNAL_H
+#define HOST_INTERNAL_H
+
+// Hooks between the shim translation units (not for tests)
+namespace Host {
+namespace detail {
+
+/**
+ * Time of the next scheduled radio event, or false if none is pending
+ */
+bool nextRadioEvent(unsigned long& at);
+
+/**
+ * Deliver the radio events due at or before now
+ */
+void deliverRadioEvents(unsigned long now);
+
+void resetRadio();
+
+} // namespace detail
+} // namespace Host
+
+#endif // HOST_INTERNAL_H
@@ -0,0 +1,45 @@
+#include "IPAddress.h"
+#include <stdio.h>
+
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(text);
+}
+
+bool IPAddress::fromString(const char* address) {
+    uint8_t parsed[4];
+    size_t part = 0;
+    unsigned value = 0;
+    bool digits = false;
+
+    for (const char* c = address; ; c++) {
+        if (*c >= '0' && *c <= '9') {
+            value = value * 10 + static_cast<unsigned>(*c - '0');
+            if (value > 255) {
+                return false;
+            }
+            digits = true;
+        } else if (*c == '.' || *c == '\0') {
+            if (!digits || part >= 4) {
+                return false;
+            }
+            parsed[part++] = static_cast<uint8_t>(value);
+            value = 0;
+            digits = false;
+            if (*c == '\0') {
+                break;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    if (part != 4) {
+        return false;
+    }
+    memcpy(bytes, parsed, sizeof(bytes));
+    return true;
+}
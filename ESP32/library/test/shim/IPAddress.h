@@ -0,0 +1,55 @@
+#ifndef IPADDRESS_H
+#define IPADDRESS_H
+
+#include <stdint.h>
+#include "WString.h"
+
+/**
+ * IPAddress - Host stand-in for the Arduino core's IPv4 IPAddress
+ *
+ * Four bytes in network order; the uint32_t conversion reinterprets them
+ * in host order exactly like the core does on the little-endian ESP32.
+ */
+class IPAddress {
+public:
+    IPAddress() : dword(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        bytes[0] = a;
+        bytes[1] = b;
+        bytes[2] = c;
+        bytes[3] = d;
+    }
+    IPAddress(uint32_t address) : dword(address) {}
+    explicit IPAddress(const uint8_t* address) { memcpy(bytes, address, sizeof(bytes)); }
+
+    operator uint32_t() const { return dword; }
+
+    bool operator==(const IPAddress& other) const { return dword == other.dword; }
+    bool operator!=(const IPAddress& other) const { return dword != other.dword; }
+    bool operator==(const uint8_t* address) const { return memcmp(bytes, address, sizeof(bytes)) == 0; }
+
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t& operator[](int index) { return bytes[index]; }
+
+    /**
+     * Dotted-decimal form, e.g. "192.168.1.10"
+     */
+    String toString() const;
+
+    /**
+     * Parse dotted-decimal form
+     * @return false if address is not four numbers 0-255 separated by dots
+     */
+    bool fromString(const char* address);
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+
+private:
+    union {
+        uint8_t bytes[4];
+        uint32_t dword;
+    };
+};
+
+extern const IPAddress INADDR_NONE;
+
+#endif // IPADDRESS_H
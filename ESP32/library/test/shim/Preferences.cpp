@@ -0,0 +1,197 @@
+#include "Preferences.h"
+#include "HostControl.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+// NVS limits: 15-character namespace and key names
+const size_t MAX_NAME_LENGTH = 15;
+
+enum EntryType : uint8_t { TYPE_U8, TYPE_U16, TYPE_U32, TYPE_STRING, TYPE_BLOB };
+
+struct Entry {
+    uint8_t type;
+    std::vector<uint8_t> data;
+};
+
+typedef std::map<std::string, Entry> Namespace;
+
+std::map<std::string, Namespace>& store() {
+    static std::map<std::string, Namespace> namespaces;
+    return namespaces;
+}
+
+uint32_t writes = 0;
+
+bool validName(const char* name) {
+    return name != nullptr && name[0] != '\0' && strlen(name) <= MAX_NAME_LENGTH;
+}
+
+} // namespace
+
+namespace Host {
+
+void clearNVS() {
+    store().clear();
+    writes = 0;
+}
+
+uint32_t nvsWriteCount() {
+    return writes;
+}
+
+} // namespace Host
+
+Preferences::Preferences() : started(false), readOnly(false) {
+    name[0] = '\0';
+}
+
+Preferences::~Preferences() {
+    end();
+}
+
+bool Preferences::begin(const char* ns, bool ro, const char*) {
+    if (started || !validName(ns)) {
+        return false;
+    }
+    strcpy(name, ns);
+    readOnly = ro;
+    started = true;
+    return true;
+}
+
+void Preferences::end() {
+    started = false;
+}
+
+bool Preferences::clear() {
+    if (!started || readOnly) {
+        return false;
+    }
+    store()[name].clear();
+    writes++;
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!started || readOnly || !validName(key)) {
+        return false;
+    }
+    Namespace& entries = store()[name];
+    if (entries.erase(key) == 0) {
+        return false;
+    }
+    writes++;
+    return true;
+}
+
+bool Preferences::isKey(const char* key) {
+    if (!started || !validName(key)) {
+        return false;
+    }
+    Namespace& entries = store()[name];
+    return entries.find(key) != entries.end();
+}
+
+size_t Preferences::put(const char* key, uint8_t type, const void* value, size_t length) {
+    if (!started || readOnly || !validName(key)) {
+        return 0;
+    }
+    Entry& entry = store()[name][key];
+    entry.type = type;
+    entry.data.assign(static_cast<const uint8_t*>(value), static_cast<const uint8_t*>(value) + length);
+    writes++;
+    return length;
+}
+
+bool Preferences::get(const char* key, uint8_t type, void* buffer, size_t length) {
+    if (!started || !validName(key)) {
+        return false;
+    }
+    Namespace& entries = store()[name];
+    Namespace::const_iterator found = entries.find(key);
+    if (found == entries.end() || found->second.type != type || found->second.data.size() != length) {
+        return false;
+    }
+    memcpy(buffer, found->second.data.data(), length);
+    return true;
+}
+
+size_t Preferences::putUChar(const char* key, uint8_t value) {
+    return put(key, TYPE_U8, &value, sizeof(value));
+}
+
+size_t Preferences::putUShort(const char* key, uint16_t value) {
+    return put(key, TYPE_U16, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+    return put(key, TYPE_U32, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    if (value == nullptr) {
+        return 0;
+    }
+    // Stored with its NUL, but reported without it like the core does
+    size_t length = strlen(value);
+    return put(key, TYPE_STRING, value, length + 1) > 0 ? length : 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (value == nullptr || length == 0) {
+        return 0;
+    }
+    return put(key, TYPE_BLOB, value, length);
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) {
+    uint8_t value;
+    return get(key, TYPE_U8, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint16_t Preferences::getUShort(const char* key, uint16_t defaultValue) {
+    uint16_t value;
+    return get(key, TYPE_U16, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+    uint32_t value;
+    return get(key, TYPE_U32, &value, sizeof(value)) ? value : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    if (!started || !validName(key)) {
+        return defaultValue;
+    }
+    Namespace& entries = store()[name];
+    Namespace::const_iterator found = entries.find(key);
+    if (found == entries.end() || found->second.type != TYPE_STRING) {
+        return defaultValue;
+    }
+    return String(reinterpret_cast<const char*>(found->second.data.data()));
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (!started || !validName(key)) {
+        return 0;
+    }
+    Namespace& entries = store()[name];
+    Namespace::const_iterator found = entries.find(key);
+    if (found == entries.end() || found->second.type != TYPE_BLOB) {
+        return 0;
+    }
+    return found->second.data.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    size_t length = getBytesLength(key);
+    // Like the core: a buffer too small for the blob gets nothing
+    if (length == 0 || buffer == nullptr || length > maxLength) {
+        return 0;
+    }
+    memcpy(buffer, store()[name][key].data.data(), length);
+    return length;
+}
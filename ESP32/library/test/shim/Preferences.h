@@ -0,0 +1,55 @@
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include <Arduino.h>
+
+/**
+ * Preferences - Host stand-in for the ESP32 core's NVS key/value store
+ *
+ * Namespaces live in one in-memory store shared by every instance, so it
+ * survives an object being destroyed and re-created like flash survives a
+ * reboot (Host::clearNVS() erases it). Keys are typed as in NVS: reading a
+ * key with another type returns the default. Writes need begin() with
+ * readOnly = false; every write that reaches the store is counted
+ * (Host::nvsWriteCount()).
+ */
+class Preferences {
+public:
+    Preferences();
+    ~Preferences();
+
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putUChar(const char* key, uint8_t value);
+    size_t putUShort(const char* key, uint16_t value);
+    size_t putUInt(const char* key, uint32_t value);
+    size_t putULong(const char* key, uint32_t value) { return putUInt(key, value); }
+    size_t putBool(const char* key, bool value) { return putUChar(key, value ? 1 : 0); }
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char* key, const void* value, size_t length);
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return getUInt(key, defaultValue); }
+    bool getBool(const char* key, bool defaultValue = false) { return getUChar(key, defaultValue ? 1 : 0) != 0; }
+    String getString(const char* key, const String& defaultValue = String());
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+
+private:
+    char name[16];
+    bool started;
+    bool readOnly;
+
+    size_t put(const char* key, uint8_t type, const void* value, size_t length);
+    bool get(const char* key, uint8_t type, void* buffer, size_t length);
+};
+
+#endif // PREFERENCES_H
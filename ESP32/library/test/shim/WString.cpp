@@ -0,0 +1,258 @@
+#include "WString.h"
+#include <stdlib.h>
+
+String::String(const char* value) {
+    init();
+    if (value != nullptr) {
+        copy(value, strlen(value));
+    }
+}
+
+String::String(const char* value, size_t length) {
+    init();
+    if (value != nullptr) {
+        copy(value, length);
+    }
+}
+
+String::String(const String& other) {
+    init();
+    copy(other.buffer(), other.len);
+}
+
+String::String(String&& other) noexcept {
+    init();
+    move(other);
+}
+
+String::String(char c) {
+    init();
+    copy(&c, 1);
+}
+
+String::String(int value, unsigned char base) {
+    init();
+    bool negative = value < 0 && base == 10;
+    formatNumber(negative ? 0UL - static_cast<unsigned long>(value) : static_cast<unsigned int>(value), base, negative);
+}
+
+String::String(unsigned int value, unsigned char base) {
+    init();
+    formatNumber(value, base, false);
+}
+
+String::String(long value, unsigned char base) {
+    init();
+    bool negative = value < 0 && base == 10;
+    formatNumber(negative ? 0UL - static_cast<unsigned long>(value) : static_cast<unsigned long>(value), base,
+                 negative);
+}
+
+String::String(unsigned long value, unsigned char base) {
+    init();
+    formatNumber(value, base, false);
+}
+
+String::~String() {
+    release();
+}
+
+String& String::operator=(const String& other) {
+    if (this != &other) {
+        copy(other.buffer(), other.len);
+    }
+    return *this;
+}
+
+String& String::operator=(String&& other) noexcept {
+    if (this != &other) {
+        move(other);
+    }
+    return *this;
+}
+
+String& String::operator=(const char* value) {
+    if (value == nullptr) {
+        release();
+        init();
+    } else {
+        copy(value, strlen(value));
+    }
+    return *this;
+}
+
+void String::init() {
+    inlineData[0] = '\0';
+    len = 0;
+    capacity = SSO_CAPACITY;
+    onHeap = false;
+}
+
+void String::release() {
+    if (onHeap) {
+        free(heap);
+    }
+}
+
+bool String::reserve(size_t size) {
+    if (size <= capacity) {
+        return true;
+    }
+
+    // Grows in place once on the heap, like the core's changeBuffer()
+    char* grown = static_cast<char*>(realloc(onHeap ? heap : nullptr, size + 1));
+    if (grown == nullptr) {
+        return false;
+    }
+    if (!onHeap) {
+        memcpy(grown, inlineData, len + 1);
+    }
+    heap = grown;
+    capacity = size;
+    onHeap = true;
+    return true;
+}
+
+bool String::copy(const char* value, size_t length) {
+    if (!reserve(length)) {
+        release();
+        init();
+        return false;
+    }
+    memmove(buffer(), value, length);
+    len = length;
+    buffer()[len] = '\0';
+    return true;
+}
+
+void String::move(String& other) {
+    release();
+    if (other.onHeap) {
+        heap = other.heap;
+        capacity = other.capacity;
+        onHeap = true;
+        len = other.len;
+    } else {
+        init();
+        memcpy(inlineData, other.inlineData, other.len + 1);
+        len = other.len;
+    }
+    other.init();
+}
+
+bool String::concat(const char* value, size_t length) {
+    if (length == 0) {
+        return true;
+    }
+    if (!reserve(len + length)) {
+        return false;
+    }
+    memmove(buffer() + len, value, length);
+    len += length;
+    buffer()[len] = '\0';
+    return true;
+}
+
+void String::formatNumber(unsigned long value, unsigned char base, bool negative) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+
+    char digits[2 + 8 * sizeof(unsigned long)];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    do {
+        unsigned long digit = value % base;
+        *--start = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value != 0);
+    if (negative) {
+        *--start = '-';
+    }
+    copy(start, static_cast<size_t>(end - start));
+}
+
+bool String::equals(const char* value) const {
+    if (value == nullptr) {
+        return len == 0;
+    }
+    return strlen(value) == len && memcmp(buffer(), value, len) == 0;
+}
+
+char& String::operator[](size_t index) {
+    static char dummy;
+    if (index >= len) {
+        dummy = '\0';
+        return dummy;
+    }
+    return buffer()[index];
+}
+
+int String::indexOf(char c, size_t from) const {
+    if (from >= len) {
+        return -1;
+    }
+    const char* found = static_cast<const char*>(memchr(buffer() + from, c, len - from));
+    return found != nullptr ? static_cast<int>(found - buffer()) : -1;
+}
+
+int String::indexOf(const char* value, size_t from) const {
+    if (value == nullptr || from > len) {
+        return -1;
+    }
+    const char* found = strstr(buffer() + from, value);
+    return found != nullptr ? static_cast<int>(found - buffer()) : -1;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return prefix.len <= len && memcmp(buffer(), prefix.buffer(), prefix.len) == 0;
+}
+
+String String::substring(size_t from, size_t to) const {
+    if (from > to) {
+        size_t swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from >= len) {
+        return String();
+    }
+    if (to > len) {
+        to = len;
+    }
+    return String(buffer() + from, to - from);
+}
+
+void String::getBytes(unsigned char* out, size_t bufferSize, size_t index) const {
+    if (out == nullptr || bufferSize == 0) {
+        return;
+    }
+    if (index >= len) {
+        out[0] = '\0';
+        return;
+    }
+    size_t n = bufferSize - 1;
+    if (n > len - index) {
+        n = len - index;
+    }
+    memcpy(out, buffer() + index, n);
+    out[n] = '\0';
+}
+
+String operator+(const String& a, const String& b) {
+    String result(a);
+    result.concat(b);
+    return result;
+}
+
+String operator+(const String& a, const char* b) {
+    String result(a);
+    result.concat(b);
+    return result;
+}
+
+String operator+(const char* a, const String& b) {
+    String result(a);
+    result.concat(b);
+    return result;
+}
@@ -0,0 +1,105 @@
+#ifndef WSTRING_H
+#define WSTRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * String - Host stand-in for the Arduino core's String
+ *
+ * Keeps the parts of the ESP32 core's layout that decide when a String
+ * allocates: up to SSO_CAPACITY characters are stored inline, longer ones
+ * live in a malloc'd buffer that grows with realloc. Allocation counts
+ * measured on the host therefore match the device. Only the members the
+ * library uses are provided.
+ */
+class String {
+public:
+    // Inline capacity of the ESP32 core (32-bit build): 11 bytes including the NUL
+    static const size_t SSO_CAPACITY = 10;
+
+    String(const char* value = "");
+    String(const char* value, size_t length);
+    String(const String& other);
+    String(String&& other) noexcept;
+    explicit String(char c);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    ~String();
+
+    String& operator=(const String& other);
+    String& operator=(String&& other) noexcept;
+    String& operator=(const char* value);
+
+    /**
+     * Make room for size characters
+     * @return false if the allocation failed
+     */
+    bool reserve(size_t size);
+
+    // unsigned int as in the core, so printf formats are checked as on the device
+    unsigned int length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    const char* c_str() const { return buffer(); }
+
+    bool concat(const String& other) { return concat(other.buffer(), other.len); }
+    bool concat(const char* value) { return value != nullptr && concat(value, strlen(value)); }
+    bool concat(const char* value, size_t length);
+    bool concat(char c) { return concat(&c, 1); }
+
+    String& operator+=(const String& other) { concat(other); return *this; }
+    String& operator+=(const char* value) { concat(value); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    bool equals(const String& other) const { return len == other.len && memcmp(buffer(), other.buffer(), len) == 0; }
+    bool equals(const char* value) const;
+    bool operator==(const String& other) const { return equals(other); }
+    bool operator==(const char* value) const { return equals(value); }
+    bool operator!=(const String& other) const { return !equals(other); }
+    bool operator!=(const char* value) const { return !equals(value); }
+
+    char charAt(size_t index) const { return index < len ? buffer()[index] : '\0'; }
+    char operator[](size_t index) const { return charAt(index); }
+    char& operator[](size_t index);
+
+    int indexOf(char c, size_t from = 0) const;
+    int indexOf(const char* value, size_t from = 0) const;
+    bool startsWith(const String& prefix) const;
+    String substring(size_t from) const { return substring(from, len); }
+    String substring(size_t from, size_t to) const;
+
+    /**
+     * Copy up to bufferSize - 1 characters from index, NUL-terminated (as on the device)
+     */
+    void getBytes(unsigned char* out, size_t bufferSize, size_t index = 0) const;
+    void toCharArray(char* out, size_t bufferSize, size_t index = 0) const {
+        getBytes(reinterpret_cast<unsigned char*>(out), bufferSize, index);
+    }
+
+    friend String operator+(const String& a, const String& b);
+    friend String operator+(const String& a, const char* b);
+    friend String operator+(const char* a, const String& b);
+
+private:
+    union {
+        char* heap;
+        char inlineData[SSO_CAPACITY + 1];
+    };
+    unsigned int len;
+    unsigned int capacity;  // Characters that fit without reallocating (SSO_CAPACITY while inline)
+    bool onHeap;
+
+    char* buffer() { return onHeap ? heap : inlineData; }
+    const char* buffer() const { return onHeap ? heap : inlineData; }
+
+    void init();
+    void release();
+    bool copy(const char* value, size_t length);
+    void move(String& other);
+    void formatNumber(unsigned long value, unsigned char base, bool negative);
+};
+
+#endif // WSTRING_H
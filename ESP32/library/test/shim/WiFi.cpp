@@ -0,0 +1,629 @@
+#include <WiFi.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include <mbedtls/pkcs5.h>
+#include <algorithm>
+#include <vector>
+#include "HostControl.h"
+#include "HostInternal.h"
+
+WiFiClass WiFi;
+
+namespace {
+
+const uint8_t MAX_CHANNEL = 13;
+
+struct Handler {
+    wifi_event_id_t id;
+    WiFiEventFuncCb callback;
+    arduino_event_id_t event;   // ARDUINO_EVENT_MAX = all
+};
+
+struct ScheduledEvent {
+    unsigned long at;
+    uint32_t order;             // Keeps events due at the same time in the order they were scheduled
+    arduino_event_id_t event;
+    arduino_event_info_t info;
+    bool fromConnect;           // Cancelled by the next begin() / disconnect()
+};
+
+enum class Station { IDLE, CONNECTING, ASSOCIATED, CONNECTED };
+
+struct Radio {
+    std::vector<Host::AccessPoint> accessPoints;
+    uint32_t nextBssid;
+    std::vector<Handler> handlers;
+    wifi_event_id_t nextHandlerId;
+    std::vector<ScheduledEvent> events;
+    uint32_t nextOrder;
+
+    // Scan
+    bool scanRunning;
+    bool scanDone;
+    unsigned long scanEnd;
+    std::vector<wifi_ap_record_t> results;
+    std::vector<bool> reported;     // Per AP, reused so a warm scan doesn't allocate
+    uint32_t activeMinDwellMs;
+
+    // Station
+    Station station;
+    int target;                 // Index into accessPoints of the AP being joined / joined
+    bool staticAddress;
+    IPAddress address;
+    IPAddress gateway;
+    IPAddress subnet;
+    IPAddress dns[2];
+    uint32_t dhcpRenewSeconds;
+
+    Host::RadioStats stats;
+
+    Radio() { clear(); }
+
+    void clear() {
+        accessPoints.clear();
+        nextBssid = 1;
+        handlers.clear();
+        nextHandlerId = 1;
+        events.clear();
+        nextOrder = 0;
+        scanRunning = false;
+        scanDone = false;
+        scanEnd = 0;
+        results.clear();
+        activeMinDwellMs = Host::DEFAULT_ACTIVE_MIN_DWELL_MS;
+        station = Station::IDLE;
+        target = -1;
+        staticAddress = false;
+        address = IPAddress();
+        gateway = IPAddress();
+        subnet = IPAddress();
+        dns[0] = IPAddress();
+        dns[1] = IPAddress();
+        dhcpRenewSeconds = 3600;
+        stats = Host::RadioStats();
+    }
+};
+
+Radio& radio() {
+    static Radio instance;
+    return instance;
+}
+
+struct dhcp stationDhcp;
+struct netif stationNetif = {&stationDhcp};
+
+void schedule(unsigned long at, arduino_event_id_t event, const arduino_event_info_t& info, bool fromConnect) {
+    ScheduledEvent scheduled;
+    scheduled.at = at;
+    scheduled.order = radio().nextOrder++;
+    scheduled.event = event;
+    scheduled.info = info;
+    scheduled.fromConnect = fromConnect;
+    radio().events.push_back(scheduled);
+}
+
+void scheduleDisconnect(unsigned long at, uint8_t reason, bool fromConnect) {
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+    info.wifi_sta_disconnected.reason = reason;
+    schedule(at, ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info, fromConnect);
+}
+
+void cancelConnectEvents() {
+    std::vector<ScheduledEvent>& events = radio().events;
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [](const ScheduledEvent& e) { return e.fromConnect; }),
+                 events.end());
+}
+
+/**
+ * Leave the current AP the way the driver does: an ASSOC_LEAVE disconnect
+ */
+void leave() {
+    Radio& r = radio();
+    cancelConnectEvents();
+    if (r.station == Station::ASSOCIATED || r.station == Station::CONNECTED) {
+        scheduleDisconnect(millis(), WIFI_REASON_ASSOC_LEAVE, false);
+    } else {
+        r.station = Station::IDLE;
+    }
+}
+
+bool sameSSID(const Host::AccessPoint& ap, const char* ssid) {
+    return ssid != nullptr && strcmp(ap.ssid, ssid) == 0;
+}
+
+bool acceptsPassword(const Host::AccessPoint& ap, const char* passphrase) {
+    const char* given = passphrase != nullptr ? passphrase : "";
+    if (ap.authMode == WIFI_AUTH_OPEN) {
+        return given[0] == '\0';
+    }
+    if (strcmp(given, ap.password) == 0) {
+        return true;
+    }
+
+    // WPA/WPA2-Personal also take the PMK as 64 hex digits (WPA3's SAE needs the passphrase)
+    bool pskOnly = ap.authMode == WIFI_AUTH_WPA_PSK || ap.authMode == WIFI_AUTH_WPA2_PSK ||
+                   ap.authMode == WIFI_AUTH_WPA_WPA2_PSK;
+    if (!pskOnly || strlen(given) != 64) {
+        return false;
+    }
+    unsigned char key[32];
+    if (mbedtls_pkcs5_pbkdf2_hmac_ext(MBEDTLS_MD_SHA1, reinterpret_cast<const unsigned char*>(ap.password),
+                                      strlen(ap.password), reinterpret_cast<const unsigned char*>(ap.ssid),
+                                      strlen(ap.ssid), 4096, sizeof(key), key) != 0) {
+        return false;
+    }
+    char hex[65];
+    for (size_t i = 0; i < sizeof(key); i++) {
+        snprintf(hex + 2 * i, 3, "%02x", key[i]);
+    }
+    return strcasecmp(hex, given) == 0;
+}
+
+wifi_ap_record_t toRecord(const Host::AccessPoint& ap, bool withSSID) {
+    wifi_ap_record_t record;
+    memset(&record, 0, sizeof(record));
+    memcpy(record.bssid, ap.bssid, sizeof(record.bssid));
+    if (withSSID) {
+        strncpy(reinterpret_cast<char*>(record.ssid), ap.ssid, 32);
+    }
+    record.primary = ap.channel;
+    record.rssi = ap.rssi;
+    record.authmode = ap.authMode;
+    return record;
+}
+
+/**
+ * Run a scan on the simulated radio
+ * @return Virtual time the scan takes
+ */
+uint32_t runScan(bool showHidden, bool passive, uint32_t maxMsPerChannel, uint8_t channel, const char* ssid,
+                 const uint8_t* bssid) {
+    Radio& r = radio();
+    r.results.clear();
+    r.stats.scans++;
+
+    uint8_t first = channel != 0 ? channel : 1;
+    uint8_t last = channel != 0 ? channel : MAX_CHANNEL;
+    bool directed = ssid != nullptr && ssid[0] != '\0';
+    std::vector<bool>& reported = r.reported;
+    reported.assign(r.accessPoints.size(), false);
+    uint32_t duration = 0;
+
+    for (uint8_t scanned = first; scanned <= last; scanned++) {
+        // An AP that answers a probe keeps an active scan on the channel for the full dwell
+        bool answered = false;
+        if (!passive) {
+            for (const Host::AccessPoint& ap : r.accessPoints) {
+                bool matches = directed ? sameSSID(ap, ssid) : !ap.hidden;
+                if (ap.channel == scanned && ap.answersProbes && matches) {
+                    answered = true;
+                }
+            }
+        }
+        uint32_t dwell = passive || answered ? maxMsPerChannel : std::min(r.activeMinDwellMs, maxMsPerChannel);
+        duration += dwell;
+        r.stats.channelsScanned++;
+
+        for (size_t i = 0; i < r.accessPoints.size(); i++) {
+            const Host::AccessPoint& ap = r.accessPoints[i];
+            int distance = static_cast<int>(ap.channel) - static_cast<int>(scanned);
+            bool heard = distance == 0 || ((distance == 1 || distance == -1) && ap.rssi > Host::STRONG_NEIGHBOUR_RSSI);
+            if (!heard || reported[i]) {
+                continue;
+            }
+            if (directed && !sameSSID(ap, ssid)) {
+                continue;
+            }
+            if (bssid != nullptr && memcmp(bssid, ap.bssid, sizeof(ap.bssid)) != 0) {
+                continue;
+            }
+
+            bool byProbe = !passive && ap.answersProbes && (directed || !ap.hidden);
+            bool byBeacon = dwell >= ap.beaconIntervalMs && (!ap.hidden || showHidden) && !(directed && ap.hidden);
+            if (!byProbe && !byBeacon) {
+                continue;
+            }
+            reported[i] = true;
+            r.results.push_back(toRecord(ap, !ap.hidden || byProbe));
+        }
+    }
+
+    // Strongest first, ties in the order heard; an insertion sort, as std::stable_sort takes a heap buffer
+    for (size_t i = 1; i < r.results.size(); i++) {
+        wifi_ap_record_t record = r.results[i];
+        size_t j = i;
+        for (; j > 0 && r.results[j - 1].rssi < record.rssi; j--) {
+            r.results[j] = r.results[j - 1];
+        }
+        r.results[j] = record;
+    }
+    r.stats.scanTimeMs += duration;
+    return duration;
+}
+
+} // namespace
+
+namespace Host {
+
+AccessPoint::AccessPoint(const char* name, uint8_t ch, int8_t signal, wifi_auth_mode_t mode, const char* pass)
+    : channel(ch),
+      rssi(signal),
+      authMode(mode),
+      hidden(false),
+      answersProbes(true),
+      beaconIntervalMs(DEFAULT_BEACON_INTERVAL_MS) {
+    memset(ssid, 0, sizeof(ssid));
+    strncpy(ssid, name, sizeof(ssid) - 1);
+    memset(bssid, 0, sizeof(bssid));
+    memset(password, 0, sizeof(password));
+    strncpy(password, pass, sizeof(password) - 1);
+}
+
+void addAccessPoint(const AccessPoint& ap) {
+    Radio& r = radio();
+    AccessPoint added = ap;
+    static const uint8_t NONE[6] = {0, 0, 0, 0, 0, 0};
+    if (memcmp(added.bssid, NONE, sizeof(NONE)) == 0) {
+        uint32_t n = r.nextBssid++;
+        uint8_t generated[6] = {0x02, 0x00, static_cast<uint8_t>(n >> 24), static_cast<uint8_t>(n >> 16),
+                                static_cast<uint8_t>(n >> 8), static_cast<uint8_t>(n)};
+        memcpy(added.bssid, generated, sizeof(generated));
+    }
+    r.accessPoints.push_back(added);
+}
+
+void clearAccessPoints() {
+    radio().accessPoints.clear();
+}
+
+size_t accessPointCount() {
+    return radio().accessPoints.size();
+}
+
+void dropLink(uint8_t reason) {
+    Radio& r = radio();
+    if (r.station == Station::ASSOCIATED || r.station == Station::CONNECTED) {
+        cancelConnectEvents();
+        scheduleDisconnect(millis(), reason, false);
+    }
+}
+
+void setDhcpRenewSeconds(uint32_t seconds) {
+    radio().dhcpRenewSeconds = seconds;
+}
+
+const RadioStats& radioStats() {
+    return radio().stats;
+}
+
+void resetRadioStats() {
+    radio().stats = RadioStats();
+}
+
+namespace detail {
+
+bool nextRadioEvent(unsigned long& at) {
+    const std::vector<ScheduledEvent>& events = radio().events;
+    if (events.empty()) {
+        return false;
+    }
+    at = events.front().at;
+    for (const ScheduledEvent& e : events) {
+        at = std::min(at, e.at);
+    }
+    return true;
+}
+
+void deliverRadioEvents(unsigned long now) {
+    Radio& r = radio();
+    while (true) {
+        std::vector<ScheduledEvent>::iterator next = r.events.end();
+        for (std::vector<ScheduledEvent>::iterator it = r.events.begin(); it != r.events.end(); ++it) {
+            if (it->at <= now && (next == r.events.end() || it->at < next->at ||
+                                  (it->at == next->at && it->order < next->order))) {
+                next = it;
+            }
+        }
+        if (next == r.events.end()) {
+            return;
+        }
+
+        ScheduledEvent event = *next;
+        r.events.erase(next);
+
+        switch (event.event) {
+            case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+                r.station = Station::ASSOCIATED;
+                break;
+            case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+                r.station = Station::CONNECTED;
+                break;
+            case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+                r.station = Station::IDLE;
+                break;
+            default:
+                break;
+        }
+
+        // By index over a count taken first: a handler may register another one
+        size_t count = r.handlers.size();
+        for (size_t i = 0; i < count && i < r.handlers.size(); i++) {
+            Handler handler = r.handlers[i];
+            if (handler.event == ARDUINO_EVENT_MAX || handler.event == event.event) {
+                handler.callback(event.event, event.info);
+            }
+        }
+    }
+}
+
+void resetRadio() {
+    radio().clear();
+}
+
+} // namespace detail
+} // namespace Host
+
+esp_err_t esp_wifi_scan_stop(void) {
+    Radio& r = radio();
+    r.scanRunning = false;
+    r.scanDone = false;
+    r.results.clear();
+    return ESP_OK;
+}
+
+esp_netif_t* esp_netif_get_handle_from_ifkey(const char* key) {
+    Radio& r = radio();
+    if (strcmp(key, "WIFI_STA_DEF") != 0 || r.station != Station::CONNECTED) {
+        return nullptr;
+    }
+    return reinterpret_cast<esp_netif_t*>(&stationNetif);
+}
+
+void* esp_netif_get_netif_impl(esp_netif_t* netif) {
+    if (netif == nullptr) {
+        return nullptr;
+    }
+    Radio& r = radio();
+    stationDhcp.state = r.staticAddress ? 0 : DHCP_STATE_BOUND;
+    stationDhcp.offered_t0_lease = r.dhcpRenewSeconds * 2;
+    stationDhcp.offered_t1_renew = r.dhcpRenewSeconds;
+    stationDhcp.offered_t2_rebind = r.dhcpRenewSeconds * 7 / 4;
+    return &stationNetif;
+}
+
+bool WiFiClass::mode(wifi_mode_t) {
+    return true;
+}
+
+bool WiFiClass::setAutoReconnect(bool) {
+    return true;
+}
+
+bool WiFiClass::setScanActiveMinTime(uint32_t ms) {
+    radio().activeMinDwellMs = ms;
+    return true;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb callback, arduino_event_id_t event) {
+    Handler handler;
+    handler.id = radio().nextHandlerId++;
+    handler.callback = callback;
+    handler.event = event;
+    radio().handlers.push_back(handler);
+    return handler.id;
+}
+
+void WiFiClass::removeEvent(wifi_event_id_t id) {
+    std::vector<Handler>& handlers = radio().handlers;
+    handlers.erase(std::remove_if(handlers.begin(), handlers.end(), [id](const Handler& h) { return h.id == id; }),
+                   handlers.end());
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool showHidden, bool passive, uint32_t maxMsPerChannel, uint8_t channel,
+                                const char* ssid, const uint8_t* bssid) {
+    Radio& r = radio();
+    if (r.scanRunning) {
+        return WIFI_SCAN_RUNNING;
+    }
+    if (channel > MAX_CHANNEL) {
+        return WIFI_SCAN_FAILED;
+    }
+
+    uint32_t duration = runScan(showHidden, passive, maxMsPerChannel, channel, ssid, bssid);
+    if (async) {
+        r.scanRunning = true;
+        r.scanDone = false;
+        r.scanEnd = millis() + duration;
+        return WIFI_SCAN_RUNNING;
+    }
+
+    Host::advanceMillis(duration);
+    r.scanDone = true;
+    return static_cast<int16_t>(r.results.size());
+}
+
+int16_t WiFiClass::scanComplete() {
+    Radio& r = radio();
+    if (r.scanRunning) {
+        if (millis() < r.scanEnd) {
+            return WIFI_SCAN_RUNNING;
+        }
+        r.scanRunning = false;
+        r.scanDone = true;
+    }
+    return r.scanDone ? static_cast<int16_t>(r.results.size()) : WIFI_SCAN_FAILED;
+}
+
+void WiFiClass::scanDelete() {
+    Radio& r = radio();
+    if (r.scanRunning) {
+        return;
+    }
+    r.results.clear();
+    r.scanDone = false;
+}
+
+void* WiFiClass::getScanInfoByIndex(int index) {
+    Radio& r = radio();
+    if (!r.scanDone || index < 0 || static_cast<size_t>(index) >= r.results.size()) {
+        return nullptr;
+    }
+    return &r.results[index];
+}
+
+String WiFiClass::SSID(uint8_t index) const {
+    const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(index));
+    return record != nullptr ? String(reinterpret_cast<const char*>(record->ssid)) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t index) {
+    const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(getScanInfoByIndex(index));
+    return record != nullptr ? record->rssi : 0;
+}
+
+wifi_auth_mode_t WiFiClass::encryptionType(uint8_t index) {
+    const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(getScanInfoByIndex(index));
+    return record != nullptr ? record->authmode : WIFI_AUTH_OPEN;
+}
+
+int32_t WiFiClass::channel(uint8_t index) {
+    const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(getScanInfoByIndex(index));
+    return record != nullptr ? record->primary : 0;
+}
+
+uint8_t* WiFiClass::BSSID(uint8_t index) {
+    wifi_ap_record_t* record = static_cast<wifi_ap_record_t*>(getScanInfoByIndex(index));
+    return record != nullptr ? record->bssid : nullptr;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel, const uint8_t* bssid,
+                             bool connect) {
+    Radio& r = radio();
+    leave();
+    if (!connect || ssid == nullptr || ssid[0] == '\0') {
+        return WL_DISCONNECTED;
+    }
+    r.stats.connects++;
+    r.station = Station::CONNECTING;
+
+    // Strongest AP of the network, limited to the channel and BSSID if given
+    r.target = -1;
+    for (size_t i = 0; i < r.accessPoints.size(); i++) {
+        const Host::AccessPoint& ap = r.accessPoints[i];
+        if (!sameSSID(ap, ssid) || (channel > 0 && ap.channel != channel) ||
+            (bssid != nullptr && memcmp(bssid, ap.bssid, sizeof(ap.bssid)) != 0)) {
+            continue;
+        }
+        if (r.target < 0 || ap.rssi > r.accessPoints[r.target].rssi) {
+            r.target = static_cast<int>(i);
+        }
+    }
+
+    // Without a channel the driver searches all of them first
+    unsigned long at = millis() + (channel > 0 ? 0 : MAX_CHANNEL * Host::SEARCH_MS_PER_CHANNEL);
+    if (r.target < 0) {
+        scheduleDisconnect(at + (channel > 0 ? Host::SEARCH_MS_PER_CHANNEL : 0), WIFI_REASON_NO_AP_FOUND, true);
+        return WL_DISCONNECTED;
+    }
+
+    const Host::AccessPoint& ap = r.accessPoints[r.target];
+    if (!acceptsPassword(ap, passphrase)) {
+        scheduleDisconnect(at + Host::WRONG_PASSWORD_MS, WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT, true);
+        return WL_DISCONNECTED;
+    }
+
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+    memcpy(info.wifi_sta_connected.ssid, ap.ssid, strlen(ap.ssid));
+    info.wifi_sta_connected.ssid_len = static_cast<uint8_t>(strlen(ap.ssid));
+    memcpy(info.wifi_sta_connected.bssid, ap.bssid, sizeof(ap.bssid));
+    info.wifi_sta_connected.channel = ap.channel;
+    info.wifi_sta_connected.authmode = ap.authMode;
+    at += Host::ASSOCIATE_MS;
+    schedule(at, ARDUINO_EVENT_WIFI_STA_CONNECTED, info, true);
+
+    memset(&info, 0, sizeof(info));
+    schedule(at + (r.staticAddress ? 1 : Host::DHCP_MS), ARDUINO_EVENT_WIFI_STA_GOT_IP, info, true);
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    Radio& r = radio();
+    r.staticAddress = static_cast<uint32_t>(localIP) != 0;
+    r.address = localIP;
+    r.gateway = gateway;
+    r.subnet = subnet;
+    r.dns[0] = dns1;
+    r.dns[1] = dns2;
+    return true;
+}
+
+bool WiFiClass::disconnect(bool, bool) {
+    leave();
+    return true;
+}
+
+wl_status_t WiFiClass::status() {
+    return radio().station == Station::CONNECTED ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+String WiFiClass::SSID() const {
+    Radio& r = radio();
+    if (r.station != Station::CONNECTED || r.target < 0) {
+        return String();
+    }
+    return String(r.accessPoints[r.target].ssid);
+}
+
+int8_t WiFiClass::RSSI() {
+    Radio& r = radio();
+    return r.station == Station::CONNECTED && r.target >= 0 ? r.accessPoints[r.target].rssi : 0;
+}
+
+uint8_t* WiFiClass::BSSID() {
+    Radio& r = radio();
+    return r.station != Station::IDLE && r.target >= 0 ? r.accessPoints[r.target].bssid : nullptr;
+}
+
+int32_t WiFiClass::channel() {
+    Radio& r = radio();
+    return r.station != Station::IDLE && r.target >= 0 ? r.accessPoints[r.target].channel : 0;
+}
+
+IPAddress WiFiClass::localIP() {
+    Radio& r = radio();
+    if (r.station != Station::CONNECTED) {
+        return IPAddress();
+    }
+    return r.staticAddress ? r.address : IPAddress(192, 168, 4, 100);
+}
+
+IPAddress WiFiClass::gatewayIP() {
+    Radio& r = radio();
+    if (r.station != Station::CONNECTED) {
+        return IPAddress();
+    }
+    return r.staticAddress ? r.gateway : IPAddress(192, 168, 4, 1);
+}
+
+IPAddress WiFiClass::subnetMask() {
+    Radio& r = radio();
+    if (r.station != Station::CONNECTED) {
+        return IPAddress();
+    }
+    return r.staticAddress ? r.subnet : IPAddress(255, 255, 255, 0);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t index) {
+    Radio& r = radio();
+    if (r.station != Station::CONNECTED || index > 1) {
+        return IPAddress();
+    }
+    if (r.staticAddress) {
+        return r.dns[index];
+    }
+    return index == 0 ? IPAddress(192, 168, 4, 1) : IPAddress();
+}
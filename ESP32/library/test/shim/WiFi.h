@@ -0,0 +1,93 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <Arduino.h>
+#include <functional>
+#include "esp_wifi.h"
+
+/**
+ * Host stand-in for the ESP32 core's WiFi class, backed by a simulated radio
+ *
+ * Scans and connects run against the access points registered with
+ * Host::addAccessPoint() and take virtual time (see HostControl.h for the
+ * timing model). Events are delivered to the onEvent() handlers from
+ * delay() / Host::advanceMillis(), standing in for the WiFi event task.
+ */
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_SCAN_DONE,
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_STOP,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+    ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+
+typedef union {
+    wifi_event_sta_connected_t wifi_sta_connected;
+    wifi_event_sta_disconnected_t wifi_sta_disconnected;
+    ip_event_got_ip_t got_ip;
+} arduino_event_info_t;
+
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+typedef size_t wifi_event_id_t;
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t mode);
+    bool setAutoReconnect(bool autoReconnect);
+    bool setScanActiveMinTime(uint32_t ms);
+
+    wifi_event_id_t onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+    void removeEvent(wifi_event_id_t id);
+
+    // Scanning
+    int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false,
+                         uint32_t maxMsPerChannel = 300, uint8_t channel = 0, const char* ssid = nullptr,
+                         const uint8_t* bssid = nullptr);
+    int16_t scanComplete();
+    void scanDelete();
+    void* getScanInfoByIndex(int index);
+    String SSID(uint8_t index) const;
+    int32_t RSSI(uint8_t index);
+    wifi_auth_mode_t encryptionType(uint8_t index);
+    int32_t channel(uint8_t index);
+    uint8_t* BSSID(uint8_t index);
+
+    // Station
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+                IPAddress dns2 = IPAddress());
+    bool disconnect(bool wifiOff = false, bool eraseAP = false);
+    wl_status_t status();
+    String SSID() const;
+    int8_t RSSI();
+    uint8_t* BSSID();
+    int32_t channel();
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t index = 0);
+};
+
+extern WiFiClass WiFi;
+
+#endif // WIFI_H
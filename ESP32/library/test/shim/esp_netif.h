@@ -0,0 +1,11 @@
+#ifndef ESP_NETIF_H
+#define ESP_NETIF_H
+
+typedef struct esp_netif_obj esp_netif_t;
+
+/**
+ * The station interface ("WIFI_STA_DEF") once the simulated radio is connected, else nullptr
+ */
+esp_netif_t* esp_netif_get_handle_from_ifkey(const char* key);
+
+#endif // ESP_NETIF_H
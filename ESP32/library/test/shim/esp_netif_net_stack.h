@@ -0,0 +1,11 @@
+#ifndef ESP_NETIF_NET_STACK_H
+#define ESP_NETIF_NET_STACK_H
+
+#include "esp_netif.h"
+
+/**
+ * lwIP netif of an interface (struct netif*)
+ */
+void* esp_netif_get_netif_impl(esp_netif_t* netif);
+
+#endif // ESP_NETIF_NET_STACK_H
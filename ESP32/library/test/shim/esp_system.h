@@ -0,0 +1,30 @@
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+#include <stdint.h>
+
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+} esp_reset_reason_t;
+
+/**
+ * Reason of the last reset (ESP_RST_POWERON unless set with Host::setResetReason())
+ */
+esp_reset_reason_t esp_reset_reason(void);
+
+/**
+ * Pseudo-random number (deterministic, seeded with Host::seedRandom())
+ */
+uint32_t esp_random(void);
+
+#endif // ESP_SYSTEM_H
@@ -0,0 +1,22 @@
+#ifndef LWIP_DHCP_H
+#define LWIP_DHCP_H
+
+#include <stdint.h>
+
+// The fields of lwIP's DHCP client the library reads
+#define DHCP_STATE_BOUND 10
+
+struct dhcp {
+    uint8_t state;
+    uint32_t offered_t0_lease;
+    uint32_t offered_t1_renew;
+    uint32_t offered_t2_rebind;
+};
+
+struct netif {
+    struct dhcp* client_data;
+};
+
+#define netif_dhcp_data(netif) ((netif)->client_data)
+
+#endif // LWIP_DHCP_H
@@ -0,0 +1,20 @@
+#ifndef LWIP_TCPIP_PRIV_H
+#define LWIP_TCPIP_PRIV_H
+
+typedef signed char err_t;
+#define ERR_OK 0
+
+struct tcpip_api_call_data {
+    err_t err;
+};
+
+typedef err_t (*tcpip_api_call_fn)(struct tcpip_api_call_data* call);
+
+/**
+ * Run fn "on the tcpip thread": the host has none, so it runs on the caller
+ */
+inline err_t tcpip_api_call(tcpip_api_call_fn fn, struct tcpip_api_call_data* call) {
+    return fn(call);
+}
+
+#endif // LWIP_TCPIP_PRIV_H
@@ -0,0 +1,18 @@
+#include "mbedtls/pkcs5.h"
+#include <openssl/evp.h>
+
+int mbedtls_pkcs5_pbkdf2_hmac_ext(mbedtls_md_type_t md_type, const unsigned char* password, size_t plen,
+                                  const unsigned char* salt, size_t slen, unsigned int iteration_count,
+                                  uint32_t key_length, unsigned char* output) {
+    const EVP_MD* digest = nullptr;
+    switch (md_type) {
+        case MBEDTLS_MD_SHA1:   digest = EVP_sha1(); break;
+        case MBEDTLS_MD_SHA256: digest = EVP_sha256(); break;
+        default:                return -1;
+    }
+
+    int ok = PKCS5_PBKDF2_HMAC(reinterpret_cast<const char*>(password), static_cast<int>(plen), salt,
+                               static_cast<int>(slen), static_cast<int>(iteration_count), digest,
+                               static_cast<int>(key_length), output);
+    return ok == 1 ? 0 : -1;
+}
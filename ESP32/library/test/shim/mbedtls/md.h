@@ -0,0 +1,12 @@
+#ifndef MBEDTLS_MD_H
+#define MBEDTLS_MD_H
+
+typedef enum {
+    MBEDTLS_MD_NONE = 0,
+    MBEDTLS_MD_MD5,
+    MBEDTLS_MD_SHA1,
+    MBEDTLS_MD_SHA224,
+    MBEDTLS_MD_SHA256
+} mbedtls_md_type_t;
+
+#endif // MBEDTLS_MD_H
@@ -0,0 +1,16 @@
+#ifndef MBEDTLS_PKCS5_H
+#define MBEDTLS_PKCS5_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "md.h"
+
+/**
+ * PBKDF2 with HMAC-md_type (implemented on OpenSSL's PKCS5_PBKDF2_HMAC)
+ * @return 0 on success
+ */
+int mbedtls_pkcs5_pbkdf2_hmac_ext(mbedtls_md_type_t md_type, const unsigned char* password, size_t plen,
+                                  const unsigned char* salt, size_t slen, unsigned int iteration_count,
+                                  uint32_t key_length, unsigned char* output);
+
+#endif // MBEDTLS_PKCS5_H
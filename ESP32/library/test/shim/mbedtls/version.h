@@ -0,0 +1,7 @@
+#ifndef MBEDTLS_VERSION_H
+#define MBEDTLS_VERSION_H
+
+// mbedTLS as shipped with Arduino core 3.x
+#define MBEDTLS_VERSION_NUMBER 0x03060000
+
+#endif // MBEDTLS_VERSION_H
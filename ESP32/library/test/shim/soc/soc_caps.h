@@ -0,0 +1,7 @@
+#ifndef SOC_CAPS_H
+#define SOC_CAPS_H
+
+// Capabilities of the original ESP32 (2.4 GHz only)
+#define SOC_WIFI_SUPPORT_5G 0
+
+#endif // SOC_CAPS_H
@@ -0,0 +1,77 @@
+#include "AllocationCounter.h"
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void __libc_free(void* pointer);
+}
+
+namespace {
+
+// Per thread: benchmarks and the framework may allocate on other threads
+thread_local int enabled = 0;
+thread_local uint64_t allocations = 0;
+thread_local uint64_t bytes = 0;
+
+inline void count(size_t size) {
+    if (enabled > 0) {
+        allocations++;
+        bytes += size;
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+void* malloc(size_t size) {
+    count(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count_, size_t size) {
+    count(count_ * size);
+    return __libc_calloc(count_, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    // Shrinking or growing into the same block is still a call into the allocator
+    if (pointer == nullptr || size > malloc_usable_size(pointer)) {
+        count(size);
+    }
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer) {
+    __libc_free(pointer);
+}
+
+} // extern "C"
+
+namespace AllocationCounter {
+
+Snapshot current() {
+    Snapshot snapshot = {allocations, bytes};
+    return snapshot;
+}
+
+Scope::Scope() : start() {
+    enabled++;
+    start = current();
+}
+
+Scope::~Scope() {
+    enabled--;
+}
+
+uint64_t Scope::allocations() const {
+    return current().allocations - start.allocations;
+}
+
+uint64_t Scope::bytes() const {
+    return current().bytes - start.bytes;
+}
+
+} // namespace AllocationCounter
@@ -0,0 +1,52 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * AllocationCounter - Counts heap allocations made by the code under test
+ *
+ * Linking support/AllocationCounter.cpp replaces malloc, calloc, realloc
+ * and free (glibc allows this); operator new and the String shim both end
+ * up there, so every allocation the library makes is seen. Counting is
+ * off until a scope enables it, so the test framework's own allocations
+ * stay out of the numbers.
+ *
+ *   AllocationCounter::Scope scope;
+ *   handler.feed(data, length, consumed);
+ *   EXPECT_EQ(scope.allocations(), 0u);
+ */
+namespace AllocationCounter {
+
+struct Snapshot {
+    uint64_t allocations;   // malloc, calloc and growing reallocs
+    uint64_t bytes;         // Requested by those
+};
+
+/**
+ * Counts of the calling thread since the start of the program
+ */
+Snapshot current();
+
+/**
+ * Counts allocations on the calling thread while it exists (scopes may nest)
+ */
+class Scope {
+public:
+    Scope();
+    ~Scope();
+
+    uint64_t allocations() const;
+    uint64_t bytes() const;
+
+private:
+    Snapshot start;
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,89 @@
+#include "ControllerQueueModel.h"
+
+ControllerQueueModel::ControllerQueueModel(WiFiSet::NotificationFlowControl& flow, const LinkProfile& link)
+    : flow(flow),
+      link(link),
+      now(0),
+      nextEvent(link.connectionIntervalUs),
+      queue(0),
+      notificationsEnabled(true) {}
+
+bool ControllerQueueModel::send() {
+    uint64_t start = now;
+    while (!flow.canSend()) {
+        if (now - start > link.creditTimeoutUs) {
+            flow.reset();
+            counters.creditTimeouts++;
+            break;
+        }
+        // Nothing changes between connection events
+        advanceTo(nextEvent);
+    }
+
+    // Charged before the hand-over, refunded if the stack refuses it
+    flow.onSent();
+    return handOver();
+}
+
+bool ControllerQueueModel::sendPaced(uint32_t delayUs) {
+    advanceTo(now + delayUs);
+    return handOver();
+}
+
+bool ControllerQueueModel::handOver() {
+    counters.sent++;
+    if (!notificationsEnabled) {
+        counters.refused++;
+        flow.onDropped();
+        return false;
+    }
+    if (queue >= link.controllerBuffers) {
+        counters.overflowed++;
+        flow.onDropped();
+        return false;
+    }
+
+    queue++;
+    if (queue > counters.maxQueued) {
+        counters.maxQueued = queue;
+    }
+    updateCongestion();
+    return true;
+}
+
+void ControllerQueueModel::drain() {
+    while (queue > 0) {
+        advanceTo(nextEvent);
+    }
+}
+
+void ControllerQueueModel::advanceTo(uint64_t us) {
+    while (nextEvent <= us) {
+        now = nextEvent;
+        connectionEvent();
+        nextEvent += link.connectionIntervalUs;
+    }
+    if (us > now) {
+        now = us;
+    }
+}
+
+void ControllerQueueModel::connectionEvent() {
+    uint8_t packets = queue < link.packetsPerEvent ? queue : link.packetsPerEvent;
+    for (uint8_t i = 0; i < packets; i++) {
+        queue--;
+        counters.delivered++;
+        flow.onComplete();
+    }
+    updateCongestion();
+}
+
+void ControllerQueueModel::updateCongestion() {
+    if (link.congestAt == 0) {
+        return;
+    }
+    bool congested = queue >= link.congestAt;
+    if (congested != flow.isCongested()) {
+        flow.setCongested(congested);
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef CONTROLLER_QUEUE_MODEL_H
+#define CONTROLLER_QUEUE_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <BLEService/NotificationFlowControl.h>
+
+/**
+ * ControllerQueueModel - Simulated BLE controller TX queue for pacing tests
+ *
+ * Stands in for Bluedroid and the controller around a NotificationFlowControl,
+ * in virtual time. send() follows WiFiSetBLEService::sendData(): wait for a
+ * credit (up to creditTimeoutUs, then reset), charge it, hand the notification
+ * over. The model then behaves like the stack:
+ *   - notifications disabled by the client: refused, onDropped()
+ *   - controller buffers full: refused, onDropped() (counted as overflow)
+ *   - otherwise queued; each connection event sends up to packetsPerEvent
+ *     queued notifications and reports each with onComplete()
+ *     (ESP_GATTS_CONF_EVT)
+ *   - setCongested() follows the queue depth against congestAt
+ *     (ESP_GATTS_CONGEST_EVT)
+ *
+ *   NotificationFlowControl flow;
+ *   ControllerQueueModel link(flow, LinkProfile::fast());
+ *   for (int i = 0; i < 64; i++) link.send();
+ *   link.drain();
+ *   // link.stats().delivered == 64, link.nowUs() is the time it took
+ */
+struct LinkProfile {
+    uint32_t connectionIntervalUs;  // Time between connection events
+    uint8_t packetsPerEvent;        // Notifications the link carries per connection event
+    uint8_t controllerBuffers;      // Controller TX buffers (notifications it can hold)
+    uint8_t congestAt;              // Queue depth at which the stack reports congestion (0 = never)
+    uint32_t creditTimeoutUs;       // As NOTIFY_CREDIT_TIMEOUT_MS
+
+    LinkProfile(uint32_t interval, uint8_t packets, uint8_t buffers, uint8_t congest = 0)
+        : connectionIntervalUs(interval),
+          packetsPerEvent(packets),
+          controllerBuffers(buffers),
+          congestAt(congest),
+          creditTimeoutUs(100000) {}
+
+    // 7.5 ms interval, several packets per event (idle phone, data length extension)
+    static LinkProfile fast() { return LinkProfile(7500, 6, 12, 10); }
+
+    // 30 ms interval, iOS default
+    static LinkProfile typical() { return LinkProfile(30000, 4, 12, 10); }
+
+    // 50 ms interval, one packet per event (busy radio, coexistence with WiFi)
+    static LinkProfile slow() { return LinkProfile(50000, 1, 12, 10); }
+};
+
+class ControllerQueueModel {
+public:
+    struct Stats {
+        uint32_t sent;              // send() calls
+        uint32_t delivered;         // Notifications carried over the air
+        uint32_t refused;           // Refused because notifications were disabled
+        uint32_t overflowed;        // Refused because the controller was full
+        uint32_t creditTimeouts;    // Credit waits that gave up and reset
+        uint8_t maxQueued;          // Deepest controller queue seen
+
+        Stats() : sent(0), delivered(0), refused(0), overflowed(0), creditTimeouts(0), maxQueued(0) {}
+    };
+
+    ControllerQueueModel(WiFiSet::NotificationFlowControl& flow, const LinkProfile& link);
+
+    /**
+     * Send one notification as sendData() does
+     * @return true if the controller queued it
+     */
+    bool send();
+
+    /**
+     * Send one notification after a fixed delay, ignoring credits (the old delay(100) pacing)
+     */
+    bool sendPaced(uint32_t delayUs);
+
+    /**
+     * Run connection events until the controller queue is empty
+     */
+    void drain();
+
+    /**
+     * Run connection events up to the given time
+     */
+    void advanceTo(uint64_t us);
+
+    /**
+     * Client enables or disables notifications (CCCD)
+     */
+    void setNotificationsEnabled(bool enabled) { notificationsEnabled = enabled; }
+
+    uint64_t nowUs() const { return now; }
+    uint8_t queued() const { return queue; }
+    const Stats& stats() const { return counters; }
+
+private:
+    WiFiSet::NotificationFlowControl& flow;
+    LinkProfile link;
+    uint64_t now;
+    uint64_t nextEvent;
+    uint8_t queue;
+    bool notificationsEnabled;
+    Stats counters;
+
+    bool handOver();
+    void connectionEvent();
+    void updateCongestion();
+};
+
+#endif // CONTROLLER_QUEUE_MODEL_H
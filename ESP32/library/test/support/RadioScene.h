@@ -0,0 +1,184 @@
+#ifndef RADIO_SCENE_H
+#define RADIO_SCENE_H
+
+#include <stdio.h>
+#include <HostControl.h>
+#include <WiFiManager/WiFiManager.h>
+
+/**
+ * RadioScene - Radio environments for the scan strategy tests and benchmarks
+ *
+ * install() fills the simulated radio (after Host::reset()). `networks` is
+ * how many named networks a complete scan finds; `hidden` how many hidden
+ * networks the scene has on top of those.
+ *
+ *   HOME     quiet home: the router and a few neighbours on 1/6/11
+ *   OFFICE   dense office: 24 networks over 72 APs, four of them only on 13
+ *   HIDDEN   home plus two hidden networks
+ *   SENSORS  home plus beacon-only devices (300 ms beacons, no probe replies)
+ */
+struct RadioScene {
+    enum Kind { HOME, OFFICE, HIDDEN, SENSORS };
+    static const int COUNT = 4;
+
+    Kind kind;
+    const char* name;
+    size_t networks;
+    size_t hidden;
+
+    static RadioScene get(int index) {
+        switch (index) {
+            case HOME:
+                return RadioScene(HOME, "home", 5, 0);
+            case OFFICE:
+                return RadioScene(OFFICE, "office", 24, 0);
+            case HIDDEN:
+                return RadioScene(HIDDEN, "hidden", 5, 2);
+            default:
+                return RadioScene(SENSORS, "sensors", 8, 0);
+        }
+    }
+
+    void install() const {
+        if (kind == OFFICE) {
+            installOffice();
+            return;
+        }
+
+        Host::addAccessPoint(Host::AccessPoint("Home", 6, -42));
+        Host::addAccessPoint(Host::AccessPoint("Neighbour-1", 1, -78));
+        Host::addAccessPoint(Host::AccessPoint("Neighbour-2", 11, -81));
+        Host::addAccessPoint(Host::AccessPoint("Neighbour-3", 11, -86));
+        Host::addAccessPoint(Host::AccessPoint("Guest", 6, -45, WIFI_AUTH_OPEN, ""));
+
+        if (kind == HIDDEN) {
+            Host::AccessPoint office("Hidden-1", 1, -70);
+            office.hidden = true;
+            Host::addAccessPoint(office);
+            Host::AccessPoint camera("Hidden-2", 9, -75);
+            camera.hidden = true;
+            Host::addAccessPoint(camera);
+        } else if (kind == SENSORS) {
+            const uint8_t channels[] = {3, 8, 13};
+            for (int i = 0; i < 3; i++) {
+                char ssid[33];
+                snprintf(ssid, sizeof(ssid), "Sensor-%d", i + 1);
+                Host::AccessPoint sensor(ssid, channels[i], static_cast<int8_t>(-65 - 5 * i));
+                sensor.answersProbes = false;
+                sensor.beaconIntervalMs = 300;
+                Host::addAccessPoint(sensor);
+            }
+        }
+    }
+
+private:
+    RadioScene(Kind kind, const char* name, size_t networks, size_t hidden)
+        : kind(kind), name(name), networks(networks), hidden(hidden) {}
+
+    static void installOffice() {
+        // Three APs per network, most on the non-overlapping channels; the last four only on 13
+        const uint8_t channels[] = {1, 6, 11, 1, 6, 11, 3, 9};
+        for (int network = 0; network < 24; network++) {
+            char ssid[33];
+            snprintf(ssid, sizeof(ssid), "Office-%02d", network);
+            for (int ap = 0; ap < 3; ap++) {
+                uint8_t channel = network < 20 ? channels[(network + ap) % 8] : 13;
+                int8_t rssi = static_cast<int8_t>(-52 - (network * 7 + ap * 11) % 40);
+                Host::addAccessPoint(Host::AccessPoint(ssid, channel, rssi));
+            }
+        }
+    }
+};
+
+/**
+ * ScanStrategy - A named scan configuration to compare across scenes
+ */
+struct ScanStrategy {
+    enum Kind { DEFAULT, QUICK_ACTIVE, PASSIVE, LONG_PASSIVE, CHANNELS_1_6_11, SLICED, SHOW_HIDDEN };
+    static const int COUNT = 7;
+
+    const char* name;
+    WiFiSet::ScanConfig config;
+    bool sliced;
+
+    static ScanStrategy get(int index) {
+        ScanStrategy strategy("default");
+        switch (index) {
+            case QUICK_ACTIVE:
+                strategy.name = "quick_active";
+                strategy.config.minDwellMs = 20;
+                strategy.config.maxDwellMs = 60;
+                break;
+            case PASSIVE:
+                strategy.name = "passive";
+                strategy.config.type = WiFiSet::ScanType::PASSIVE;
+                strategy.config.maxDwellMs = 110;   // One default beacon interval
+                break;
+            case LONG_PASSIVE:
+                strategy.name = "long_passive";
+                strategy.config.type = WiFiSet::ScanType::PASSIVE;
+                strategy.config.maxDwellMs = 320;
+                break;
+            case CHANNELS_1_6_11:
+                strategy.name = "channels_1_6_11";
+                strategy.config.channelMask = (1u << 1) | (1u << 6) | (1u << 11);
+                break;
+            case SLICED:
+                strategy.name = "sliced";
+                strategy.sliced = true;
+                break;
+            case SHOW_HIDDEN:
+                strategy.name = "show_hidden";
+                strategy.config.showHidden = true;
+                break;
+            default:
+                break;
+        }
+        return strategy;
+    }
+
+private:
+    explicit ScanStrategy(const char* name) : name(name), config(), sliced(false) {}
+};
+
+/**
+ * What one scan cost and found
+ */
+struct ScanOutcome {
+    uint32_t latencyMs;     // Virtual time from start to results (includes BLE gaps when sliced)
+    uint32_t radioMs;       // Virtual time the radio spent scanning
+    size_t found;           // Named networks
+    size_t hidden;          // Entries without a name
+
+    /**
+     * Run one asynchronous scan with the strategy, polling every pollMs
+     */
+    static ScanOutcome run(WiFiSet::WiFiManager& manager, const ScanStrategy& strategy, unsigned long pollMs = 10) {
+        manager.setScanConfig(strategy.config);
+        manager.setChannelSlicedScan(strategy.sliced);
+        manager.setMaxScanResults(WiFiSet::MAX_SCAN_CANDIDATES);
+        Host::resetRadioStats();
+
+        ScanOutcome outcome = ScanOutcome();
+        unsigned long start = millis();
+        if (manager.startScan()) {
+            while (manager.pollScan() == WiFiSet::ScanState::RUNNING) {
+                Host::advanceMillis(pollMs);
+            }
+        }
+        outcome.latencyMs = static_cast<uint32_t>(millis() - start);
+        outcome.radioMs = Host::radioStats().scanTimeMs;
+
+        const WiFiSet::NetworkList& results = manager.getScanResults();
+        for (size_t i = 0; i < results.size(); i++) {
+            if (results[i].hasSSID()) {
+                outcome.found++;
+            } else {
+                outcome.hidden++;
+            }
+        }
+        return outcome;
+    }
+};
+
+#endif // RADIO_SCENE_H
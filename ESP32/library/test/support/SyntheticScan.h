@@ -0,0 +1,53 @@
+#ifndef SYNTHETIC_SCAN_H
+#define SYNTHETIC_SCAN_H
+
+#include <stdio.h>
+#include <vector>
+#include <Protocol/MessageBuilder.h>
+
+/**
+ * SyntheticScan - Deterministic raw scan results for selector tests and benchmarks
+ *
+ * Produces `aps` access points spread over `ssids` network names (mesh
+ * networks show up once per AP), with RSSI in -30..-95 dBm and channels
+ * 1-13. hiddenPercent of the APs broadcast no SSID. The same seed always
+ * gives the same scan.
+ */
+struct SyntheticScan {
+    size_t aps;
+    size_t ssids;
+    unsigned hiddenPercent;
+    uint32_t seed;
+
+    SyntheticScan(size_t aps, size_t ssids, unsigned hiddenPercent = 0, uint32_t seed = 1)
+        : aps(aps), ssids(ssids), hiddenPercent(hiddenPercent), seed(seed) {}
+
+    std::vector<WiFiSet::WiFiNetworkInfo> generate() const {
+        std::vector<WiFiSet::WiFiNetworkInfo> results;
+        uint32_t state = seed != 0 ? seed : 1;
+        for (size_t i = 0; i < aps; i++) {
+            WiFiSet::WiFiNetworkInfo info = WiFiSet::WiFiNetworkInfo();
+            uint32_t r = next(state);
+            if (r % 100 >= hiddenPercent) {
+                char name[WiFiSet::MAX_SSID_LENGTH + 1];
+                snprintf(name, sizeof(name), "Network-%03u", static_cast<unsigned>(i % ssids));
+                info.setSSID(name);
+            }
+            info.rssi = static_cast<int8_t>(-30 - static_cast<int>(next(state) % 66));
+            info.channel = static_cast<uint8_t>(1 + next(state) % 13);
+            info.securityType = (r >> 8) % 5 == 0 ? WiFiSet::SecurityType::OPEN : WiFiSet::SecurityType::WPA_PSK;
+            results.push_back(info);
+        }
+        return results;
+    }
+
+private:
+    static uint32_t next(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+#endif // SYNTHETIC_SCAN_H
@@ -0,0 +1,500 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <Protocol/MessageBuilder.h>
+#include <Protocol/ProtocolHandler.h>
+
+using namespace WiFiSet;
+
+/**
+ * Golden vectors for every message type (PROTOCOL.md)
+ *
+ * Each message the ESP32 sends is encoded with MessageBuilder and must match
+ * its vector byte for byte, then decode back to the same values. Each
+ * message the ESP32 receives is parsed with ProtocolHandler and re-encoded
+ * from the parsed values. The worked examples in PROTOCOL.md must all be
+ * in this table, so the spec and the code can't drift apart.
+ */
+namespace {
+
+const size_t NOTIFY_CAPACITY = 514;     // MTU 517
+
+struct GoldenVector {
+    const char* name;
+    const char* hex;
+};
+
+const GoldenVector GOLDEN[] = {
+    // PROTOCOL.md Example Message Sequences
+    {"network_entry", "02 05 10 00 0C 4D 79 4E 65 74 77 6F 72 6B 32 2E 34 C8 02 06"},
+    {"credential_write", "10 01 1B 00 0C 4D 79 4E 65 74 77 6F 72 6B 32 2E 34 0D 6D 79 70 61 73 73 77 6F 72 64 31 32 33"},
+    {"status_response", "21 0A 14 00 03 C8 C0 A8 01 64 0C 4D 79 4E 65 74 77 6F 72 6B 32 2E 34 00"},
+    {"network_batch", "04 00 1A 00 02 0C 4D 79 4E 65 74 77 6F 72 6B 32 2E 34 C8 02 06 05 47 75 65 73 74 B9 00 0B"},
+    {"hello", "30 00 06 00 01 05 73 00 B9 00"},
+    {"capabilities", "31 00 08 00 01 05 73 00 05 02 73 00"},
+    {"scan_subscribe", "06 00 02 00 01 05"},
+    {"network_delta", "05 00 22 00 03 02 05 47 75 65 73 74 01 04 43 61 66 65 C0 02 01 03 0C 4D 79 4E 65 74 77 6F 72 6B "
+                      "32 2E 34 D0 02 06"},
+    {"ip_config_write", "12 00 15 00 01 C0 A8 01 32 FF FF FF 00 C0 A8 01 01 00 00 00 00 00 00 00 00"},
+    {"saved_network_add", "14 00 10 00 06 4F 66 66 69 63 65 07 73 65 63 72 65 74 31 0A"},
+    {"saved_network_ack", "19 00 02 00 14 00"},
+
+    // The remaining message types
+    {"list_start", "01 00 00 00"},
+    {"list_end", "03 03 01 00 02"},
+    {"credential_ack", "11 02 01 00 00"},
+    {"ip_config_ack", "13 00 01 00 03"},
+    {"saved_network_remove", "15 00 07 00 06 4F 66 66 69 63 65"},
+    {"saved_network_priority", "16 00 08 00 06 4F 66 66 69 63 65 03"},
+    {"saved_network_list_request", "17 00 00 00"},
+    {"saved_network_list", "18 00 19 00 02 06 4F 66 66 69 63 65 0A 00 07 00 00 00 04 48 6F 6D 65 05 02 00 00 00 00"},
+    {"status_request", "20 01 00 00"},
+    {"error", "FF 00 0A 00 04 08 4E 56 53 20 66 75 6C 6C"},
+};
+
+std::vector<uint8_t> fromHex(const std::string& hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size();) {
+        if (hex[i] == ' ') {
+            i++;
+            continue;
+        }
+        bytes.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+        i += 2;
+    }
+    return bytes;
+}
+
+std::vector<uint8_t> golden(const char* name) {
+    for (const GoldenVector& vector : GOLDEN) {
+        if (strcmp(vector.name, name) == 0) {
+            return fromHex(vector.hex);
+        }
+    }
+    ADD_FAILURE() << "No golden vector " << name;
+    return std::vector<uint8_t>();
+}
+
+std::vector<uint8_t> bytes(const uint8_t* data, size_t length) {
+    return std::vector<uint8_t>(data, data + length);
+}
+
+/**
+ * MessageBuilder whose next message carries the given sequence number
+ */
+void advanceTo(MessageBuilder& builder, uint8_t sequence) {
+    uint8_t scratch[MAX_LIST_START_SIZE];
+    while (builder.getSequence() != sequence) {
+        builder.encodeWiFiListStart(scratch, sizeof(scratch));
+    }
+}
+
+/**
+ * Parse a complete message with one feed() call
+ */
+const ParsedMessage& parse(ProtocolHandler& handler, const std::vector<uint8_t>& message) {
+    size_t consumed = 0;
+    EXPECT_EQ(handler.feed(message.data(), message.size(), consumed), ParseResult::MESSAGE_READY);
+    EXPECT_EQ(consumed, message.size());
+    return handler.getMessage();
+}
+
+/**
+ * Payload of a golden vector (header checked against the vector's own length)
+ */
+std::vector<uint8_t> payloadOf(const std::vector<uint8_t>& message) {
+    EXPECT_GE(message.size(), MESSAGE_HEADER_SIZE);
+    EXPECT_EQ(message[2] | (message[3] << 8), static_cast<int>(message.size() - MESSAGE_HEADER_SIZE));
+    return std::vector<uint8_t>(message.begin() + MESSAGE_HEADER_SIZE, message.end());
+}
+
+std::string str(const Schema::StringRef& value) {
+    return std::string(value.data, value.length);
+}
+
+WiFiNetworkInfo network(const char* ssid, int8_t rssi, SecurityType security, uint8_t channel) {
+    WiFiNetworkInfo info = WiFiNetworkInfo();
+    info.setSSID(ssid);
+    info.rssi = rssi;
+    info.securityType = security;
+    info.channel = channel;
+    return info;
+}
+
+} // namespace
+
+// ==================== ESP32 -> client ====================
+
+TEST(GoldenVectors, ListStart) {
+    MessageBuilder builder;
+    uint8_t buffer[MAX_LIST_START_SIZE];
+    EXPECT_EQ(bytes(buffer, builder.encodeWiFiListStart(buffer, sizeof(buffer))), golden("list_start"));
+}
+
+TEST(GoldenVectors, NetworkEntry) {
+    MessageBuilder builder;
+    advanceTo(builder, 5);
+    uint8_t buffer[MAX_NETWORK_ENTRY_SIZE];
+    size_t length = builder.encodeWiFiNetworkEntry(network("MyNetwork2.4", -56, SecurityType::WPA_PSK, 6), buffer,
+                                                   sizeof(buffer));
+    std::vector<uint8_t> expected = golden("network_entry");
+    ASSERT_EQ(bytes(buffer, length), expected);
+
+    std::vector<uint8_t> payload = payloadOf(expected);
+    Schema::StringRef ssid;
+    int8_t rssi;
+    SecurityType security;
+    uint8_t channel;
+    ASSERT_TRUE(NetworkEntrySchema::decode(payload.data(), payload.size(), ssid, rssi, security, channel));
+    EXPECT_EQ(str(ssid), "MyNetwork2.4");
+    EXPECT_EQ(rssi, -56);
+    EXPECT_EQ(security, SecurityType::WPA_PSK);
+    EXPECT_EQ(channel, 6);
+}
+
+TEST(GoldenVectors, NetworkBatch) {
+    MessageBuilder builder;
+    NetworkList networks;
+    networks.push_back(network("MyNetwork2.4", -56, SecurityType::WPA_PSK, 6));
+    networks.push_back(network("Guest", -71, SecurityType::OPEN, 11));
+
+    uint8_t buffer[NOTIFY_CAPACITY];
+    size_t count = 0;
+    size_t length = builder.encodeWiFiNetworkBatch(networks, 0, buffer, sizeof(buffer), count);
+    EXPECT_EQ(count, 2u);
+    std::vector<uint8_t> expected = golden("network_batch");
+    ASSERT_EQ(bytes(buffer, length), expected);
+
+    // Records share the Network Entry payload layout
+    std::vector<uint8_t> payload = payloadOf(expected);
+    ASSERT_EQ(payload[0], 2);
+    size_t offset = 1;
+    for (size_t i = 0; i < 2; i++) {
+        Schema::StringRef ssid;
+        int8_t rssi;
+        SecurityType security;
+        uint8_t channel;
+        ASSERT_TRUE(NetworkEntrySchema::decode(payload.data() + offset, payload.size() - offset, ssid, rssi,
+                                               security, channel));
+        EXPECT_EQ(str(ssid), networks[i].ssid);
+        EXPECT_EQ(rssi, networks[i].rssi);
+        EXPECT_EQ(security, networks[i].securityType);
+        EXPECT_EQ(channel, networks[i].channel);
+        offset += NetworkEntrySchema::payloadLength(ssid, rssi, security, channel);
+    }
+    EXPECT_EQ(offset, payload.size());
+}
+
+TEST(GoldenVectors, ListEnd) {
+    MessageBuilder builder;
+    advanceTo(builder, 3);
+    uint8_t buffer[MAX_LIST_END_SIZE];
+    EXPECT_EQ(bytes(buffer, builder.encodeWiFiListEnd(2, buffer, sizeof(buffer))), golden("list_end"));
+}
+
+TEST(GoldenVectors, NetworkDelta) {
+    MessageBuilder builder;
+    NetworkChangeList changes;
+    changes.push_back(NetworkChange(NetworkChangeType::REMOVED, network("Guest", -71, SecurityType::OPEN, 11)));
+    changes.push_back(NetworkChange(NetworkChangeType::ADDED, network("Cafe", -64, SecurityType::WPA_PSK, 1)));
+    changes.push_back(NetworkChange(NetworkChangeType::UPDATED, network("MyNetwork2.4", -48, SecurityType::WPA_PSK, 6)));
+
+    uint8_t buffer[NOTIFY_CAPACITY];
+    size_t count = 0;
+    size_t length = builder.encodeWiFiNetworkDelta(changes, 0, buffer, sizeof(buffer), count);
+    EXPECT_EQ(count, 3u);
+    std::vector<uint8_t> expected = golden("network_delta");
+    ASSERT_EQ(bytes(buffer, length), expected);
+
+    std::vector<uint8_t> payload = payloadOf(expected);
+    ASSERT_EQ(payload[0], 3);
+    size_t offset = 1;
+    for (size_t i = 0; i < 3; i++) {
+        NetworkChangeType type;
+        Schema::StringRef ssid;
+        if (payload[offset] == static_cast<uint8_t>(NetworkChangeType::REMOVED)) {
+            ASSERT_TRUE(NetworkRemovalEntrySchema::decode(payload.data() + offset, payload.size() - offset, type,
+                                                          ssid));
+            offset += NetworkRemovalEntrySchema::payloadLength(type, ssid);
+        } else {
+            int8_t rssi;
+            SecurityType security;
+            uint8_t channel;
+            ASSERT_TRUE(NetworkChangeEntrySchema::decode(payload.data() + offset, payload.size() - offset, type,
+                                                         ssid, rssi, security, channel));
+            EXPECT_EQ(rssi, changes[i].network.rssi);
+            EXPECT_EQ(channel, changes[i].network.channel);
+            offset += NetworkChangeEntrySchema::payloadLength(type, ssid, rssi, security, channel);
+        }
+        EXPECT_EQ(type, changes[i].type);
+        EXPECT_EQ(str(ssid), changes[i].network.ssid);
+    }
+    EXPECT_EQ(offset, payload.size());
+}
+
+TEST(GoldenVectors, CredentialAck) {
+    MessageBuilder builder;
+    advanceTo(builder, 2);
+    uint8_t buffer[MAX_CREDENTIAL_ACK_SIZE];
+    EXPECT_EQ(bytes(buffer, builder.encodeCredentialWriteAck(0x00, buffer, sizeof(buffer))), golden("credential_ack"));
+}
+
+TEST(GoldenVectors, IPConfigAck) {
+    MessageBuilder builder;
+    uint8_t buffer[MAX_IP_CONFIG_ACK_SIZE];
+    EXPECT_EQ(bytes(buffer, builder.encodeIPConfigAck(0x03, buffer, sizeof(buffer))), golden("ip_config_ack"));
+}
+
+TEST(GoldenVectors, SavedNetworkList) {
+    MessageBuilder builder;
+    SavedNetworkList networks;
+    SavedNetworkInfo office = SavedNetworkInfo();
+    office.setSSID("Office");
+    office.priority = 10;
+    office.failureCount = 0;
+    office.lastSuccess = 7;
+    networks.push_back(office);
+    SavedNetworkInfo home = SavedNetworkInfo();
+    home.setSSID("Home");
+    home.priority = 5;
+    home.failureCount = 2;
+    home.lastSuccess = 0;
+    networks.push_back(home);
+
+    uint8_t buffer[MAX_SAVED_NETWORK_LIST_SIZE];
+    std::vector<uint8_t> expected = golden("saved_network_list");
+    ASSERT_EQ(bytes(buffer, builder.encodeSavedNetworkList(networks, buffer, sizeof(buffer))), expected);
+
+    std::vector<uint8_t> payload = payloadOf(expected);
+    ASSERT_EQ(payload[0], 2);
+    size_t offset = 1;
+    for (const SavedNetworkInfo& saved : networks) {
+        Schema::StringRef ssid;
+        uint8_t priority;
+        uint8_t failures;
+        uint32_t lastSuccess;
+        ASSERT_TRUE(SavedNetworkEntrySchema::decode(payload.data() + offset, payload.size() - offset, ssid, priority,
+                                                    failures, lastSuccess));
+        EXPECT_EQ(str(ssid), saved.ssid);
+        EXPECT_EQ(priority, saved.priority);
+        EXPECT_EQ(failures, saved.failureCount);
+        EXPECT_EQ(lastSuccess, saved.lastSuccess);
+        offset += SavedNetworkEntrySchema::payloadLength(ssid, priority, failures, lastSuccess);
+    }
+    EXPECT_EQ(offset, payload.size());
+}
+
+TEST(GoldenVectors, SavedNetworkAck) {
+    MessageBuilder builder;
+    uint8_t buffer[MAX_SAVED_NETWORK_ACK_SIZE];
+    size_t length = builder.encodeSavedNetworkAck(MessageType::SAVED_NETWORK_ADD, 0x00, buffer, sizeof(buffer));
+    EXPECT_EQ(bytes(buffer, length), golden("saved_network_ack"));
+}
+
+TEST(GoldenVectors, StatusResponse) {
+    MessageBuilder builder;
+    advanceTo(builder, 10);
+    uint8_t buffer[MAX_STATUS_RESPONSE_SIZE];
+    size_t length = builder.encodeStatusResponse(ConnectionState::CONNECTED, -56, IPAddress(192, 168, 1, 100),
+                                                 String("MyNetwork2.4"), 0, buffer, sizeof(buffer));
+    std::vector<uint8_t> expected = golden("status_response");
+    ASSERT_EQ(bytes(buffer, length), expected);
+
+    std::vector<uint8_t> payload = payloadOf(expected);
+    ConnectionState state;
+    int8_t rssi;
+    IPAddress ip;
+    Schema::StringRef ssid;
+    uint8_t reason;
+    ASSERT_TRUE(StatusResponseSchema::decode(payload.data(), payload.size(), state, rssi, ip, ssid, reason));
+    EXPECT_EQ(state, ConnectionState::CONNECTED);
+    EXPECT_EQ(rssi, -56);
+    EXPECT_EQ(ip, IPAddress(192, 168, 1, 100));
+    EXPECT_EQ(str(ssid), "MyNetwork2.4");
+    EXPECT_EQ(reason, 0);
+}
+
+TEST(GoldenVectors, Capabilities) {
+    const uint16_t features = ProtocolFeature::BATCHED_NETWORK_LIST | ProtocolFeature::FRAGMENTATION |
+                              ProtocolFeature::DELTA_UPDATES | ProtocolFeature::IP_CONFIG |
+                              ProtocolFeature::SAVED_NETWORKS;
+    MessageBuilder builder;
+    uint8_t buffer[MAX_CAPABILITIES_SIZE];
+    size_t length = builder.encodeCapabilities(features, 517, features, buffer, sizeof(buffer));
+    EXPECT_EQ(bytes(buffer, length), golden("capabilities"));
+}
+
+TEST(GoldenVectors, Error) {
+    MessageBuilder builder;
+    uint8_t buffer[MAX_ERROR_SIZE];
+    std::vector<uint8_t> expected = golden("error");
+    ASSERT_EQ(bytes(buffer, builder.encodeError(ErrorCode::STORAGE_ERROR, "NVS full", buffer, sizeof(buffer))),
+              expected);
+
+    std::vector<uint8_t> payload = payloadOf(expected);
+    ErrorCode code;
+    Schema::StringRef message;
+    ASSERT_TRUE(ErrorSchema::decode(payload.data(), payload.size(), code, message));
+    EXPECT_EQ(code, ErrorCode::STORAGE_ERROR);
+    EXPECT_EQ(str(message), "NVS full");
+}
+
+// ==================== Client -> ESP32 ====================
+
+TEST(GoldenVectors, CredentialWrite) {
+    ProtocolHandler handler;
+    std::vector<uint8_t> expected = golden("credential_write");
+    const ParsedMessage& message = parse(handler, expected);
+    ASSERT_EQ(message.header.type, MessageType::CREDENTIAL_WRITE);
+    EXPECT_STREQ(message.credentials.ssid.c_str(), "MyNetwork2.4");
+    EXPECT_STREQ(message.credentials.password.c_str(), "mypassword123");
+
+    uint8_t buffer[CredentialWriteSchema::maxSize];
+    size_t length = CredentialWriteSchema::encode(buffer, sizeof(buffer), message.header.sequence,
+                                                  message.credentials.ssid, message.credentials.password);
+    EXPECT_EQ(bytes(buffer, length), expected);
+}
+
+TEST(GoldenVectors, ScanSubscribe) {
+    ProtocolHandler handler;
+    std::vector<uint8_t> expected = golden("scan_subscribe");
+    const ParsedMessage& message = parse(handler, expected);
+    ASSERT_EQ(message.header.type, MessageType::SCAN_SUBSCRIBE);
+    EXPECT_TRUE(message.subscribe.enabled);
+    EXPECT_EQ(message.subscribe.rssiThreshold, 5);
+
+    uint8_t buffer[ScanSubscribeSchema::maxSize];
+    size_t length = ScanSubscribeSchema::encode(buffer, sizeof(buffer), message.header.sequence,
+                                                message.subscribe.enabled ? 1 : 0, message.subscribe.rssiThreshold);
+    EXPECT_EQ(bytes(buffer, length), expected);
+}
+
+TEST(GoldenVectors, IPConfigWrite) {
+    ProtocolHandler handler;
+    std::vector<uint8_t> expected = golden("ip_config_write");
+    const ParsedMessage& message = parse(handler, expected);
+    ASSERT_EQ(message.header.type, MessageType::IP_CONFIG_WRITE);
+    const IPConfigData& config = message.ipConfig;
+    EXPECT_EQ(config.mode, IPMode::STATIC);
+    EXPECT_EQ(config.address, IPAddress(192, 168, 1, 50));
+    EXPECT_EQ(config.subnet, IPAddress(255, 255, 255, 0));
+    EXPECT_EQ(config.gateway, IPAddress(192, 168, 1, 1));
+    EXPECT_EQ(config.dns1, IPAddress());
+    EXPECT_EQ(config.dns2, IPAddress());
+
+    uint8_t buffer[IPConfigWriteSchema::maxSize];
+    size_t length = IPConfigWriteSchema::encode(buffer, sizeof(buffer), message.header.sequence, config.mode,
+                                                config.address, config.subnet, config.gateway, config.dns1,
+                                                config.dns2);
+    EXPECT_EQ(bytes(buffer, length), expected);
+}
+
+TEST(GoldenVectors, SavedNetworkRequests) {
+    ProtocolHandler handler;
+    uint8_t buffer[SavedNetworkAddSchema::maxSize];
+
+    std::vector<uint8_t> add = golden("saved_network_add");
+    const ParsedMessage& added = parse(handler, add);
+    ASSERT_EQ(added.savedNetwork.type, MessageType::SAVED_NETWORK_ADD);
+    EXPECT_STREQ(added.savedNetwork.ssid.c_str(), "Office");
+    EXPECT_STREQ(added.savedNetwork.password.c_str(), "secret1");
+    EXPECT_EQ(added.savedNetwork.priority, 10);
+    EXPECT_EQ(bytes(buffer, SavedNetworkAddSchema::encode(buffer, sizeof(buffer), 0, added.savedNetwork.ssid,
+                                                          added.savedNetwork.password, added.savedNetwork.priority)),
+              add);
+
+    std::vector<uint8_t> remove = golden("saved_network_remove");
+    const ParsedMessage& removed = parse(handler, remove);
+    ASSERT_EQ(removed.savedNetwork.type, MessageType::SAVED_NETWORK_REMOVE);
+    EXPECT_STREQ(removed.savedNetwork.ssid.c_str(), "Office");
+    EXPECT_EQ(bytes(buffer, SavedNetworkRemoveSchema::encode(buffer, sizeof(buffer), 0, removed.savedNetwork.ssid)),
+              remove);
+
+    std::vector<uint8_t> priority = golden("saved_network_priority");
+    const ParsedMessage& prioritised = parse(handler, priority);
+    ASSERT_EQ(prioritised.savedNetwork.type, MessageType::SAVED_NETWORK_PRIORITY);
+    EXPECT_STREQ(prioritised.savedNetwork.ssid.c_str(), "Office");
+    EXPECT_EQ(prioritised.savedNetwork.priority, 3);
+    EXPECT_EQ(bytes(buffer, SavedNetworkPrioritySchema::encode(buffer, sizeof(buffer), 0,
+                                                               prioritised.savedNetwork.ssid,
+                                                               prioritised.savedNetwork.priority)),
+              priority);
+
+    std::vector<uint8_t> list = golden("saved_network_list_request");
+    ASSERT_EQ(parse(handler, list).savedNetwork.type, MessageType::SAVED_NETWORK_LIST_REQUEST);
+    EXPECT_EQ(bytes(buffer, SavedNetworkListRequestSchema::encode(buffer, sizeof(buffer), 0)), list);
+}
+
+TEST(GoldenVectors, StatusRequest) {
+    ProtocolHandler handler;
+    std::vector<uint8_t> expected = golden("status_request");
+    const ParsedMessage& message = parse(handler, expected);
+    ASSERT_EQ(message.header.type, MessageType::STATUS_REQUEST);
+    EXPECT_EQ(message.header.sequence, 1);
+    EXPECT_TRUE(handler.parseStatusRequest(expected.data(), expected.size()));
+}
+
+TEST(GoldenVectors, Hello) {
+    ProtocolHandler handler;
+    std::vector<uint8_t> expected = golden("hello");
+    const ParsedMessage& message = parse(handler, expected);
+    ASSERT_EQ(message.header.type, MessageType::HELLO);
+    EXPECT_EQ(message.hello.versionMajor, 1);
+    EXPECT_EQ(message.hello.versionMinor, 5);
+    EXPECT_EQ(message.hello.features, 0x0073);
+    EXPECT_EQ(message.hello.maxMTU, 185);
+
+    uint8_t buffer[HelloSchema::maxSize];
+    size_t length = HelloSchema::encode(buffer, sizeof(buffer), message.header.sequence, message.hello.versionMajor,
+                                        message.hello.versionMinor, message.hello.features, message.hello.maxMTU);
+    EXPECT_EQ(bytes(buffer, length), expected);
+}
+
+// ==================== Spec ====================
+
+TEST(GoldenVectors, CoverEveryMessageType) {
+    const MessageType types[] = {
+        MessageType::WIFI_LIST_START, MessageType::WIFI_NETWORK_ENTRY, MessageType::WIFI_LIST_END,
+        MessageType::WIFI_NETWORK_BATCH, MessageType::WIFI_NETWORK_DELTA, MessageType::SCAN_SUBSCRIBE,
+        MessageType::CREDENTIAL_WRITE, MessageType::CREDENTIAL_WRITE_ACK, MessageType::IP_CONFIG_WRITE,
+        MessageType::IP_CONFIG_ACK, MessageType::SAVED_NETWORK_ADD, MessageType::SAVED_NETWORK_REMOVE,
+        MessageType::SAVED_NETWORK_PRIORITY, MessageType::SAVED_NETWORK_LIST_REQUEST,
+        MessageType::SAVED_NETWORK_LIST, MessageType::SAVED_NETWORK_ACK, MessageType::STATUS_REQUEST,
+        MessageType::STATUS_RESPONSE, MessageType::HELLO, MessageType::CAPABILITIES, MessageType::ERROR,
+    };
+    for (MessageType type : types) {
+        bool found = false;
+        for (const GoldenVector& vector : GOLDEN) {
+            found = found || fromHex(vector.hex)[0] == static_cast<uint8_t>(type);
+        }
+        EXPECT_TRUE(found) << "No golden vector for type 0x" << std::hex << static_cast<int>(type);
+    }
+}
+
+TEST(GoldenVectors, MatchProtocolSpec) {
+    std::ifstream spec(WIFISET_PROTOCOL_SPEC);
+    ASSERT_TRUE(spec.is_open()) << WIFISET_PROTOCOL_SPEC;
+
+    // Every "Hex: ..." example and "Reply: `...`" in the spec is a golden vector
+    size_t examples = 0;
+    std::string line;
+    while (std::getline(spec, line)) {
+        std::string hex;
+        if (line.compare(0, 5, "Hex: ") == 0) {
+            hex = line.substr(5);
+        } else if (line.compare(0, 8, "Reply: `") == 0) {
+            hex = line.substr(8, line.find('`', 8) - 8);
+        } else {
+            continue;
+        }
+        examples++;
+
+        bool found = false;
+        for (const GoldenVector& vector : GOLDEN) {
+            found = found || fromHex(vector.hex) == fromHex(hex);
+        }
+        EXPECT_TRUE(found) << "PROTOCOL.md example is not a golden vector: " << hex;
+    }
+    EXPECT_GE(examples, 11u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <WiFiManager/LinkEventQueue.h>
+#include <thread>
+
+using namespace WiFiSet;
+
+TEST(LinkEventQueue, ReplaysEventsInOrderWithTheirReasons) {
+    LinkEventQueue queue;
+    EXPECT_TRUE(queue.isEmpty());
+
+    // A drop and a reconnect between two polls
+    ASSERT_TRUE(queue.push(LinkEvent(LinkEvent::DISCONNECTED, 200)));
+    ASSERT_TRUE(queue.push(LinkEvent(LinkEvent::STA_CONNECTED, 3)));
+    ASSERT_TRUE(queue.push(LinkEvent(LinkEvent::DISCONNECTED, 15)));
+
+    LinkEvent event;
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.type, LinkEvent::DISCONNECTED);
+    EXPECT_EQ(event.detail, 200);
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.type, LinkEvent::STA_CONNECTED);
+    EXPECT_EQ(event.detail, 3);
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.type, LinkEvent::DISCONNECTED);
+    EXPECT_EQ(event.detail, 15);
+
+    EXPECT_FALSE(queue.pop(event));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(LinkEventQueue, FullQueueDropsAndCountsNewEvents) {
+    LinkEventQueue queue;
+    for (size_t i = 0; i < LINK_EVENT_QUEUE_SIZE; i++) {
+        ASSERT_TRUE(queue.push(LinkEvent(LinkEvent::DISCONNECTED, static_cast<uint8_t>(i))));
+    }
+    EXPECT_FALSE(queue.push(LinkEvent(LinkEvent::GOT_IP, 0)));
+    EXPECT_FALSE(queue.push(LinkEvent(LinkEvent::GOT_IP, 0)));
+    EXPECT_EQ(queue.takeDropped(), 2u);
+    EXPECT_EQ(queue.takeDropped(), 0u);
+
+    // The oldest events survive
+    LinkEvent event;
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.detail, 0);
+}
+
+TEST(LinkEventQueue, ClearDiscardsAndWrapsAround) {
+    LinkEventQueue queue;
+    LinkEvent event;
+    for (size_t round = 0; round < 3 * LINK_EVENT_QUEUE_SIZE; round++) {
+        ASSERT_TRUE(queue.push(LinkEvent(LinkEvent::DISCONNECTED, static_cast<uint8_t>(round))));
+        ASSERT_TRUE(queue.pop(event));
+        EXPECT_EQ(event.detail, static_cast<uint8_t>(round));
+    }
+
+    queue.push(LinkEvent(LinkEvent::STA_CONNECTED, 3));
+    queue.push(LinkEvent(LinkEvent::GOT_IP, 0));
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.pop(event));
+}
+
+TEST(LinkEventQueue, EventTaskToLoopKeepsOrder) {
+    LinkEventQueue queue;
+    const uint32_t EVENTS = 100000;
+
+    // The WiFi event task retries a full queue here so every event arrives
+    std::thread producer([&queue, EVENTS]() {
+        for (uint32_t i = 0; i < EVENTS; i++) {
+            while (!queue.push(LinkEvent(LinkEvent::DISCONNECTED, static_cast<uint8_t>(i)))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t received = 0;
+    LinkEvent event;
+    while (received < EVENTS) {
+        if (queue.pop(event)) {
+            ASSERT_EQ(event.detail, static_cast<uint8_t>(received));
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.isEmpty());
+}
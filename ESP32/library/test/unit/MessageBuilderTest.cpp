@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <AllocationCounter.h>
+#include <BLEService/ReplyQueue.h>
+#include <Protocol/MessageBuilder.h>
+#include <Protocol/MessageTransport.h>
+
+using namespace WiFiSet;
+
+/**
+ * The encode*() API must not touch the heap
+ *
+ * Each test replays what a WiFiSetBLEService send path does with a message
+ * (encode into a stack buffer, fragment to the MTU, or queue it from a BLE
+ * callback) under an AllocationCounter scope. The BLE stack itself is not
+ * part of the host build.
+ */
+namespace {
+
+const size_t NOTIFY_CAPACITIES[] = {20, 182, 244, 514};   // MTU 23, 185, 247, 517
+
+WiFiNetworkInfo makeNetwork(size_t index) {
+    WiFiNetworkInfo network = WiFiNetworkInfo();
+    char ssid[MAX_SSID_LENGTH + 1];
+    snprintf(ssid, sizeof(ssid), "Neighbour-Network-%02u", static_cast<unsigned>(index));
+    network.setSSID(ssid);
+    network.rssi = static_cast<int8_t>(-30 - static_cast<int>(index));
+    network.securityType = SecurityType::WPA_PSK;
+    network.channel = static_cast<uint8_t>(1 + index % 13);
+    return network;
+}
+
+/**
+ * Fragment as sendData() does; returns the number of bytes "sent"
+ */
+size_t sendFragments(const uint8_t* data, size_t length, size_t capacity) {
+    MessageFragmenter fragmenter(data, length, capacity);
+    const uint8_t* chunk;
+    size_t chunkLength;
+    size_t sent = 0;
+    while (fragmenter.next(chunk, chunkLength)) {
+        sent += chunkLength;
+    }
+    return sent;
+}
+
+} // namespace
+
+TEST(MessageBuilderAllocations, NetworkListDoesNotAllocate) {
+    NetworkList networks;
+    for (size_t i = 0; i < MAX_NETWORK_LIST_SIZE; i++) {
+        networks.push_back(makeNetwork(i));
+    }
+    MessageBuilder builder;
+
+    for (size_t capacity : NOTIFY_CAPACITIES) {
+        AllocationCounter::Scope scope;
+        uint8_t buffer[514];
+
+        // sendWiFiNetworkList(): start, batches (or single entries below the batch minimum), end
+        size_t length = builder.encodeWiFiListStart(buffer, sizeof(buffer));
+        ASSERT_EQ(sendFragments(buffer, length, capacity), length);
+
+        size_t index = 0;
+        while (index < networks.size()) {
+            size_t sent = 1;
+            if (capacity >= MIN_NETWORK_BATCH_SIZE) {
+                length = builder.encodeWiFiNetworkBatch(networks, index, buffer, capacity, sent);
+            } else {
+                length = builder.encodeWiFiNetworkEntry(networks[index], buffer, sizeof(buffer));
+            }
+            ASSERT_GT(length, 0u);
+            ASSERT_GT(sent, 0u);
+            ASSERT_EQ(sendFragments(buffer, length, capacity), length);
+            index += sent;
+        }
+
+        length = builder.encodeWiFiListEnd(static_cast<uint8_t>(networks.size()), buffer, sizeof(buffer));
+        ASSERT_EQ(sendFragments(buffer, length, capacity), length);
+
+        EXPECT_EQ(scope.allocations(), 0u) << "capacity " << capacity;
+    }
+}
+
+TEST(MessageBuilderAllocations, StatusResponseDoesNotAllocate) {
+    MessageBuilder builder;
+    String ssid("A-Long-Home-Network-Name");     // Past String's inline buffer
+    IPAddress ip(192, 168, 1, 42);
+
+    AllocationCounter::Scope scope;
+    uint8_t buffer[MAX_STATUS_RESPONSE_SIZE];
+    size_t length = builder.encodeStatusResponse(ConnectionState::CONNECTED, -48, ip, ssid, 0, buffer, sizeof(buffer));
+    EXPECT_EQ(length, MESSAGE_HEADER_SIZE + 1 + 1 + 4 + 1 + ssid.length() + 1);
+    EXPECT_EQ(sendFragments(buffer, length, 20), length);
+    EXPECT_EQ(scope.allocations(), 0u);
+}
+
+TEST(MessageBuilderAllocations, ErrorDoesNotAllocate) {
+    MessageBuilder builder;
+    String message("Credential write failed: storage unavailable");
+
+    AllocationCounter::Scope scope;
+    uint8_t buffer[MAX_ERROR_SIZE];
+    size_t length = builder.encodeError(ErrorCode::STORAGE_ERROR, "Storage error", buffer, sizeof(buffer));
+    EXPECT_GT(length, 0u);
+    length = builder.encodeError(ErrorCode::CREDENTIAL_WRITE_FAILED, message, buffer, sizeof(buffer));
+    EXPECT_EQ(length, MESSAGE_HEADER_SIZE + 1 + 1 + message.length());
+    EXPECT_EQ(scope.allocations(), 0u);
+}
+
+TEST(MessageBuilderAllocations, QueuedReplyDoesNotAllocate) {
+    // Replies sent from BLE callbacks go through the reply queue to loop()
+    MessageBuilder builder;
+    ReplyQueue queue;
+
+    AllocationCounter::Scope scope;
+    uint8_t buffer[MAX_ERROR_SIZE];
+    size_t length = builder.encodeError(ErrorCode::INVALID_MESSAGE_FORMAT, "Malformed message", buffer, sizeof(buffer));
+    ASSERT_TRUE(queue.push(2, buffer, length));
+
+    uint8_t out[REPLY_QUEUE_SIZE];
+    uint8_t channel = 0;
+    size_t outLength = 0;
+    ASSERT_TRUE(queue.pop(channel, out, sizeof(out), outLength));
+    EXPECT_EQ(channel, 2);
+    EXPECT_EQ(outLength, length);
+    EXPECT_EQ(memcmp(out, buffer, length), 0);
+    EXPECT_EQ(scope.allocations(), 0u);
+}
+
+TEST(MessageBuilderAllocations, ShortBufferEncodesNothing) {
+    MessageBuilder builder;
+    WiFiNetworkInfo network = makeNetwork(1);
+    uint8_t buffer[MAX_NETWORK_ENTRY_SIZE];
+
+    EXPECT_EQ(builder.encodeWiFiNetworkEntry(network, buffer, MESSAGE_HEADER_SIZE + 3), 0u);
+    EXPECT_EQ(builder.encodeWiFiListStart(buffer, MESSAGE_HEADER_SIZE - 1), 0u);
+}
+
+TEST(MessageBuilderAllocations, BuildMatchesEncode) {
+    // The vector API still allocates (and the counter sees it); its bytes match encode*()
+    MessageBuilder builder;
+    WiFiNetworkInfo network = makeNetwork(3);
+    uint8_t buffer[MAX_NETWORK_ENTRY_SIZE];
+    size_t length = builder.encodeWiFiNetworkEntry(network, buffer, sizeof(buffer));
+    buffer[1] = 0;  // Sequence differs between the two calls
+
+    std::vector<uint8_t> built;
+    {
+        AllocationCounter::Scope scope;
+        built = builder.buildWiFiNetworkEntry(network);
+        EXPECT_GT(scope.allocations(), 0u);
+    }
+    ASSERT_EQ(built.size(), length);
+    built[1] = 0;
+    EXPECT_EQ(memcmp(built.data(), buffer, length), 0);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <Protocol/MessageBuilder.h>
+#include <Protocol/MessageTransport.h>
+#include <Protocol/ProtocolHandler.h>
+
+using namespace WiFiSet;
+
+/**
+ * Fragmentation and reassembly at every ATT MTU from 23 to 517
+ *
+ * Outgoing messages are split with MessageFragmenter into MTU - 3 byte
+ * notifications; incoming writes of the same size are reassembled by
+ * ProtocolHandler::feed() using the header's payload length.
+ */
+namespace {
+
+const size_t MIN_MTU = 23;
+const size_t MAX_MTU = 517;
+const size_t ATT_OVERHEAD = 3;
+
+std::vector<std::vector<uint8_t>> fragment(const uint8_t* data, size_t length, size_t capacity) {
+    std::vector<std::vector<uint8_t>> chunks;
+    MessageFragmenter fragmenter(data, length, capacity);
+    const uint8_t* chunk;
+    size_t chunkLength;
+    while (fragmenter.next(chunk, chunkLength)) {
+        chunks.emplace_back(chunk, chunk + chunkLength);
+    }
+    return chunks;
+}
+
+/**
+ * Outgoing messages of every size class: one notification, a few, many
+ */
+std::vector<std::vector<uint8_t>> outgoingMessages() {
+    MessageBuilder builder;
+    std::vector<std::vector<uint8_t>> messages;
+    messages.push_back(builder.buildCredentialWriteAck(0));
+
+    WiFiNetworkInfo network = WiFiNetworkInfo();
+    network.setSSID("Network-With-A-Thirty-Two-Byte-N");
+    network.rssi = -60;
+    network.securityType = SecurityType::WPA3;
+    network.channel = 11;
+    messages.push_back(builder.buildWiFiNetworkEntry(network));
+
+    std::string longError(MAX_ERROR_MESSAGE_LENGTH, 'e');
+    messages.push_back(builder.buildError(ErrorCode::STORAGE_ERROR, String(longError.c_str())));
+
+    NetworkList networks;
+    for (size_t i = 0; i < MAX_NETWORK_LIST_SIZE; i++) {
+        network.ssid[0] = static_cast<char>('A' + i % 26);
+        networks.push_back(network);
+    }
+    uint8_t buffer[1024];
+    size_t count = 0;
+    size_t length = builder.encodeWiFiNetworkBatch(networks, 0, buffer, sizeof(buffer), count);
+    messages.emplace_back(buffer, buffer + length);
+    return messages;
+}
+
+/**
+ * Incoming messages, back to back as a client would write them
+ */
+std::vector<uint8_t> incomingStream() {
+    std::vector<uint8_t> stream;
+    uint8_t buffer[128];
+    size_t length = CredentialWriteSchema::encode(buffer, sizeof(buffer), 1,
+                                                  Schema::StringRef("Network-With-A-Thirty-Two-Byte-N"),
+                                                  Schema::StringRef(std::string(MAX_PASSWORD_LENGTH, 'p').c_str()));
+    stream.insert(stream.end(), buffer, buffer + length);
+    length = StatusRequestSchema::encode(buffer, sizeof(buffer), 2);
+    stream.insert(stream.end(), buffer, buffer + length);
+    length = IPConfigWriteSchema::encode(buffer, sizeof(buffer), 3, IPMode::STATIC, IPAddress(10, 0, 0, 5),
+                                         IPAddress(255, 255, 255, 0), IPAddress(10, 0, 0, 1), IPAddress(),
+                                         IPAddress());
+    stream.insert(stream.end(), buffer, buffer + length);
+    length = SavedNetworkAddSchema::encode(buffer, sizeof(buffer), 4, Schema::StringRef("Office"),
+                                           Schema::StringRef("hunter22"), 7);
+    stream.insert(stream.end(), buffer, buffer + length);
+    return stream;
+}
+
+} // namespace
+
+TEST(MessageTransport, FragmentsEveryMessageAtEveryMTU) {
+    std::vector<std::vector<uint8_t>> messages = outgoingMessages();
+
+    for (size_t mtu = MIN_MTU; mtu <= MAX_MTU; mtu++) {
+        size_t capacity = mtu - ATT_OVERHEAD;
+        for (const std::vector<uint8_t>& message : messages) {
+            MessageFragmenter fragmenter(message.data(), message.size(), capacity);
+            std::vector<std::vector<uint8_t>> chunks = fragment(message.data(), message.size(), capacity);
+
+            ASSERT_EQ(chunks.size(), fragmenter.fragmentCount()) << "MTU " << mtu;
+            ASSERT_EQ(chunks.size(), (message.size() + capacity - 1) / capacity) << "MTU " << mtu;
+
+            std::vector<uint8_t> joined;
+            for (size_t i = 0; i < chunks.size(); i++) {
+                ASSERT_GT(chunks[i].size(), 0u);
+                ASSERT_LE(chunks[i].size(), capacity) << "MTU " << mtu;
+                if (i + 1 < chunks.size()) {
+                    ASSERT_EQ(chunks[i].size(), capacity) << "MTU " << mtu;   // Only the last may be short
+                }
+                joined.insert(joined.end(), chunks[i].begin(), chunks[i].end());
+            }
+            ASSERT_EQ(joined, message) << "MTU " << mtu;
+        }
+    }
+}
+
+TEST(MessageTransport, ReassemblesWritesAtEveryMTU) {
+    std::vector<uint8_t> stream = incomingStream();
+    const MessageType expected[] = {MessageType::CREDENTIAL_WRITE, MessageType::STATUS_REQUEST,
+                                    MessageType::IP_CONFIG_WRITE, MessageType::SAVED_NETWORK_ADD};
+
+    for (size_t mtu = MIN_MTU; mtu <= MAX_MTU; mtu++) {
+        ProtocolHandler handler;
+        size_t received = 0;
+
+        for (const std::vector<uint8_t>& write : fragment(stream.data(), stream.size(), mtu - ATT_OVERHEAD)) {
+            // A write may end one message and start the next
+            size_t offset = 0;
+            while (offset < write.size()) {
+                size_t consumed = 0;
+                ParseResult result = handler.feed(write.data() + offset, write.size() - offset, consumed);
+                ASSERT_GT(consumed, 0u);
+                offset += consumed;
+                ASSERT_NE(result, ParseResult::MESSAGE_INVALID) << "MTU " << mtu;
+                if (result == ParseResult::MESSAGE_READY) {
+                    const ParsedMessage& message = handler.getMessage();
+                    ASSERT_LT(received, 4u);
+                    EXPECT_EQ(message.header.type, expected[received]) << "MTU " << mtu;
+                    EXPECT_EQ(message.header.sequence, received + 1) << "MTU " << mtu;
+                    if (message.header.type == MessageType::CREDENTIAL_WRITE) {
+                        EXPECT_EQ(message.credentials.ssid.length(), MAX_SSID_LENGTH);
+                        EXPECT_EQ(message.credentials.password.length(), MAX_PASSWORD_LENGTH);
+                    } else if (message.header.type == MessageType::SAVED_NETWORK_ADD) {
+                        EXPECT_STREQ(message.savedNetwork.ssid.c_str(), "Office");
+                        EXPECT_EQ(message.savedNetwork.priority, 7);
+                    }
+                    received++;
+                }
+            }
+        }
+
+        EXPECT_EQ(received, 4u) << "MTU " << mtu;
+        EXPECT_FALSE(handler.isParsing()) << "MTU " << mtu;
+    }
+}
+
+TEST(MessageTransport, SingleByteWrites) {
+    // Below any real MTU: the parser must not depend on chunk boundaries at all
+    std::vector<uint8_t> stream = incomingStream();
+    ProtocolHandler handler;
+    size_t received = 0;
+
+    for (uint8_t byte : stream) {
+        size_t consumed = 0;
+        ParseResult result = handler.feed(&byte, 1, consumed);
+        ASSERT_EQ(consumed, 1u);
+        ASSERT_NE(result, ParseResult::MESSAGE_INVALID);
+        if (result == ParseResult::MESSAGE_READY) {
+            received++;
+        }
+    }
+    EXPECT_EQ(received, 4u);
+}
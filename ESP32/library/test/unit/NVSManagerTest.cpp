@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <HostControl.h>
+#include <Storage/NVSManager.h>
+
+using namespace WiFiSet;
+
+/**
+ * The saved network table and the current network boot joins
+ *
+ * Boot connects to the current network when the table holds a single entry
+ * (there is nothing to scan for), so the table must never be left without
+ * one while it has networks.
+ */
+namespace {
+
+String currentSSID(NVSManager& nvs) {
+    StoredCredentials credentials;
+    nvs.loadCredentials(credentials);
+    return credentials.isValid ? credentials.ssid : String();
+}
+
+} // namespace
+
+TEST(NVSManager, FirstSavedNetworkBecomesCurrent) {
+    Host::reset();
+    NVSManager nvs;
+    ASSERT_TRUE(nvs.begin());
+
+    // Saved Network Add on an empty table, no Credential Write ever
+    ASSERT_EQ(nvs.saveNetwork("Office", "hunter22", 3), Status::OK);
+    StoredCredentials credentials;
+    ASSERT_EQ(nvs.loadCredentials(credentials), Status::OK);
+    EXPECT_STREQ(credentials.ssid.c_str(), "Office");
+    EXPECT_STREQ(credentials.password.c_str(), "hunter22");
+
+    // Later adds leave it current
+    ASSERT_EQ(nvs.saveNetwork("Home", "password", 9), Status::OK);
+    EXPECT_STREQ(currentSSID(nvs).c_str(), "Office");
+
+    Host::reset();
+}
+
+TEST(NVSManager, RemovingCurrentPromotesMostPreferred) {
+    Host::reset();
+    NVSManager nvs;
+    ASSERT_TRUE(nvs.begin());
+    ASSERT_EQ(nvs.saveCredentials("Home", "password"), Status::OK);
+    ASSERT_EQ(nvs.saveNetwork("Cafe", "espresso", 1), Status::OK);
+    ASSERT_EQ(nvs.saveNetwork("Office", "hunter22", 5), Status::OK);
+
+    StoredLocation location;
+    location.channel = 6;
+    location.isValid = true;
+    ASSERT_EQ(nvs.saveLocation(location), Status::OK);
+
+    ASSERT_EQ(nvs.removeNetwork("Home"), Status::OK);
+    StoredCredentials credentials;
+    ASSERT_EQ(nvs.loadCredentials(credentials), Status::OK);
+    EXPECT_STREQ(credentials.ssid.c_str(), "Office");
+    EXPECT_STREQ(credentials.password.c_str(), "hunter22");
+
+    // The location was Home's
+    StoredLocation loaded;
+    EXPECT_EQ(nvs.loadLocation(loaded), Status::NO_STORED_LOCATION);
+
+    // A single entry left: it is the one boot joins
+    ASSERT_EQ(nvs.removeNetwork("Office"), Status::OK);
+    EXPECT_STREQ(currentSSID(nvs).c_str(), "Cafe");
+    StoredNetworkList networks;
+    ASSERT_EQ(nvs.loadNetworks(networks), Status::OK);
+    ASSERT_EQ(networks.size(), 1u);
+    EXPECT_STREQ(networks[0].ssid, "Cafe");
+
+    ASSERT_EQ(nvs.removeNetwork("Cafe"), Status::OK);
+    EXPECT_EQ(nvs.loadCredentials(credentials), Status::NO_STORED_CREDENTIALS);
+    EXPECT_EQ(nvs.loadNetworks(networks), Status::NO_STORED_CREDENTIALS);
+    EXPECT_FALSE(nvs.hasCredentials());
+
+    Host::reset();
+}
+
+TEST(NVSManager, RemovingAnotherNetworkKeepsCurrent) {
+    Host::reset();
+    NVSManager nvs;
+    ASSERT_TRUE(nvs.begin());
+    ASSERT_EQ(nvs.saveCredentials("Home", "password"), Status::OK);
+    ASSERT_EQ(nvs.saveNetwork("Office", "hunter22", 5), Status::OK);
+
+    ASSERT_EQ(nvs.removeNetwork("Office"), Status::OK);
+    EXPECT_STREQ(currentSSID(nvs).c_str(), "Home");
+    EXPECT_EQ(nvs.removeNetwork("Office"), Status::NETWORK_NOT_STORED);
+
+    Host::reset();
+}
+
+TEST(NVSManager, PromotionSurvivesReboot) {
+    Host::reset();
+    {
+        NVSManager nvs;
+        ASSERT_TRUE(nvs.begin());
+        ASSERT_EQ(nvs.saveCredentials("Home", "password"), Status::OK);
+        ASSERT_EQ(nvs.saveNetwork("Office", "hunter22", 5), Status::OK);
+        ASSERT_EQ(nvs.removeNetwork("Home"), Status::OK);
+    }
+
+    // A new manager reads NVS rather than its cached table
+    NVSManager nvs;
+    ASSERT_TRUE(nvs.begin());
+    EXPECT_TRUE(nvs.hasCredentials());
+    EXPECT_STREQ(currentSSID(nvs).c_str(), "Office");
+
+    Host::reset();
+}
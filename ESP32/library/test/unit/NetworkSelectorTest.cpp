@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <SyntheticScan.h>
+#include <WiFiManager/NetworkSelector.h>
+#include <algorithm>
+#include <map>
+#include <string>
+
+using namespace WiFiSet;
+
+namespace {
+
+struct Expected {
+    int8_t rssi;
+    uint8_t apCount;
+    uint16_t channelMask;
+};
+
+/**
+ * Straightforward merge of a scan by SSID, to check the selector against
+ */
+std::map<std::string, Expected> mergeBySSID(const std::vector<WiFiNetworkInfo>& scan) {
+    std::map<std::string, Expected> merged;
+    for (const WiFiNetworkInfo& ap : scan) {
+        if (!ap.hasSSID()) {
+            continue;
+        }
+        auto found = merged.find(ap.ssid);
+        if (found == merged.end()) {
+            merged[ap.ssid] = Expected{ap.rssi, 1, static_cast<uint16_t>(1u << ap.channel)};
+        } else {
+            found->second.rssi = std::max(found->second.rssi, ap.rssi);
+            found->second.apCount++;
+            found->second.channelMask |= static_cast<uint16_t>(1u << ap.channel);
+        }
+    }
+    return merged;
+}
+
+} // namespace
+
+TEST(NetworkSelector, MergesMeshNetworksBySSID) {
+    std::vector<WiFiNetworkInfo> scan = SyntheticScan(200, 40, 10).generate();
+    NetworkSelector selector;
+    for (const WiFiNetworkInfo& ap : scan) {
+        selector.add(ap);
+    }
+
+    std::map<std::string, Expected> expected = mergeBySSID(scan);
+    size_t hidden = std::count_if(scan.begin(), scan.end(), [](const WiFiNetworkInfo& ap) { return !ap.hasSSID(); });
+    ASSERT_EQ(selector.size(), std::min(expected.size() + hidden, MAX_SCAN_CANDIDATES));
+
+    for (const WiFiNetworkInfo& network : selector.getCandidates()) {
+        if (!network.hasSSID()) {
+            EXPECT_EQ(network.apCount, 1);  // Hidden APs are never merged
+            continue;
+        }
+        const Expected& merged = expected.at(network.ssid);
+        EXPECT_EQ(network.rssi, merged.rssi) << network.ssid;
+        EXPECT_EQ(network.apCount, merged.apCount) << network.ssid;
+        EXPECT_EQ(network.channelMask, merged.channelMask) << network.ssid;
+    }
+}
+
+TEST(NetworkSelector, SelectsStrongestFirst) {
+    std::vector<WiFiNetworkInfo> scan = SyntheticScan(200, 40).generate();
+    NetworkSelector selector;
+    for (const WiFiNetworkInfo& ap : scan) {
+        selector.add(ap);
+    }
+
+    std::vector<int8_t> strongest;
+    for (const auto& entry : mergeBySSID(scan)) {
+        strongest.push_back(entry.second.rssi);
+    }
+    std::sort(strongest.begin(), strongest.end(), std::greater<int8_t>());
+
+    for (size_t k : {1u, 10u, 20u, 40u, 64u}) {
+        NetworkList results;
+        selector.selectTop(k, results);
+        ASSERT_EQ(results.size(), std::min(k, strongest.size()));
+        for (size_t i = 0; i < results.size(); i++) {
+            EXPECT_EQ(results[i].rssi, strongest[i]) << "k " << k << " rank " << i;
+        }
+    }
+}
+
+TEST(NetworkSelector, FullTableKeepsTheStrongest) {
+    // 200 distinct SSIDs into 64 slots: the 64 strongest survive
+    std::vector<WiFiNetworkInfo> scan = SyntheticScan(200, 200).generate();
+    NetworkSelector selector;
+    for (const WiFiNetworkInfo& ap : scan) {
+        selector.add(ap);
+    }
+    ASSERT_EQ(selector.size(), MAX_SCAN_CANDIDATES);
+
+    std::vector<int8_t> all;
+    for (const WiFiNetworkInfo& ap : scan) {
+        all.push_back(ap.rssi);
+    }
+    std::sort(all.begin(), all.end(), std::greater<int8_t>());
+
+    NetworkList results;
+    selector.selectTop(MAX_SCAN_CANDIDATES, results);
+    for (size_t i = 0; i < results.size(); i++) {
+        EXPECT_EQ(results[i].rssi, all[i]) << "rank " << i;
+    }
+}
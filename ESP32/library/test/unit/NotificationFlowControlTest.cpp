@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <ControllerQueueModel.h>
+#include <BLEService/NotificationFlowControl.h>
+
+using namespace WiFiSet;
+
+namespace {
+
+const uint32_t LIST_NOTIFICATIONS = 64;
+
+/**
+ * Send a full network list through the model and wait until it is on air
+ */
+ControllerQueueModel::Stats sendList(ControllerQueueModel& link) {
+    for (uint32_t i = 0; i < LIST_NOTIFICATIONS; i++) {
+        link.send();
+    }
+    link.drain();
+    return link.stats();
+}
+
+} // namespace
+
+TEST(NotificationFlowControl, CreditsLimitInFlight) {
+    NotificationFlowControl flow(3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(flow.canSend());
+        flow.onSent();
+    }
+    EXPECT_FALSE(flow.canSend());
+    EXPECT_EQ(flow.getInFlight(), 3);
+
+    flow.onComplete();
+    EXPECT_TRUE(flow.canSend());
+    flow.onDropped();
+    EXPECT_EQ(flow.getInFlight(), 1);
+}
+
+TEST(NotificationFlowControl, CompletionAfterResetDoesNotUnderflow) {
+    NotificationFlowControl flow(2);
+    flow.onSent();
+    flow.reset();
+    flow.onComplete();      // Late completion of the notification sent before the reset
+    EXPECT_EQ(flow.getInFlight(), 0);
+
+    flow.onSent();
+    flow.onSent();
+    EXPECT_FALSE(flow.canSend());
+}
+
+TEST(NotificationFlowControl, CongestionBlocksSending) {
+    NotificationFlowControl flow;
+    flow.setCongested(true);
+    EXPECT_FALSE(flow.canSend());
+    flow.setCongested(false);
+    EXPECT_TRUE(flow.canSend());
+
+    flow.setCongested(true);
+    flow.reset();
+    EXPECT_TRUE(flow.canSend());
+}
+
+TEST(ControllerQueueModel, NeverOverflowsTheController) {
+    const LinkProfile profiles[] = {LinkProfile::fast(), LinkProfile::typical(), LinkProfile::slow()};
+    for (const LinkProfile& profile : profiles) {
+        NotificationFlowControl flow;
+        ControllerQueueModel link(flow, profile);
+
+        ControllerQueueModel::Stats stats = sendList(link);
+        EXPECT_EQ(stats.delivered, LIST_NOTIFICATIONS);
+        EXPECT_EQ(stats.overflowed, 0u);
+        EXPECT_EQ(stats.creditTimeouts, 0u);
+        EXPECT_LE(stats.maxQueued, flow.getCredits());
+        EXPECT_EQ(flow.getInFlight(), 0);
+    }
+}
+
+TEST(ControllerQueueModel, ThroughputFollowsTheLink) {
+    uint64_t elapsed[3];
+    const LinkProfile profiles[] = {LinkProfile::fast(), LinkProfile::typical(), LinkProfile::slow()};
+    for (size_t i = 0; i < 3; i++) {
+        NotificationFlowControl flow;
+        ControllerQueueModel link(flow, profiles[i]);
+        sendList(link);
+        elapsed[i] = link.nowUs();
+    }
+
+    EXPECT_LT(elapsed[0], elapsed[1]);
+    EXPECT_LT(elapsed[1], elapsed[2]);
+
+    // A fast link carries the list in a fraction of the old 100 ms-per-notification pacing
+    EXPECT_LT(elapsed[0], LIST_NOTIFICATIONS * 100000ULL / 20);
+
+    // A slow link (one packet per 50 ms event) is limited by the link, not by timeouts
+    EXPECT_LE(elapsed[2], (LIST_NOTIFICATIONS + 1) * 50000ULL);
+}
+
+TEST(ControllerQueueModel, FixedPacingOverflowsASlowLink) {
+    // The old pacing sent regardless of the controller; at 10 ms it outruns a 50 ms link
+    NotificationFlowControl flow;
+    ControllerQueueModel link(flow, LinkProfile(50000, 1, 12));
+    for (uint32_t i = 0; i < LIST_NOTIFICATIONS; i++) {
+        link.sendPaced(10000);
+    }
+    link.drain();
+    EXPECT_GT(link.stats().overflowed, 0u);
+}
+
+TEST(ControllerQueueModel, CongestionKeepsExtraCreditsSafe) {
+    // More credits than controller buffers: only congestion reports prevent overflow
+    NotificationFlowControl withoutReports(20);
+    ControllerQueueModel bare(withoutReports, LinkProfile(30000, 2, 12, 0));
+    EXPECT_GT(sendList(bare).overflowed, 0u);
+
+    NotificationFlowControl withReports(20);
+    ControllerQueueModel reported(withReports, LinkProfile(30000, 2, 12, 10));
+    ControllerQueueModel::Stats stats = sendList(reported);
+    EXPECT_EQ(stats.overflowed, 0u);
+    EXPECT_EQ(stats.delivered, LIST_NOTIFICATIONS);
+}
+
+TEST(ControllerQueueModel, RefusedNotificationsReturnTheirCredit) {
+    // Client has not enabled notifications: the stack refuses every one
+    NotificationFlowControl flow;
+    ControllerQueueModel link(flow, LinkProfile::typical());
+    link.setNotificationsEnabled(false);
+
+    for (uint32_t i = 0; i < 3 * DEFAULT_NOTIFY_CREDITS; i++) {
+        EXPECT_FALSE(link.send());
+    }
+    EXPECT_EQ(link.stats().refused, 3u * DEFAULT_NOTIFY_CREDITS);
+    EXPECT_EQ(link.stats().creditTimeouts, 0u);
+    EXPECT_EQ(flow.getInFlight(), 0);
+    EXPECT_EQ(link.nowUs(), 0u);    // Never waited
+}
+
+TEST(ControllerQueueModel, StalledLinkTimesOut) {
+    // No completions ever arrive: the wait gives up instead of hanging
+    NotificationFlowControl flow;
+    ControllerQueueModel link(flow, LinkProfile(30000, 0, 12));
+
+    for (uint32_t i = 0; i <= DEFAULT_NOTIFY_CREDITS; i++) {
+        link.send();
+    }
+    EXPECT_EQ(link.stats().creditTimeouts, 1u);
+    EXPECT_GE(link.nowUs(), 100000u);
+    EXPECT_LT(link.nowUs(), 200000u);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <HostControl.h>
+#include <Storage/NVSManager.h>
+#include <WiFiManager/PairwiseMasterKey.h>
+#include <WiFiManager/WiFiManager.h>
+#include <memory>
+#include <string>
+
+using namespace WiFiSet;
+
+/**
+ * PMK derivation against the IEEE 802.11i-2004 (Annex H.4) test vectors,
+ * and the stored key in use: accepted by the AP in place of the passphrase
+ * and kept in NVS only as long as the credentials it came from
+ */
+namespace {
+
+struct KnownAnswer {
+    const char* passphrase;
+    const char* ssid;
+    const char* psk;
+};
+
+const KnownAnswer IEEE_802_11I_VECTORS[] = {
+    {"password", "IEEE", "f42c6fc52df0ebef9ebb4b90b38a5f902e83fe1b135a70e23aed762e9710a12e"},
+    {"ThisIsAPassword", "ThisIsASSID", "0dc0d6eb90555ed6419756b9a15ec3e3209b63df707dd508d14581f8982721af"},
+    {"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "ZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZ",
+     "becb93866bb8c3832cb777c2f559807c8c59afcb6eae734885001300a981cc62"},
+};
+
+} // namespace
+
+TEST(PairwiseMasterKey, MatchesIEEE80211iVectors) {
+    for (const KnownAnswer& vector : IEEE_802_11I_VECTORS) {
+        PairwiseMasterKey pmk;
+        ASSERT_TRUE(pmk.derive(vector.ssid, vector.passphrase)) << vector.ssid;
+        EXPECT_TRUE(pmk.isValid);
+        EXPECT_STREQ(pmk.toPSK().c_str(), vector.psk) << vector.ssid;
+        EXPECT_EQ(pmk.toPSK().length(), PMK_HEX_LENGTH);
+    }
+}
+
+TEST(PairwiseMasterKey, SetAdoptsAStoredKey) {
+    PairwiseMasterKey derived;
+    ASSERT_TRUE(derived.derive("IEEE", "password"));
+
+    PairwiseMasterKey stored;
+    stored.set(derived.key);
+    EXPECT_TRUE(stored.isValid);
+    EXPECT_STREQ(stored.toPSK().c_str(), IEEE_802_11I_VECTORS[0].psk);
+}
+
+TEST(PairwiseMasterKey, RejectsWhatHasNoPMK) {
+    PairwiseMasterKey pmk;
+    EXPECT_FALSE(pmk.derive("", "password"));                   // No SSID
+    EXPECT_FALSE(pmk.derive("IEEE", ""));                       // Open network
+    EXPECT_FALSE(pmk.derive("IEEE", "short12"));                // 7 characters
+    EXPECT_FALSE(pmk.derive("IEEE", IEEE_802_11I_VECTORS[0].psk));   // Already a hex PSK
+    EXPECT_FALSE(pmk.isValid);
+
+    EXPECT_TRUE(pmk.derive("IEEE", "12345678"));
+    EXPECT_TRUE(pmk.derive("IEEE", String(std::string(MAX_PASSPHRASE_LENGTH, 'x').c_str())));
+}
+
+TEST(PairwiseMasterKey, UsedOnlyByWPAPersonal) {
+    EXPECT_TRUE(PairwiseMasterKey::usedBy(WIFI_AUTH_WPA_PSK));
+    EXPECT_TRUE(PairwiseMasterKey::usedBy(WIFI_AUTH_WPA2_PSK));
+    EXPECT_TRUE(PairwiseMasterKey::usedBy(WIFI_AUTH_WPA_WPA2_PSK));
+    EXPECT_FALSE(PairwiseMasterKey::usedBy(WIFI_AUTH_OPEN));
+    EXPECT_FALSE(PairwiseMasterKey::usedBy(WIFI_AUTH_WPA3_PSK));
+}
+
+TEST(PairwiseMasterKey, APAcceptsThePSKInPlaceOfThePassphrase) {
+    Host::reset();
+    Host::addAccessPoint(Host::AccessPoint("ThisIsASSID", 6, -50, WIFI_AUTH_WPA2_PSK, "ThisIsAPassword"));
+    std::unique_ptr<WiFiManager> manager(new WiFiManager());
+    manager->begin();
+
+    PairwiseMasterKey pmk;
+    ASSERT_TRUE(pmk.derive("ThisIsASSID", "ThisIsAPassword"));
+    EXPECT_EQ(manager->connect("ThisIsASSID", pmk.toPSK()), WiFiConnectResult::SUCCESS);
+    manager->disconnect();
+
+    PairwiseMasterKey wrong;
+    ASSERT_TRUE(wrong.derive("ThisIsASSID", "NotThePassword"));
+    EXPECT_EQ(manager->connect("ThisIsASSID", wrong.toPSK()), WiFiConnectResult::FAILED_WRONG_PASSWORD);
+
+    manager.reset();
+    Host::reset();
+}
+
+TEST(PairwiseMasterKey, StoredKeyIsForgottenWithItsCredentials) {
+    Host::reset();
+    NVSManager nvs;
+    ASSERT_TRUE(nvs.begin());
+    ASSERT_EQ(nvs.saveCredentials("IEEE", "password"), Status::OK);
+
+    PairwiseMasterKey pmk;
+    ASSERT_TRUE(pmk.derive("IEEE", "password"));
+    StoredPMK stored;
+    memcpy(stored.key, pmk.key, sizeof(stored.key));
+    stored.isValid = true;
+    ASSERT_EQ(nvs.savePMK(stored), Status::OK);
+
+    StoredPMK loaded;
+    ASSERT_EQ(nvs.loadPMK(loaded), Status::OK);
+    EXPECT_TRUE(loaded.isValid);
+    EXPECT_EQ(memcmp(loaded.key, pmk.key, PMK_LENGTH), 0);
+
+    // New password: the old key must not be offered to the AP
+    ASSERT_EQ(nvs.saveCredentials("IEEE", "another password"), Status::OK);
+    StoredPMK after;
+    EXPECT_EQ(nvs.loadPMK(after), Status::NO_STORED_PMK);
+    EXPECT_FALSE(after.isValid);
+
+    Host::reset();
+}
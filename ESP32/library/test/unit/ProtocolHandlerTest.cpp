@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <Protocol/ProtocolHandler.h>
+#include <vector>
+
+using namespace WiFiSet;
+
+namespace {
+
+size_t credentialWrite(uint8_t* buffer, size_t capacity, const char* ssid, const char* password) {
+    return CredentialWriteSchema::encode(buffer, capacity, 1, Schema::StringRef(ssid), Schema::StringRef(password));
+}
+
+} // namespace
+
+TEST(ProtocolHandler, ParsesHeader) {
+    ProtocolHandler handler;
+    const uint8_t data[] = {0x20, 0x07, 0x00, 0x00};
+
+    MessageHeader header = handler.parseHeader(data, sizeof(data));
+    EXPECT_TRUE(header.isValid);
+    EXPECT_EQ(header.type, MessageType::STATUS_REQUEST);
+    EXPECT_EQ(header.sequence, 7);
+    EXPECT_EQ(header.payloadLength, 0);
+    EXPECT_TRUE(handler.validateMessage(data, sizeof(data)));
+}
+
+TEST(ProtocolHandler, RejectsShortHeaderAndLengthMismatch) {
+    ProtocolHandler handler;
+    const uint8_t shortHeader[] = {0x20, 0x01, 0x00};
+    const uint8_t mismatch[] = {0x20, 0x01, 0x05, 0x00, 0x00};
+
+    EXPECT_FALSE(handler.parseHeader(shortHeader, sizeof(shortHeader)).isValid);
+    EXPECT_FALSE(handler.validateMessage(mismatch, sizeof(mismatch)));
+}
+
+TEST(ProtocolHandler, ParsesCredentialWrite) {
+    ProtocolHandler handler;
+    uint8_t buffer[CredentialWriteSchema::maxSize];
+    size_t length = credentialWrite(buffer, sizeof(buffer), "HomeNetwork", "password123");
+    ASSERT_GT(length, 0u);
+
+    CredentialData credentials = handler.parseCredentialWrite(buffer, length);
+    EXPECT_TRUE(credentials.isValid);
+    EXPECT_STREQ(credentials.ssid.c_str(), "HomeNetwork");
+    EXPECT_STREQ(credentials.password.c_str(), "password123");
+}
+
+TEST(ProtocolHandler, RejectsMalformedCredentialWrite) {
+    ProtocolHandler handler;
+    uint8_t buffer[CredentialWriteSchema::maxSize + 1];
+    size_t length = credentialWrite(buffer, sizeof(buffer), "HomeNetwork", "password123");
+
+    EXPECT_FALSE(handler.parseCredentialWrite(buffer, length - 1).isValid);   // Truncated
+    EXPECT_EQ(handler.getLastError(), Status::MESSAGE_LENGTH_MISMATCH);
+
+    buffer[length] = 0;                                                         // Trailing byte
+    EXPECT_FALSE(handler.parseCredentialWrite(buffer, length + 1).isValid);
+    EXPECT_EQ(handler.getLastError(), Status::MESSAGE_LENGTH_MISMATCH);
+
+    length = credentialWrite(buffer, sizeof(buffer), "", "password123");       // SSID below 1 byte
+    EXPECT_FALSE(handler.parseCredentialWrite(buffer, length).isValid);
+    EXPECT_EQ(handler.getLastError(), Status::SSID_EMPTY);
+
+    StatusRequestSchema::encode(buffer, sizeof(buffer), 1);
+    EXPECT_FALSE(handler.parseCredentialWrite(buffer, MESSAGE_HEADER_SIZE).isValid);
+    EXPECT_EQ(handler.getLastError(), Status::WRONG_MESSAGE_TYPE);
+}
+
+TEST(ProtocolHandler, FeedAssemblesFragments) {
+    ProtocolHandler handler;
+    uint8_t buffer[CredentialWriteSchema::maxSize];
+    size_t length = credentialWrite(buffer, sizeof(buffer), "HomeNetwork", "password123");
+
+    ParseResult result = ParseResult::NEED_MORE;
+    for (size_t i = 0; i < length; i++) {
+        size_t consumed = 0;
+        result = handler.feed(buffer + i, 1, consumed);
+        ASSERT_EQ(consumed, 1u);
+        if (i + 1 < length) {
+            ASSERT_EQ(result, ParseResult::NEED_MORE);
+        }
+    }
+    ASSERT_EQ(result, ParseResult::MESSAGE_READY);
+
+    const ParsedMessage& message = handler.getMessage();
+    EXPECT_EQ(message.header.type, MessageType::CREDENTIAL_WRITE);
+    EXPECT_STREQ(message.credentials.ssid.c_str(), "HomeNetwork");
+    EXPECT_STREQ(message.credentials.password.c_str(), "password123");
+}
+
+TEST(ProtocolHandler, FeedSplitsBackToBackMessages) {
+    ProtocolHandler handler;
+    uint8_t buffer[2 * MESSAGE_HEADER_SIZE];
+    size_t length = StatusRequestSchema::encode(buffer, sizeof(buffer), 1);
+    length += StatusRequestSchema::encode(buffer + length, sizeof(buffer) - length, 2);
+
+    size_t consumed = 0;
+    ASSERT_EQ(handler.feed(buffer, length, consumed), ParseResult::MESSAGE_READY);
+    EXPECT_EQ(consumed, MESSAGE_HEADER_SIZE);
+    EXPECT_EQ(handler.getMessage().header.sequence, 1);
+
+    ASSERT_EQ(handler.feed(buffer + consumed, length - consumed, consumed), ParseResult::MESSAGE_READY);
+    EXPECT_EQ(handler.getMessage().header.sequence, 2);
+}
+
+TEST(ProtocolHandler, FeedRejectsOversizedPayload) {
+    ProtocolHandler handler;
+    const uint8_t data[] = {0x10, 0x01, 0xFF, 0xFF, 0x00, 0x00};
+
+    // Reported at once; the rest of the announced payload is still to come
+    size_t consumed = 0;
+    EXPECT_EQ(handler.feed(data, sizeof(data), consumed), ParseResult::MESSAGE_INVALID);
+    EXPECT_EQ(consumed, sizeof(data));
+    EXPECT_EQ(handler.getMessage().status, Status::MESSAGE_TOO_LONG);
+    EXPECT_TRUE(handler.isParsing());
+    handler.resetParser();
+    EXPECT_FALSE(handler.isParsing());
+
+    // An oversized Credential Write whose payload is full of valid-looking
+    // Status Request headers, then a real Status Request, in 20-byte writes
+    std::vector<uint8_t> stream = {0x10, 0x01, 0x00, 0x00};
+    size_t payloadLength = ProtocolHandler::MAX_PAYLOAD_SIZE + 100;
+    stream[2] = static_cast<uint8_t>(payloadLength & 0xFF);
+    stream[3] = static_cast<uint8_t>(payloadLength >> 8);
+    for (size_t i = 0; i < payloadLength; i++) {
+        const uint8_t fakeHeader[] = {0x20, 0x07, 0x00, 0x00};
+        stream.push_back(fakeHeader[i % sizeof(fakeHeader)]);
+    }
+    const uint8_t statusRequest[] = {0x20, 0x02, 0x00, 0x00};
+    stream.insert(stream.end(), statusRequest, statusRequest + sizeof(statusRequest));
+
+    size_t errors = 0;
+    size_t ready = 0;
+    for (size_t offset = 0; offset < stream.size();) {
+        size_t length = stream.size() - offset < 20 ? stream.size() - offset : 20;
+        const uint8_t* write = stream.data() + offset;
+        offset += length;
+
+        while (length > 0) {
+            consumed = 0;
+            ParseResult result = handler.feed(write, length, consumed);
+            ASSERT_GT(consumed, 0u);
+            write += consumed;
+            length -= consumed;
+
+            if (result == ParseResult::MESSAGE_INVALID) {
+                errors++;
+                EXPECT_EQ(handler.getMessage().status, Status::MESSAGE_TOO_LONG);
+            } else if (result == ParseResult::MESSAGE_READY) {
+                ready++;
+                EXPECT_EQ(handler.getMessage().header.type, MessageType::STATUS_REQUEST);
+                EXPECT_EQ(handler.getMessage().header.sequence, 2);
+            }
+        }
+    }
+
+    EXPECT_EQ(errors, 1u);
+    EXPECT_EQ(ready, 1u);
+    EXPECT_FALSE(handler.isParsing());
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <WiFiManager/SavedNetworkSelector.h>
+#include <string>
+#include <vector>
+
+using namespace WiFiSet;
+
+namespace {
+
+SavedNetworkInfo makeSaved(const char* ssid, uint8_t priority, uint8_t failureCount = 0, uint32_t lastSuccess = 0) {
+    SavedNetworkInfo network = SavedNetworkInfo();
+    network.setSSID(ssid);
+    network.priority = priority;
+    network.failureCount = failureCount;
+    network.lastSuccess = lastSuccess;
+    return network;
+}
+
+WiFiNetworkInfo makeCandidate(const char* ssid, int8_t rssi, uint8_t channel) {
+    WiFiNetworkInfo network = WiFiNetworkInfo();
+    network.setSSID(ssid);
+    network.rssi = rssi;
+    network.securityType = SecurityType::WPA_PSK;
+    network.channel = channel;
+    return network;
+}
+
+/**
+ * SSIDs of the ranked matches, in order
+ */
+std::vector<std::string> ranked(const SavedNetworkSelector& selector) {
+    SavedNetworkMatchList order;
+    selector.rank(order);
+    std::vector<std::string> ssids;
+    for (const SavedNetworkMatch& match : order) {
+        ssids.push_back(selector.getNetworks()[match.index].ssid);
+    }
+    return ssids;
+}
+
+} // namespace
+
+TEST(SavedNetworkSelector, MatchesOnlyNetworksInRange) {
+    SavedNetworkList saved;
+    saved.push_back(makeSaved("Home", 1));
+    saved.push_back(makeSaved("Office", 1));
+    saved.push_back(makeSaved("Cafe", 1));
+
+    NetworkList candidates;
+    candidates.push_back(makeCandidate("Neighbour", -40, 1));
+    candidates.push_back(makeCandidate("Cafe", -70, 11));
+    candidates.push_back(makeCandidate("Home", -60, 6));
+    candidates.push_back(makeCandidate("Hom", -30, 3));   // Prefix of a saved SSID
+
+    SavedNetworkSelector selector;
+    selector.setNetworks(saved);
+    selector.match(candidates);
+
+    SavedNetworkMatchList order;
+    selector.rank(order);
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[0].index, 0);
+    EXPECT_EQ(order[0].rssi, -60);
+    EXPECT_EQ(order[0].channel, 6);
+    EXPECT_EQ(order[1].index, 2);
+    EXPECT_EQ(order[1].channel, 11);
+
+    // New networks discard the matches
+    selector.setNetworks(saved);
+    selector.rank(order);
+    EXPECT_TRUE(order.empty());
+}
+
+TEST(SavedNetworkSelector, RanksByUsabilityReliabilityPrioritySignalRecency) {
+    SavedNetworkList saved;
+    saved.push_back(makeSaved("Weak", 9));                       // Below MIN_USABLE_RSSI
+    saved.push_back(makeSaved("Failing", 9, MAX_PREFERRED_FAILURES));
+    saved.push_back(makeSaved("Low", 1));
+    saved.push_back(makeSaved("HighFar", 5, 0, 10));
+    saved.push_back(makeSaved("HighNear", 5, 0, 1));
+    saved.push_back(makeSaved("HighNearRecent", 5, 0, 20));
+
+    NetworkList candidates;
+    candidates.push_back(makeCandidate("Weak", MIN_USABLE_RSSI - 1, 1));
+    candidates.push_back(makeCandidate("Failing", -40, 1));
+    candidates.push_back(makeCandidate("Low", -30, 1));
+    candidates.push_back(makeCandidate("HighFar", -75, 1));
+    candidates.push_back(makeCandidate("HighNear", -50, 1));
+    candidates.push_back(makeCandidate("HighNearRecent", -50, 1));
+
+    SavedNetworkSelector selector;
+    selector.setNetworks(saved);
+    selector.match(candidates);
+
+    std::vector<std::string> expected = {"HighNearRecent", "HighNear", "HighFar", "Low", "Failing", "Weak"};
+    EXPECT_EQ(ranked(selector), expected);
+}
+
+TEST(SavedNetworkSelector, ClearMatchesKeepsNetworks) {
+    SavedNetworkList saved;
+    saved.push_back(makeSaved("Home", 1));
+    NetworkList candidates;
+    candidates.push_back(makeCandidate("Home", -60, 6));
+
+    SavedNetworkSelector selector;
+    selector.setNetworks(saved);
+    selector.match(candidates);
+    selector.clearMatches();
+
+    EXPECT_TRUE(ranked(selector).empty());
+    EXPECT_EQ(selector.getNetworks().size(), 1u);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <AllocationCounter.h>
+#include <HostControl.h>
+#include <Protocol/MessageBuilder.h>
+#include <Protocol/MessageTransport.h>
+#include <WiFiManager/WiFiManager.h>
+
+using namespace WiFiSet;
+
+/**
+ * A warm scan-and-send must not touch the heap
+ *
+ * Candidates and results live in WiFiManager's fixed tables and
+ * WiFiNetworkInfo is POD, so once the first scan has run, scanning and
+ * sending the list (as WiFiSetBLEService::sendWiFiNetworkList() does) makes
+ * no allocations. The first scan may: the simulated driver sizes its record
+ * buffer then, as the device's driver allocates its own per scan, outside
+ * the library.
+ */
+namespace {
+
+const size_t NOTIFY_CAPACITY = 514;    // MTU 517
+
+class ScanAllocationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Host::reset();
+        for (int i = 0; i < 30; i++) {
+            char ssid[33];
+            snprintf(ssid, sizeof(ssid), "Network-%02d", i % 20);   // Ten mesh networks with two APs
+            Host::addAccessPoint(Host::AccessPoint(ssid, static_cast<uint8_t>(1 + i % 13),
+                                                   static_cast<int8_t>(-35 - i * 2)));
+        }
+        Host::AccessPoint hidden("Hidden", 6, -60);
+        hidden.hidden = true;
+        Host::addAccessPoint(hidden);
+
+        manager.reset(new WiFiManager());
+        manager->begin();
+    }
+
+    void TearDown() override {
+        manager.reset();
+        Host::reset();
+    }
+
+    const NetworkList& runAsyncScan() {
+        EXPECT_TRUE(manager->startScan());
+        while (manager->pollScan() == ScanState::RUNNING) {
+            Host::advanceMillis(10);
+        }
+        EXPECT_EQ(manager->getScanState(), ScanState::COMPLETE);
+        return manager->getScanResults();
+    }
+
+    /**
+     * Encode and fragment the list as sendWiFiNetworkList() does; returns the networks sent
+     */
+    size_t sendList(const NetworkList& networks) {
+        uint8_t buffer[NOTIFY_CAPACITY];
+        size_t length = builder.encodeWiFiListStart(buffer, sizeof(buffer));
+        sendFragments(buffer, length);
+
+        size_t index = 0;
+        while (index < networks.size()) {
+            size_t sent = 0;
+            length = builder.encodeWiFiNetworkBatch(networks, index, buffer, sizeof(buffer), sent);
+            if (length == 0 || sent == 0) {
+                return index;
+            }
+            sendFragments(buffer, length);
+            index += sent;
+        }
+
+        length = builder.encodeWiFiListEnd(static_cast<uint8_t>(networks.size()), buffer, sizeof(buffer));
+        sendFragments(buffer, length);
+        return index;
+    }
+
+    static void sendFragments(const uint8_t* data, size_t length) {
+        MessageFragmenter fragmenter(data, length, NOTIFY_CAPACITY);
+        const uint8_t* chunk;
+        size_t chunkLength;
+        while (fragmenter.next(chunk, chunkLength)) {
+        }
+    }
+
+    std::unique_ptr<WiFiManager> manager;
+    MessageBuilder builder;
+};
+
+} // namespace
+
+TEST_F(ScanAllocationTest, BlockingScanAndSend) {
+    ASSERT_EQ(manager->scanNetworks().size(), 20u);
+    sendList(manager->getScanResults());
+
+    AllocationCounter::Scope scope;
+    const NetworkList& networks = manager->scanNetworks();
+    size_t sent = sendList(networks);
+
+    EXPECT_EQ(networks.size(), 20u);
+    EXPECT_EQ(sent, networks.size());
+    EXPECT_EQ(scope.allocations(), 0u) << scope.bytes() << " bytes";
+}
+
+TEST_F(ScanAllocationTest, AsyncScanAndSend) {
+    ASSERT_EQ(runAsyncScan().size(), 20u);
+    sendList(manager->getScanResults());
+
+    AllocationCounter::Scope scope;
+    const NetworkList& networks = runAsyncScan();
+    size_t sent = sendList(networks);
+
+    EXPECT_EQ(networks.size(), 20u);
+    EXPECT_EQ(sent, networks.size());
+    EXPECT_EQ(scope.allocations(), 0u) << scope.bytes() << " bytes";
+}
+
+TEST_F(ScanAllocationTest, ChannelSlicedScanAndSend) {
+    manager->setChannelSlicedScan(true);
+    ASSERT_EQ(runAsyncScan().size(), 20u);
+    sendList(manager->getScanResults());
+
+    AllocationCounter::Scope scope;
+    const NetworkList& networks = runAsyncScan();
+    size_t sent = sendList(networks);
+
+    EXPECT_EQ(networks.size(), 20u);
+    EXPECT_EQ(sent, networks.size());
+    EXPECT_EQ(scope.allocations(), 0u) << scope.bytes() << " bytes";
+}
+
+TEST_F(ScanAllocationTest, LimitedResultsScanAndSend) {
+    manager->setMaxScanResults(5);
+    ASSERT_EQ(manager->scanNetworks().size(), 5u);
+    sendList(manager->getScanResults());
+
+    AllocationCounter::Scope scope;
+    const NetworkList& networks = manager->scanNetworks();
+    size_t sent = sendList(networks);
+
+    ASSERT_EQ(networks.size(), 5u);
+    EXPECT_EQ(sent, networks.size());
+    EXPECT_EQ(networks[0].rssi, -35);   // Strongest first
+    EXPECT_EQ(scope.allocations(), 0u) << scope.bytes() << " bytes";
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <HostControl.h>
+#include <RadioScene.h>
+#include <memory>
+
+using namespace WiFiSet;
+
+/**
+ * ScanConfig trade-offs on the simulated radio
+ *
+ * Each test scans one RadioScene with ScanStrategy presets and checks the
+ * latency/completeness outcome the radio model predicts (13 channels,
+ * 100 ms active minimum dwell, 102 ms beacons unless the scene says
+ * otherwise). bench/ScanStrategyBench.cpp reports the full matrix.
+ */
+namespace {
+
+const uint32_t CHANNELS = 13;
+
+class ScanStrategyTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        manager.reset();
+        Host::reset();
+    }
+
+    ScanOutcome scan(RadioScene::Kind sceneKind, ScanStrategy::Kind strategyKind) {
+        Host::reset();
+        scene = RadioScene::get(sceneKind);
+        scene.install();
+        manager.reset(new WiFiManager());
+        manager->begin();
+        return ScanOutcome::run(*manager, ScanStrategy::get(strategyKind));
+    }
+
+    RadioScene scene = RadioScene::get(RadioScene::HOME);
+    std::unique_ptr<WiFiManager> manager;
+};
+
+} // namespace
+
+TEST_F(ScanStrategyTest, DefaultScanFindsEveryNetworkThatAnswersProbes) {
+    for (int kind : {RadioScene::HOME, RadioScene::OFFICE, RadioScene::HIDDEN}) {
+        ScanOutcome outcome = scan(static_cast<RadioScene::Kind>(kind), ScanStrategy::DEFAULT);
+        EXPECT_EQ(outcome.found, scene.networks) << scene.name;
+        EXPECT_EQ(outcome.hidden, 0u) << scene.name;
+        EXPECT_EQ(outcome.latencyMs, outcome.radioMs) << scene.name;
+    }
+}
+
+TEST_F(ScanStrategyTest, QuickActiveScanIsCompleteWhereAPsAnswer) {
+    ScanOutcome full = scan(RadioScene::OFFICE, ScanStrategy::DEFAULT);
+    ScanOutcome quick = scan(RadioScene::OFFICE, ScanStrategy::QUICK_ACTIVE);
+
+    EXPECT_EQ(quick.found, scene.networks);
+    EXPECT_LE(quick.latencyMs, CHANNELS * 60);
+    EXPECT_LT(quick.latencyMs * 4, full.latencyMs);
+}
+
+TEST_F(ScanStrategyTest, PassiveScanDwellsTheFullTimeOnEveryChannel) {
+    ScanOutcome passive = scan(RadioScene::HOME, ScanStrategy::PASSIVE);
+    EXPECT_EQ(passive.radioMs, CHANNELS * 110);
+    EXPECT_EQ(passive.found, scene.networks);
+}
+
+TEST_F(ScanStrategyTest, BeaconOnlyDevicesNeedALongPassiveDwell) {
+    for (int kind : {ScanStrategy::DEFAULT, ScanStrategy::QUICK_ACTIVE, ScanStrategy::PASSIVE}) {
+        ScanOutcome outcome = scan(RadioScene::SENSORS, static_cast<ScanStrategy::Kind>(kind));
+        EXPECT_EQ(outcome.found, 5u) << ScanStrategy::get(kind).name;   // The three sensors are missed
+    }
+
+    ScanOutcome longPassive = scan(RadioScene::SENSORS, ScanStrategy::LONG_PASSIVE);
+    EXPECT_EQ(longPassive.found, scene.networks);
+    EXPECT_EQ(longPassive.radioMs, CHANNELS * 320);
+}
+
+TEST_F(ScanStrategyTest, ChannelMaskTradesCompletenessForLatency) {
+    ScanOutcome masked = scan(RadioScene::OFFICE, ScanStrategy::CHANNELS_1_6_11);
+    EXPECT_EQ(masked.radioMs, 3 * DEFAULT_SCAN_DWELL_MS);
+    EXPECT_EQ(masked.found, 20u);   // The networks only on channel 13 are missed
+    EXPECT_EQ(Host::radioStats().scans, 3u);
+}
+
+TEST_F(ScanStrategyTest, SlicedScanLeavesTheRadioToBLEBetweenChannels) {
+    ScanOutcome sliced = scan(RadioScene::OFFICE, ScanStrategy::SLICED);
+    EXPECT_EQ(sliced.found, scene.networks);
+    EXPECT_EQ(Host::radioStats().scans, CHANNELS);
+    EXPECT_LE(sliced.radioMs, CHANNELS * SCAN_SLICE_DWELL_MS);
+
+    // Every gap but the last, plus up to one poll interval per slice
+    uint32_t gaps = sliced.latencyMs - sliced.radioMs;
+    EXPECT_GE(gaps, (CHANNELS - 1) * SCAN_SLICE_GAP_MS);
+    EXPECT_LE(gaps, (CHANNELS - 1) * SCAN_SLICE_GAP_MS + CHANNELS * 2 * 10);
+}
+
+TEST_F(ScanStrategyTest, HiddenNetworksAreReportedOnlyWhenAsked) {
+    EXPECT_EQ(scan(RadioScene::HIDDEN, ScanStrategy::DEFAULT).hidden, 0u);
+
+    // Hidden networks only beacon; the one on a channel nothing else answers on goes unheard in 100 ms
+    ScanOutcome shown = scan(RadioScene::HIDDEN, ScanStrategy::SHOW_HIDDEN);
+    EXPECT_EQ(shown.found, scene.networks);
+    EXPECT_EQ(shown.hidden, 1u);
+    EXPECT_LT(shown.hidden, scene.hidden);
+}
@@ -11,10 +11,14 @@ public class BLEManager: NSObject, ObservableObject {
     @Published public private(set) var connectedDevice: BLEPeripheral?
     @Published public private(set) var bluetoothState: CBManagerState = .unknown
     @Published public private(set) var deviceStatus: DeviceStatus?
+    /// Capabilities reported by the device (nil for protocol 1.0 firmware)
+    @Published public private(set) var deviceCapabilities: DeviceCapabilities?
 
     // MARK: - Callbacks
 
     public var onWiFiNetworksReceived: (([WiFiNetwork]) -> Void)?
+    /// Called with the device's saved networks after requestSavedNetworks()
+    public var onSavedNetworksReceived: (([SavedNetwork]) -> Void)?
     public var onStatusReceived: ((DeviceStatus) -> Void)?
     public var onError: ((Error) -> Void)?
     public var onConnectionStateChanged: ((Bool) -> Void)?
@@ -30,9 +34,11 @@ public class BLEManager: NSObject, ObservableObject {
 
     private let encoder = ProtocolEncoder()
     private let decoder = ProtocolDecoder()
+    private var reassemblers: [CBUUID: MessageReassembler] = [:]
 
     private var receivedNetworks: [WiFiNetwork] = []
     private var isReceivingNetworkList = false
+    private var isAwaitingCapabilities = false
 
     // MARK: - Initialization
 
@@ -86,6 +92,9 @@ public class BLEManager: NSObject, ObservableObject {
         centralManager.cancelPeripheralConnection(peripheral)
         connectedDevice = nil
         deviceStatus = nil
+        deviceCapabilities = nil
+        isAwaitingCapabilities = false
+        reassemblers.removeAll()
         wifiListCharacteristic = nil
         credentialCharacteristic = nil
         statusCharacteristic = nil
@@ -107,6 +116,61 @@ public class BLEManager: NSObject, ObservableObject {
         }
     }
 
+    /// Turn live network list updates on or off
+    /// While enabled, onWiFiNetworksReceived is called with the updated list
+    /// whenever the device reports a change. Requires the deltaUpdates feature.
+    /// - Parameter rssiThreshold: Minimum RSSI change in dB to report (0 = device default)
+    public func subscribeToNetworkUpdates(_ enabled: Bool = true, rssiThreshold: UInt8 = 0) {
+        guard let characteristic = credentialCharacteristic,
+              let peripheral = connectedDevice?.peripheral else {
+            onError?(BLEError.notConnected)
+            return
+        }
+
+        let data = encoder.encodeScanSubscribe(enabled: enabled, rssiThreshold: rssiThreshold)
+        peripheral.writeValue(data, for: characteristic, type: .withResponse)
+    }
+
+    /// Send the device IP configuration (static address or DHCP)
+    /// The device stores it and reconnects with it. Requires the ipConfig feature.
+    public func sendIPConfig(_ config: IPConfiguration) {
+        guard let characteristic = credentialCharacteristic,
+              let peripheral = connectedDevice?.peripheral else {
+            onError?(BLEError.notConnected)
+            return
+        }
+
+        do {
+            let data = try encoder.encodeIPConfigWrite(config)
+            peripheral.writeValue(data, for: characteristic, type: .withResponse)
+        } catch {
+            onError?(error)
+        }
+    }
+
+    /// Save a network on the device without connecting to it
+    /// At boot the device joins the best saved network in range. Requires the savedNetworks feature.
+    /// - Parameter priority: Higher is preferred (default 0)
+    public func addSavedNetwork(ssid: String, password: String, priority: UInt8 = 0) {
+        writeSavedNetworkRequest { try $0.encodeSavedNetworkAdd(ssid: ssid, password: password, priority: priority) }
+    }
+
+    /// Forget a network saved on the device. Requires the savedNetworks feature.
+    public func removeSavedNetwork(ssid: String) {
+        writeSavedNetworkRequest { try $0.encodeSavedNetworkRemove(ssid: ssid) }
+    }
+
+    /// Change the priority of a network saved on the device. Requires the savedNetworks feature.
+    public func setSavedNetworkPriority(ssid: String, priority: UInt8) {
+        writeSavedNetworkRequest { try $0.encodeSavedNetworkPriority(ssid: ssid, priority: priority) }
+    }
+
+    /// Request the networks saved on the device (delivered to onSavedNetworksReceived)
+    /// Requires the savedNetworks feature.
+    public func requestSavedNetworks() {
+        writeSavedNetworkRequest { $0.encodeSavedNetworkListRequest() }
+    }
+
     /// Request current status from ESP32
     public func requestStatus() {
         guard let characteristic = statusCharacteristic,
@@ -193,6 +257,8 @@ extension BLEManager: CBCentralManagerDelegate {
             onError?(error)
         }
 
+        reassemblers.removeAll()
+
         DispatchQueue.main.async {
             self.connectedDevice = nil
             self.onConnectionStateChanged?(false)
@@ -239,6 +305,7 @@ extension BLEManager: CBPeripheralDelegate {
 
             case BLEConstants.credentialWriteCharacteristicUUID:
                 credentialCharacteristic = characteristic
+                sendHello(peripheral: peripheral, characteristic: characteristic)
 
             case BLEConstants.statusCharacteristicUUID:
                 statusCharacteristic = characteristic
@@ -259,15 +326,22 @@ extension BLEManager: CBPeripheralDelegate {
             return
         }
 
-        guard let data = characteristic.value, data.count >= MessageHeader.size else {
-            // Skip empty or too-short data (characteristic not yet initialized)
+        guard let data = characteristic.value, !data.isEmpty else {
+            // Skip empty data (characteristic not yet initialized)
             return
         }
 
+        // Messages larger than the MTU arrive split across notifications
+        let reassembler = reassemblers[characteristic.uuid] ?? MessageReassembler()
+        reassemblers[characteristic.uuid] = reassembler
+
         do {
-            let message = try decoder.decode(data)
-            handleMessage(message)
+            for messageData in try reassembler.append(data) {
+                let message = try decoder.decode(messageData)
+                handleMessage(message)
+            }
         } catch {
+            reassembler.reset()
             onError?(error)
         }
     }
@@ -282,6 +356,14 @@ extension BLEManager: CBPeripheralDelegate {
 
     // MARK: - Message Handling
 
+    /// Announce protocol version and features; 1.0 firmware replies with an error
+    private func sendHello(peripheral: CBPeripheral, characteristic: CBCharacteristic) {
+        let maxMTU = UInt16(clamping: peripheral.maximumWriteValueLength(for: .withoutResponse) + 3)
+        let data = encoder.encodeHello(features: .supported, maxMTU: maxMTU)
+        isAwaitingCapabilities = true
+        peripheral.writeValue(data, for: characteristic, type: .withResponse)
+    }
+
     private func handleMessage(_ message: ProtocolMessage) {
         switch message {
         case .wifiListStart:
@@ -293,22 +375,59 @@ extension BLEManager: CBPeripheralDelegate {
                 receivedNetworks.append(network)
             }
 
+        case .wifiNetworkBatch(let networks):
+            if isReceivingNetworkList {
+                receivedNetworks.append(contentsOf: networks)
+            }
+
         case .wifiListEnd:
             isReceivingNetworkList = false
             onWiFiNetworksReceived?(receivedNetworks)
 
+        case .wifiNetworkDelta(let changes):
+            // Deltas apply to the last complete list
+            guard !isReceivingNetworkList else { return }
+            for change in changes {
+                applyNetworkChange(change)
+            }
+            onWiFiNetworksReceived?(receivedNetworks)
+
         case .credentialWriteAck(let statusCode):
             if statusCode != 0x00 {
                 onError?(BLEError.credentialWriteFailed(statusCode))
             }
 
+        case .ipConfigAck(let statusCode):
+            if statusCode != 0x00 {
+                onError?(BLEError.ipConfigWriteFailed(statusCode))
+            }
+
+        case .savedNetworkList(let networks):
+            onSavedNetworksReceived?(networks)
+
+        case .savedNetworkAck(_, let statusCode):
+            if statusCode != 0x00 {
+                onError?(BLEError.savedNetworkRequestFailed(statusCode))
+            }
+
         case .statusResponse(let status):
             DispatchQueue.main.async {
                 self.deviceStatus = status
             }
             onStatusReceived?(status)
 
+        case .capabilities(let capabilities):
+            isAwaitingCapabilities = false
+            DispatchQueue.main.async {
+                self.deviceCapabilities = capabilities
+            }
+
         case .error(let code, let errorMessage):
+            if isAwaitingCapabilities && code == .unknownMessageType {
+                // Protocol 1.0 firmware does not know HELLO - keep 1.0 behavior
+                isAwaitingCapabilities = false
+                return
+            }
             onError?(BLEError.esp32Error(code: code, message: errorMessage))
 
         default:
@@ -317,6 +436,38 @@ extension BLEManager: CBPeripheralDelegate {
     }
 }
 
+extension BLEManager {
+    /// Write a Saved Network request on the credential characteristic
+    private func writeSavedNetworkRequest(_ encode: (ProtocolEncoder) throws -> Data) {
+        guard let characteristic = credentialCharacteristic,
+              let peripheral = connectedDevice?.peripheral else {
+            onError?(BLEError.notConnected)
+            return
+        }
+
+        do {
+            let data = try encode(encoder)
+            peripheral.writeValue(data, for: characteristic, type: .withResponse)
+        } catch {
+            onError?(error)
+        }
+    }
+
+    /// Added and updated networks replace any entry with the same SSID
+    private func applyNetworkChange(_ change: WiFiNetworkChange) {
+        switch change {
+        case .added(let network), .updated(let network):
+            if let index = receivedNetworks.firstIndex(where: { $0.ssid == network.ssid }) {
+                receivedNetworks[index] = network
+            } else {
+                receivedNetworks.append(network)
+            }
+        case .removed(let ssid):
+            receivedNetworks.removeAll { $0.ssid == ssid }
+        }
+    }
+}
+
 // MARK: - BLE Errors
 
 public enum BLEError: LocalizedError {
@@ -330,6 +481,8 @@ public enum BLEError: LocalizedError {
     case serviceNotFound
     case characteristicNotFound
     case credentialWriteFailed(UInt8)
+    case ipConfigWriteFailed(UInt8)
+    case savedNetworkRequestFailed(UInt8)
     case esp32Error(code: ProtocolErrorCode, message: String)
 
     public var errorDescription: String? {
@@ -354,6 +507,10 @@ public enum BLEError: LocalizedError {
             return "Required characteristic not found"
         case .credentialWriteFailed(let code):
             return "Failed to write credentials (code: \(code))"
+        case .ipConfigWriteFailed(let code):
+            return "Failed to set IP configuration (code: \(code))"
+        case .savedNetworkRequestFailed(let code):
+            return "Saved network request failed (code: \(code))"
         case .esp32Error(_, let message):
             return "ESP32 error: \(message)"
         }
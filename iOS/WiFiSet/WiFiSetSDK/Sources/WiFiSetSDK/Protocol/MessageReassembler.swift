@@ -0,0 +1,51 @@
+import Foundation
+
+/// Reassembles protocol messages that were fragmented across BLE notifications
+///
+/// The ESP32 splits messages larger than the negotiated MTU into consecutive
+/// notifications without extra framing. The payload length in the 4-byte
+/// header tells us when a message is complete.
+public class MessageReassembler {
+    /// Largest message accepted (header + payload)
+    public static let maxMessageSize = 512
+
+    private var buffer = Data()
+
+    public init() {}
+
+    /// Whether a partial message is buffered
+    public var isPending: Bool {
+        !buffer.isEmpty
+    }
+
+    /// Discard any partial message
+    public func reset() {
+        buffer.removeAll(keepingCapacity: true)
+    }
+
+    /// Append a fragment and return every message it completes
+    public func append(_ fragment: Data) throws -> [Data] {
+        buffer.append(fragment)
+
+        var messages: [Data] = []
+        while buffer.count >= MessageHeader.size {
+            let start = buffer.startIndex
+            let payloadLength = Int(buffer[start + 2]) | (Int(buffer[start + 3]) << 8) // Little-endian
+            let messageLength = MessageHeader.size + payloadLength
+
+            guard messageLength <= Self.maxMessageSize else {
+                reset()
+                throw ProtocolError.payloadTooLarge
+            }
+
+            guard buffer.count >= messageLength else {
+                break
+            }
+
+            messages.append(buffer.subdata(in: start..<start + messageLength))
+            buffer.removeSubrange(start..<start + messageLength)
+        }
+
+        return messages
+    }
+}
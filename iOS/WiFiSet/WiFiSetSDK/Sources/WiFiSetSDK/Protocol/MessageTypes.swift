@@ -5,13 +5,129 @@ public enum MessageType: UInt8 {
     case wifiListStart = 0x01
     case wifiNetworkEntry = 0x02
     case wifiListEnd = 0x03
+    case wifiNetworkBatch = 0x04
+    case wifiNetworkDelta = 0x05
+    case scanSubscribe = 0x06
     case credentialWrite = 0x10
     case credentialWriteAck = 0x11
+    case ipConfigWrite = 0x12
+    case ipConfigAck = 0x13
+    case savedNetworkAdd = 0x14
+    case savedNetworkRemove = 0x15
+    case savedNetworkPriority = 0x16
+    case savedNetworkListRequest = 0x17
+    case savedNetworkList = 0x18
+    case savedNetworkAck = 0x19
     case statusRequest = 0x20
     case statusResponse = 0x21
+    case hello = 0x30
+    case capabilities = 0x31
     case error = 0xFF
 }
 
+/// Protocol version implemented by this SDK
+public enum ProtocolVersion {
+    public static let major: UInt8 = 1
+    public static let minor: UInt8 = 5
+}
+
+/// Optional protocol features negotiated with HELLO / CAPABILITIES
+public struct ProtocolFeatures: OptionSet {
+    public let rawValue: UInt16
+
+    public init(rawValue: UInt16) {
+        self.rawValue = rawValue
+    }
+
+    public static let batchedNetworkList = ProtocolFeatures(rawValue: 0x0001)
+    public static let fragmentation = ProtocolFeatures(rawValue: 0x0002)
+    public static let compression = ProtocolFeatures(rawValue: 0x0004)
+    public static let encryption = ProtocolFeatures(rawValue: 0x0008)
+    public static let deltaUpdates = ProtocolFeatures(rawValue: 0x0010)
+    public static let ipConfig = ProtocolFeatures(rawValue: 0x0020)
+    public static let savedNetworks = ProtocolFeatures(rawValue: 0x0040)
+
+    /// Features this SDK understands
+    public static let supported: ProtocolFeatures = [.batchedNetworkList, .fragmentation, .deltaUpdates, .ipConfig,
+                                                     .savedNetworks]
+}
+
+/// How the device gets its IP address
+public enum IPMode: UInt8 {
+    case dhcp = 0x00
+    case staticIP = 0x01
+}
+
+/// Device IP configuration sent with IP Config Write
+/// Addresses are dotted-quad strings; unused addresses may be "0.0.0.0".
+public struct IPConfiguration {
+    public let mode: IPMode
+    public let address: String
+    public let subnet: String
+    public let gateway: String
+    public let dns1: String
+    public let dns2: String
+
+    public init(mode: IPMode, address: String = "0.0.0.0", subnet: String = "0.0.0.0",
+                gateway: String = "0.0.0.0", dns1: String = "0.0.0.0", dns2: String = "0.0.0.0") {
+        self.mode = mode
+        self.address = address
+        self.subnet = subnet
+        self.gateway = gateway
+        self.dns1 = dns1
+        self.dns2 = dns2
+    }
+
+    /// Go back to DHCP
+    public static let dhcp = IPConfiguration(mode: .dhcp)
+}
+
+/// A network saved on the device (Saved Network List entry, never includes the password)
+public struct SavedNetwork: Identifiable, Hashable {
+    public let ssid: String
+    /// Higher is tried first
+    public let priority: UInt8
+    /// Failed connects since the last success
+    public let failureCount: UInt8
+    /// Order of the last successful connect (higher = more recent, 0 = never); not a time
+    public let lastSuccess: UInt32
+
+    public var id: String { ssid }
+
+    public init(ssid: String, priority: UInt8, failureCount: UInt8, lastSuccess: UInt32) {
+        self.ssid = ssid
+        self.priority = priority
+        self.failureCount = failureCount
+        self.lastSuccess = lastSuccess
+    }
+}
+
+/// One change in a WiFi Network Delta (networks are identified by SSID)
+public enum WiFiNetworkChange {
+    case added(WiFiNetwork)
+    case removed(ssid: String)
+    case updated(WiFiNetwork)
+}
+
+/// Device capabilities reported in reply to HELLO
+public struct DeviceCapabilities {
+    public let versionMajor: UInt8
+    public let versionMinor: UInt8
+    public let supportedFeatures: ProtocolFeatures
+    public let maxMTU: UInt16
+    /// Features enabled for this connection
+    public let sessionFeatures: ProtocolFeatures
+
+    public init(versionMajor: UInt8, versionMinor: UInt8, supportedFeatures: ProtocolFeatures,
+                maxMTU: UInt16, sessionFeatures: ProtocolFeatures) {
+        self.versionMajor = versionMajor
+        self.versionMinor = versionMinor
+        self.supportedFeatures = supportedFeatures
+        self.maxMTU = maxMTU
+        self.sessionFeatures = sessionFeatures
+    }
+}
+
 /// Protocol error codes
 public enum ProtocolErrorCode: UInt8 {
     case invalidMessageFormat = 0x01
@@ -101,10 +217,23 @@ public enum ProtocolMessage {
     case wifiListStart
     case wifiNetworkEntry(WiFiNetwork)
     case wifiListEnd(networkCount: UInt8)
+    case wifiNetworkBatch([WiFiNetwork])
+    case wifiNetworkDelta([WiFiNetworkChange])
+    case scanSubscribe(enabled: Bool, rssiThreshold: UInt8)
     case credentialWrite(ssid: String, password: String)
     case credentialWriteAck(statusCode: UInt8)
+    case ipConfigWrite(IPConfiguration)
+    case ipConfigAck(statusCode: UInt8)
+    case savedNetworkAdd(ssid: String, password: String, priority: UInt8)
+    case savedNetworkRemove(ssid: String)
+    case savedNetworkPriority(ssid: String, priority: UInt8)
+    case savedNetworkListRequest
+    case savedNetworkList([SavedNetwork])
+    case savedNetworkAck(request: UInt8, statusCode: UInt8)
     case statusRequest
     case statusResponse(DeviceStatus)
+    case hello(features: ProtocolFeatures, maxMTU: UInt16)
+    case capabilities(DeviceCapabilities)
     case error(code: ProtocolErrorCode, message: String)
 
     /// Message type
@@ -113,10 +242,23 @@ public enum ProtocolMessage {
         case .wifiListStart: return .wifiListStart
         case .wifiNetworkEntry: return .wifiNetworkEntry
         case .wifiListEnd: return .wifiListEnd
+        case .wifiNetworkBatch: return .wifiNetworkBatch
+        case .wifiNetworkDelta: return .wifiNetworkDelta
+        case .scanSubscribe: return .scanSubscribe
         case .credentialWrite: return .credentialWrite
         case .credentialWriteAck: return .credentialWriteAck
+        case .ipConfigWrite: return .ipConfigWrite
+        case .ipConfigAck: return .ipConfigAck
+        case .savedNetworkAdd: return .savedNetworkAdd
+        case .savedNetworkRemove: return .savedNetworkRemove
+        case .savedNetworkPriority: return .savedNetworkPriority
+        case .savedNetworkListRequest: return .savedNetworkListRequest
+        case .savedNetworkList: return .savedNetworkList
+        case .savedNetworkAck: return .savedNetworkAck
         case .statusRequest: return .statusRequest
         case .statusResponse: return .statusResponse
+        case .hello: return .hello
+        case .capabilities: return .capabilities
         case .error: return .error
         }
     }
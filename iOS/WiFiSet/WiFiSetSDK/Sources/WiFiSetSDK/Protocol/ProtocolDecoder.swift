@@ -24,10 +24,22 @@ public class ProtocolDecoder {
             return try decodeWiFiNetworkEntry(payload: payload)
         case .wifiListEnd:
             return try decodeWiFiListEnd(payload: payload)
+        case .wifiNetworkBatch:
+            return try decodeWiFiNetworkBatch(payload: payload)
+        case .wifiNetworkDelta:
+            return try decodeWiFiNetworkDelta(payload: payload)
         case .credentialWriteAck:
             return try decodeCredentialWriteAck(payload: payload)
+        case .ipConfigAck:
+            return try decodeIPConfigAck(payload: payload)
+        case .savedNetworkList:
+            return try decodeSavedNetworkList(payload: payload)
+        case .savedNetworkAck:
+            return try decodeSavedNetworkAck(payload: payload)
         case .statusResponse:
             return try decodeStatusResponse(payload: payload)
+        case .capabilities:
+            return try decodeCapabilities(payload: payload)
         case .error:
             return try decodeError(payload: payload)
         default:
@@ -43,7 +55,69 @@ public class ProtocolDecoder {
     }
 
     private func decodeWiFiNetworkEntry(payload: Data) throws -> ProtocolMessage {
-        var offset = 0
+        let (network, _) = try readWiFiNetwork(from: payload, at: 0)
+        return .wifiNetworkEntry(network)
+    }
+
+    private func decodeWiFiNetworkBatch(payload: Data) throws -> ProtocolMessage {
+        guard payload.count >= 1 else {
+            throw ProtocolError.insufficientData
+        }
+
+        let entryCount = Int(payload[0])
+        var offset = 1
+        var networks: [WiFiNetwork] = []
+        networks.reserveCapacity(entryCount)
+
+        // Entries use the same layout as WiFi Network Entry payloads
+        for _ in 0..<entryCount {
+            let (network, bytesRead) = try readWiFiNetwork(from: payload, at: offset)
+            networks.append(network)
+            offset += bytesRead
+        }
+
+        return .wifiNetworkBatch(networks)
+    }
+
+    private func decodeWiFiNetworkDelta(payload: Data) throws -> ProtocolMessage {
+        guard payload.count >= 1 else {
+            throw ProtocolError.insufficientData
+        }
+
+        let changeCount = Int(payload[0])
+        var offset = 1
+        var changes: [WiFiNetworkChange] = []
+        changes.reserveCapacity(changeCount)
+
+        // Each change: Kind + SSID, then RSSI/security/channel unless removed
+        for _ in 0..<changeCount {
+            guard offset < payload.count else {
+                throw ProtocolError.insufficientData
+            }
+            let kind = payload[offset]
+            offset += 1
+
+            switch kind {
+            case 0x01, 0x03:
+                let (network, bytesRead) = try readWiFiNetwork(from: payload, at: offset)
+                changes.append(kind == 0x01 ? .added(network) : .updated(network))
+                offset += bytesRead
+            case 0x02:
+                let (ssid, bytesRead) = try payload.readLengthPrefixedString(at: offset, maxLength: 32)
+                changes.append(.removed(ssid: ssid))
+                offset += bytesRead
+            default:
+                throw ProtocolError.decodingFailed("Invalid change kind: \(kind)")
+            }
+        }
+
+        return .wifiNetworkDelta(changes)
+    }
+
+    /// Read a single network entry (SSID, RSSI, security, channel)
+    /// Returns (network, bytesRead)
+    private func readWiFiNetwork(from payload: Data, at start: Int) throws -> (WiFiNetwork, Int) {
+        var offset = start
 
         // Read SSID (length-prefixed string)
         let (ssid, ssidBytesRead) = try payload.readLengthPrefixedString(at: offset, maxLength: 32)
@@ -70,6 +144,7 @@ public class ProtocolDecoder {
             throw ProtocolError.insufficientData
         }
         let channel = payload[offset]
+        offset += 1
 
         let network = WiFiNetwork(
             ssid: ssid,
@@ -78,7 +153,7 @@ public class ProtocolDecoder {
             channel: channel
         )
 
-        return .wifiNetworkEntry(network)
+        return (network, offset - start)
     }
 
     private func decodeWiFiListEnd(payload: Data) throws -> ProtocolMessage {
@@ -99,6 +174,51 @@ public class ProtocolDecoder {
         return .credentialWriteAck(statusCode: statusCode)
     }
 
+    private func decodeIPConfigAck(payload: Data) throws -> ProtocolMessage {
+        guard payload.count >= 1 else {
+            throw ProtocolError.insufficientData
+        }
+
+        let statusCode = payload[0]
+        return .ipConfigAck(statusCode: statusCode)
+    }
+
+    private func decodeSavedNetworkList(payload: Data) throws -> ProtocolMessage {
+        guard payload.count >= 1 else {
+            throw ProtocolError.insufficientData
+        }
+
+        let count = Int(payload[0])
+        var offset = 1
+        var networks: [SavedNetwork] = []
+        networks.reserveCapacity(count)
+
+        for _ in 0..<count {
+            // SSID + Priority(1) + Failure Count(1) + Last Success(4)
+            let (ssid, ssidSize) = try payload.readLengthPrefixedString(at: offset, maxLength: 32)
+            offset += ssidSize
+            guard offset + 6 <= payload.count else {
+                throw ProtocolError.insufficientData
+            }
+            let lastSuccess = UInt32(payload[offset + 2]) | (UInt32(payload[offset + 3]) << 8) |
+                (UInt32(payload[offset + 4]) << 16) | (UInt32(payload[offset + 5]) << 24)
+            networks.append(SavedNetwork(ssid: ssid, priority: payload[offset],
+                                         failureCount: payload[offset + 1], lastSuccess: lastSuccess))
+            offset += 6
+        }
+
+        return .savedNetworkList(networks)
+    }
+
+    private func decodeSavedNetworkAck(payload: Data) throws -> ProtocolMessage {
+        // Request Type(1) + Status Code(1)
+        guard payload.count >= 2 else {
+            throw ProtocolError.insufficientData
+        }
+
+        return .savedNetworkAck(request: payload[0], statusCode: payload[1])
+    }
+
     private func decodeStatusResponse(payload: Data) throws -> ProtocolMessage {
         var offset = 0
 
@@ -127,18 +247,46 @@ public class ProtocolDecoder {
         offset += 4
 
         // Read SSID (length-prefixed string)
-        let (ssid, _) = try payload.readLengthPrefixedString(at: offset, maxLength: 32)
+        let (ssid, ssidSize) = try payload.readLengthPrefixedString(at: offset, maxLength: 32)
+        offset += ssidSize
+
+        // Read Disconnect Reason (1 byte, protocol 1.3+)
+        let disconnectReason: UInt8 = offset < payload.count ? payload[offset] : 0
 
         let status = DeviceStatus(
             connectionState: connectionState,
             rssi: rssi,
             ipAddress: ipAddress,
-            ssid: ssid
+            ssid: ssid,
+            disconnectReason: disconnectReason
         )
 
         return .statusResponse(status)
     }
 
+    private func decodeCapabilities(payload: Data) throws -> ProtocolMessage {
+        // Version(2) + Supported Features(2) + Max MTU(2) + Session Features(2)
+        // Newer firmware may append fields; they are ignored
+        guard payload.count >= 8 else {
+            throw ProtocolError.insufficientData
+        }
+
+        let capabilities = DeviceCapabilities(
+            versionMajor: payload[0],
+            versionMinor: payload[1],
+            supportedFeatures: ProtocolFeatures(rawValue: readUInt16(payload, at: 2)),
+            maxMTU: readUInt16(payload, at: 4),
+            sessionFeatures: ProtocolFeatures(rawValue: readUInt16(payload, at: 6))
+        )
+
+        return .capabilities(capabilities)
+    }
+
+    /// Read a little-endian UInt16
+    private func readUInt16(_ payload: Data, at offset: Int) -> UInt16 {
+        return UInt16(payload[offset]) | (UInt16(payload[offset + 1]) << 8)
+    }
+
     private func decodeError(payload: Data) throws -> ProtocolMessage {
         var offset = 0
 
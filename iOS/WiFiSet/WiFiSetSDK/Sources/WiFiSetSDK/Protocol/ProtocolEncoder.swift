@@ -61,8 +61,149 @@ public class ProtocolEncoder {
         return header.encode()
     }
 
+    /// Encode HELLO message (protocol version and client capabilities)
+    /// - Parameters:
+    ///   - features: Features the client supports
+    ///   - maxMTU: Largest ATT MTU the client will use (0 = unspecified)
+    public func encodeHello(features: ProtocolFeatures = .supported, maxMTU: UInt16 = 0) -> Data {
+        var payload = Data()
+        payload.append(ProtocolVersion.major)
+        payload.append(ProtocolVersion.minor)
+        payload.append(contentsOf: features.rawValue.littleEndianBytes)
+        payload.append(contentsOf: maxMTU.littleEndianBytes)
+
+        let header = MessageHeader(
+            type: .hello,
+            sequenceNumber: sequenceCounter,
+            payloadLength: UInt16(payload.count)
+        )
+
+        var message = header.encode()
+        message.append(payload)
+
+        incrementSequence()
+        return message
+    }
+
+    /// Encode Scan Subscribe message (live network list updates)
+    /// - Parameters:
+    ///   - enabled: true to receive WiFi Network Delta messages, false to stop
+    ///   - rssiThreshold: Minimum RSSI change in dB to report (0 = device default)
+    public func encodeScanSubscribe(enabled: Bool, rssiThreshold: UInt8 = 0) -> Data {
+        var payload = Data()
+        payload.append(enabled ? 0x01 : 0x00)
+        payload.append(rssiThreshold)
+
+        let header = MessageHeader(
+            type: .scanSubscribe,
+            sequenceNumber: sequenceCounter,
+            payloadLength: UInt16(payload.count)
+        )
+
+        var message = header.encode()
+        message.append(payload)
+
+        incrementSequence()
+        return message
+    }
+
+    /// Encode IP Config Write message
+    /// - Parameter config: DHCP, or a static address with subnet, gateway and DNS
+    /// - Throws: ProtocolError.encodingFailed if an address isn't a dotted quad
+    public func encodeIPConfigWrite(_ config: IPConfiguration) throws -> Data {
+        var payload = Data()
+        payload.append(config.mode.rawValue)
+
+        for address in [config.address, config.subnet, config.gateway, config.dns1, config.dns2] {
+            payload.append(try encodeIPv4(address))
+        }
+
+        let header = MessageHeader(
+            type: .ipConfigWrite,
+            sequenceNumber: sequenceCounter,
+            payloadLength: UInt16(payload.count)
+        )
+
+        var message = header.encode()
+        message.append(payload)
+
+        incrementSequence()
+        return message
+    }
+
+    /// Encode Saved Network Add message (saves the network without connecting to it)
+    /// - Parameter priority: Higher is preferred when several saved networks are in range
+    public func encodeSavedNetworkAdd(ssid: String, password: String, priority: UInt8 = 0) throws -> Data {
+        guard let ssidData = ssid.data(using: .utf8), !ssidData.isEmpty, ssidData.count <= 32 else {
+            throw ProtocolError.encodingFailed("SSID empty, too long or invalid")
+        }
+
+        guard let passwordData = password.data(using: .utf8), passwordData.count <= 63 else {
+            throw ProtocolError.encodingFailed("Password too long or invalid")
+        }
+
+        var payload = Data()
+        try payload.appendLengthPrefixedString(ssid)
+        try payload.appendLengthPrefixedString(password)
+        payload.append(priority)
+
+        return encodeMessage(.savedNetworkAdd, payload: payload)
+    }
+
+    /// Encode Saved Network Remove message
+    public func encodeSavedNetworkRemove(ssid: String) throws -> Data {
+        return encodeMessage(.savedNetworkRemove, payload: try encodeSavedSSID(ssid))
+    }
+
+    /// Encode Saved Network Priority message
+    public func encodeSavedNetworkPriority(ssid: String, priority: UInt8) throws -> Data {
+        var payload = try encodeSavedSSID(ssid)
+        payload.append(priority)
+        return encodeMessage(.savedNetworkPriority, payload: payload)
+    }
+
+    /// Encode Saved Network List Request message
+    public func encodeSavedNetworkListRequest() -> Data {
+        return encodeMessage(.savedNetworkListRequest, payload: Data())
+    }
+
     // MARK: - Private Helpers
 
+    /// Header + payload, advancing the sequence number
+    private func encodeMessage(_ type: MessageType, payload: Data) -> Data {
+        let header = MessageHeader(
+            type: type,
+            sequenceNumber: sequenceCounter,
+            payloadLength: UInt16(payload.count)
+        )
+
+        var message = header.encode()
+        message.append(payload)
+
+        incrementSequence()
+        return message
+    }
+
+    /// Length-prefixed SSID of a saved network (1-32 bytes)
+    private func encodeSavedSSID(_ ssid: String) throws -> Data {
+        guard let ssidData = ssid.data(using: .utf8), !ssidData.isEmpty, ssidData.count <= 32 else {
+            throw ProtocolError.encodingFailed("SSID empty, too long or invalid")
+        }
+
+        var payload = Data()
+        try payload.appendLengthPrefixedString(ssid)
+        return payload
+    }
+
+    /// Dotted-quad string to 4 bytes in network byte order
+    private func encodeIPv4(_ address: String) throws -> Data {
+        let octets = address.split(separator: ".", omittingEmptySubsequences: false).compactMap { UInt8($0) }
+        guard octets.count == 4 else {
+            throw ProtocolError.encodingFailed("Invalid IPv4 address: \(address)")
+        }
+        return Data(octets)
+    }
+
     private func incrementSequence() {
         sequenceCounter = sequenceCounter &+ 1  // Wraps at 255
     }
@@ -145,12 +145,16 @@ public struct DeviceStatus: Codable {
     public let rssi: Int8
     public let ipAddress: String
     public let ssid: String
+    /// ESP32 WiFi reason code of the last disconnect (0 = none or not reported)
+    public let disconnectReason: UInt8
 
-    public init(connectionState: ConnectionState, rssi: Int8, ipAddress: String, ssid: String) {
+    public init(connectionState: ConnectionState, rssi: Int8, ipAddress: String, ssid: String,
+                disconnectReason: UInt8 = 0) {
         self.connectionState = connectionState
         self.rssi = rssi
         self.ipAddress = ipAddress
         self.ssid = ssid
+        self.disconnectReason = disconnectReason
     }
 
     /// Whether device is connected to WiFi